@@ -9,7 +9,14 @@
  *  - Console and file logging support.
  *  - Color-coded severity levels for terminal readability.
  *  - Timestamps and contextual metadata (file, line, function).
- *  - Thread-safe operations using std::mutex.
+ *  - Thread-safe operations; the active sink set is published through an
+ *    atomic pointer with epoch-based reclamation, so logging never takes
+ *    a global lock to find its outputs.
+ *  - Safe use before Init and after Shutdown: all state is constant-initialized,
+ *    records logged before Init are buffered and replayed into the first sink
+ *    set, and records logged after Shutdown go straight to stderr.
+ *  - Optional asynchronous mode (relogger_backend.cpp) where records are
+ *    queued per thread and formatted and written on a backend thread.
  *
  * This module is designed to be minimal, fast, and easily integrable into
  * game engines or standalone applications. Inspired by robust logging systems
@@ -17,65 +24,730 @@
  */
 
 #include "relogger.h"
+#include "relogger_compressed.h"
+#include "relogger_escape.h"
+#include "relogger_internal.h"
+#include "relogger_sink.h"
+#include "relogger_stack.h"
 
-#include <iostream>
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 #include <mutex>
-#include <sstream>
-#include <chrono>
-#include <iomanip>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Per-thread announcement of the epoch a reader entered in.
+ *
+ * Zero means the owning thread is not currently reading the sink set.
+ * Slots are padded to a cache line so readers never share one.
+ */
+struct alignas(64) RELogger::Internal::ReaderSlot
+{
+	std::atomic<std::uint64_t> epoch { 0 };
+	std::atomic<bool> owned { false };
+};
 
 namespace
 {
+	using namespace RELogger::Internal;
+
+	// -------------------------------------------------------------------------
+	// Sink Set Publication
+	// -------------------------------------------------------------------------
+
+	constexpr std::size_t MaxReaderSlots = 128; ///< Threads beyond this use the overflow counter.
+
+	constinit ReaderSlot readerSlots[MaxReaderSlots];             ///< Epoch announcements of reading threads.
+	constinit std::atomic<std::uint32_t> overflowReaders { 0 };   ///< Readers active without a slot.
+	constinit std::atomic<std::uint64_t> globalEpoch { 1 };       ///< Advanced on every sink set swap.
+	constinit std::atomic<SinkSet*> activeSinks { nullptr };      ///< Currently published sink set.
+	constinit SinkSet* retiredSets = nullptr;                     ///< Sets awaiting reclamation (guarded by logMutex).
+
+	// -------------------------------------------------------------------------
+	// Lifecycle
+	// -------------------------------------------------------------------------
+	//
+	// Every piece of logger state is constant-initialized, so Log is usable
+	// from static constructors that run before main (or before this file's
+	// own dynamic initialization) without any once-flag. The steady-state
+	// hot path only looks at activeSinks; the lifecycle state is consulted
+	// solely when no sink set is published.
+
+	enum class Lifecycle : std::uint8_t
+	{
+		PreInit,  ///< Init has not run yet; records are buffered.
+		Running,  ///< A sink set has been published at least once.
+		ShutDown, ///< Shutdown ran (or the process is exiting); records go to stderr.
+	};
+
+	/**
+	 * @brief Link of the lock-free pre-Init stack.
+	 */
+	struct PendingNode
+	{
+		PendingNode* next;
+	};
+
+	/**
+	 * @brief A record logged before Init, kept until the first sink set exists.
+	 */
+	struct PendingRecord : PendingNode
+	{
+		LogLevel level;
+		std::chrono::system_clock::time_point time;
+		const char* file;
+		int line;
+		const char* func;
+		std::string message;
+		std::string text;
+		const char* format;
+		std::string args;
+		const char* category;
+		std::string context;
+	};
+
+	constexpr std::uint32_t MaxPendingRecords = 4096; ///< Early records kept before dropping.
+
+	constinit PendingNode pendingClosed { nullptr }; ///< Head marker: stack drained, use the sinks.
+
+	constinit std::atomic<Lifecycle> lifecycle { Lifecycle::PreInit };   ///< Current lifecycle phase.
+	constinit std::atomic<PendingNode*> pendingHead { nullptr };        ///< Lock-free stack of early records.
+	constinit std::atomic<std::uint32_t> pendingCount { 0 };            ///< Records pushed onto the stack.
+	constinit std::atomic<std::uint32_t> pendingDropped { 0 };          ///< Early records dropped over the cap.
+
 	// -------------------------------------------------------------------------
 	// Internal State
 	// -------------------------------------------------------------------------
 
-	std::ofstream logFile;                   ///< File stream for persistent log output.
-	std::mutex logMutex;                     ///< Mutex to ensure thread-safe logging.
-	LogLevel currentLevel = LogLevel::Trace; ///< Minimum level to log (default: Trace).
+	constinit std::mutex logMutex;                                   ///< Serializes Init/Shutdown and sink changes.
+
+	// -------------------------------------------------------------------------
+	// Reader Side
+	// -------------------------------------------------------------------------
+
+	enum class SlotState : std::uint8_t { Unclaimed, Claimed, Overflow };
+
+	constinit thread_local ReaderSlot* threadSlot = nullptr;                 ///< Slot owned by this thread, if any.
+	constinit thread_local SlotState threadSlotState = SlotState::Unclaimed; ///< Whether a slot was claimed or refused.
+	constinit thread_local int threadReadDepth = 0;                          ///< Nesting depth of EpochGuards.
+
+	/**
+	 * @brief Hands this thread's reader slot back when the thread exits.
+	 */
+	struct SlotReleaser
+	{
+		~SlotReleaser()
+		{
+			if (threadSlot)
+			{
+				threadSlot->epoch.store(0, std::memory_order_release);
+				threadSlot->owned.store(false, std::memory_order_release);
+				threadSlot = nullptr;
+			}
+			threadSlotState = SlotState::Overflow;
+		}
+	};
+
+	thread_local SlotReleaser threadSlotReleaser;
+
+	/**
+	 * @brief Returns this thread's reader slot, claiming one on first use.
+	 * @return The slot, or nullptr if every slot is owned by another thread.
+	 */
+	ReaderSlot* ClaimReaderSlot()
+	{
+		if (threadSlotState != SlotState::Unclaimed)
+			return threadSlot;
+
+		threadSlotState = SlotState::Overflow;
+		for (ReaderSlot& slot : readerSlots)
+		{
+			bool expected = false;
+			if (slot.owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				(void)&threadSlotReleaser; // Registers the thread-exit release.
+				threadSlot = &slot;
+				threadSlotState = SlotState::Claimed;
+				break;
+			}
+		}
+		return threadSlot;
+	}
 
 	// -------------------------------------------------------------------------
-	// Helper Functions
+	// Writer Side (all callers hold logMutex)
 	// -------------------------------------------------------------------------
 
 	/**
-	 * @brief Converts a LogLevel enum to its string representation.
-	 * @param level The log level to convert.
-	 * @return A constant C-string corresponding to the log level.
+	 * @brief Checks whether any reader may still see sets retired at an epoch.
+	 * @param retireEpoch The epoch at which the set was unpublished.
+	 * @return True if no reader that entered at or before retireEpoch remains.
+	 */
+	bool IsGracePeriodOver(std::uint64_t retireEpoch)
+	{
+		if (overflowReaders.load(std::memory_order_seq_cst) != 0)
+			return false;
+
+		for (const ReaderSlot& slot : readerSlots)
+		{
+			std::uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+			if (epoch != 0 && epoch <= retireEpoch)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Frees every retired set that no reader can still reference.
+	 */
+	void ReclaimRetiredSets()
+	{
+		SinkSet** link = &retiredSets;
+		while (SinkSet* set = *link)
+		{
+			if (IsGracePeriodOver(set->retireEpoch))
+			{
+				*link = set->nextRetired;
+				delete set;
+			}
+			else
+			{
+				link = &set->nextRetired;
+			}
+		}
+	}
+
+	/**
+	 * @brief Atomically replaces the active sink set and retires the old one.
+	 * @param next The new set to publish (may be nullptr).
+	 */
+	void PublishSinkSet(SinkSet* next)
+	{
+		SinkSet* previous = activeSinks.exchange(next, std::memory_order_seq_cst);
+		std::uint64_t retireEpoch = globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+		if (previous)
+		{
+			previous->retireEpoch = retireEpoch;
+			previous->nextRetired = retiredSets;
+			retiredSets = previous;
+		}
+		ReclaimRetiredSets();
+	}
+
+	/**
+	 * @brief Waits until no reader that entered at or before an epoch remains.
+	 * @param epoch The epoch to wait past.
 	 */
-	const char* LevelToString(LogLevel level)
+	void WaitForGracePeriod(std::uint64_t epoch)
 	{
-		switch (level)
+		while (!IsGracePeriodOver(epoch))
+			std::this_thread::yield();
+	}
+
+	/**
+	 * @brief Blocks until every retired set has been reclaimed.
+	 *
+	 * Used by Shutdown so that sinks are closed by the time it returns.
+	 */
+	void WaitForRetiredSets()
+	{
+		ReclaimRetiredSets();
+		while (retiredSets)
 		{
-			case LogLevel::Trace: return "TRACE";
-			case LogLevel::Debug: return "DEBUG";
-			case LogLevel::Info:  return "INFO";
-			case LogLevel::Warn:  return "WARN";
-			case LogLevel::Error: return "ERROR";
-			case LogLevel::Fatal: return "FATAL";
-			default: return "UNKNOWN";
+			std::this_thread::yield();
+			ReclaimRetiredSets();
 		}
 	}
 
 	/**
-	 * @brief Maps each LogLevel to a specific ANSI color code for terminal output.
-	 * @param level The log level.
-	 * @return The corresponding ANSI escape sequence for color.
+	 * @brief Copies the sinks of the active set into a new, unpublished set.
+	 * @return A fresh set the caller may modify before publishing.
 	 */
-	const char* LevelToColor(LogLevel level)
+	SinkSet* CopyActiveSinkSet()
+	{
+		SinkSet* copy = new SinkSet();
+		if (const SinkSet* current = activeSinks.load(std::memory_order_acquire))
+			copy->sinks = current->sinks;
+		return copy;
+	}
+
+	// -------------------------------------------------------------------------
+	// Fallback Output
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Writes a plain line to stderr without touching iostreams.
+	 *
+	 * Used after Shutdown and during static destruction, where sinks are gone
+	 * and C++ streams may already have been torn down.
+	 *
+	 * @param text The formatted line (without newline).
+	 */
+	void WriteToStderr(std::string_view text)
+	{
+		std::string line;
+		line.reserve(text.size() + 1);
+		line += text;
+		line += '\n';
+		std::fwrite(line.data(), 1, line.size(), stderr);
+	}
+
+	/**
+	 * @brief Pushes a record onto the pre-Init stack.
+	 * @param record The record to buffer.
+	 * @return False if the stack was already drained by Init (the caller must
+	 *         deliver the record to the published sinks instead).
+	 */
+	bool BufferPendingRecord(const RELogger::LogRecord& record)
+	{
+		if (pendingCount.fetch_add(1, std::memory_order_relaxed) >= MaxPendingRecords)
+		{
+			pendingDropped.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		PendingRecord* node = new PendingRecord {
+			{ nullptr }, record.level, record.time, record.file, record.line, record.func,
+			std::string(record.message), std::string(record.text), record.format, std::string(record.args),
+			record.category, std::string(record.context) };
+
+		PendingNode* head = pendingHead.load(std::memory_order_relaxed);
+		do
+		{
+			if (head == &pendingClosed)
+			{
+				delete node;
+				return false;
+			}
+			node->next = head;
+		} while (!pendingHead.compare_exchange_weak(head, node,
+					std::memory_order_release, std::memory_order_relaxed));
+
+		return true;
+	}
+
+	/**
+	 * @brief Closes the pre-Init stack and returns its records oldest first.
+	 * @return The drained list; nullptr if it was empty or already drained.
+	 */
+	PendingRecord* TakePendingRecords()
+	{
+		PendingNode* head = pendingHead.exchange(&pendingClosed, std::memory_order_acquire);
+		if (head == &pendingClosed)
+			return nullptr;
+
+		PendingNode* ordered = nullptr;
+		while (head)
+		{
+			PendingNode* next = head->next;
+			head->next = ordered;
+			ordered = head;
+			head = next;
+		}
+		return static_cast<PendingRecord*>(ordered);
+	}
+
+	/**
+	 * @brief Delivers and frees the drained early records.
+	 * @param records List returned by TakePendingRecords.
+	 * @param sinks   Destination set, or nullptr to fall back to stderr.
+	 */
+	void ReplayPendingRecords(PendingRecord* records, const SinkSet* sinks)
+	{
+		while (records)
+		{
+			DispatchRecord(sinks, RELogger::LogRecord { records->level, records->time, records->file,
+				records->line, records->func, records->message, records->text, records->format, records->args,
+				records->category, records->context });
+
+			PendingRecord* next = static_cast<PendingRecord*>(records->next);
+			delete records;
+			records = next;
+		}
+
+		if (std::uint32_t dropped = pendingDropped.exchange(0, std::memory_order_relaxed))
+		{
+			std::string notice = "[LOGGER WARNING] " + std::to_string(dropped)
+				+ " records logged before Init were dropped";
+			DispatchRecord(sinks, RELogger::LogRecord { LogLevel::Warn, Now(),
+				"", 0, "", notice, notice });
+		}
+	}
+
+	/**
+	 * @brief Common path of Log and LogFormat once the level check passed.
+	 *
+	 * Thread-safe without a global lock: the sink set is read under an epoch
+	 * guard and each sink serializes its own output. In asynchronous mode only
+	 * the raw payload is copied into the calling thread's queue; formatting and
+	 * I/O happen on the backend thread, and Fatal records wait until written.
+	 * Before Init the record is buffered in memory (a Fatal one is written
+	 * to stderr at once), after Shutdown it is written straight to stderr.
+	 *
+	 * @param category Site category, or nullptr.
+	 * @param format Site format string, or nullptr if payload is the message.
+	 * @param payload Message text, or encoded arguments when format is set.
+	 * @param caller Return address of the public entry point, where a
+	 *        captured stack starts.
+	 */
+	void SubmitRecord(LogLevel level, const char* file, int line, const char* func,
+					  const char* category, const char* format, std::string_view payload, const void* caller)
+	{
+		EpochGuard guard;
+
+		const std::chrono::system_clock::time_point now = Now();
+		const RELogger::LogContext* logContext = RELogger::CurrentLogContext();
+		const std::string_view context = AttachStack(level,
+			logContext ? logContext->Fields() : std::string_view(), caller);
+
+		DeliverRecord(level, now, file, line, func, category, format, payload, context);
+	}
+
+	/**
+	 * @brief Creates the file sink Init uses for one output path.
+	 *
+	 * In asynchronous mode the sink is created unopened and the backend
+	 * flushes it once per batch instead of once per record.
+	 */
+	std::shared_ptr<RELogger::Sink> MakeFileSink(const std::string& path, const RELogger::Config& config)
+	{
+		RELogger::FileSinkOptions options;
+		options.deferOpen = config.asynchronous;
+		options.flushEachRecord = !config.asynchronous;
+		options.compressBlocks = config.fileFormat == RELogger::FileFormat::TextBlocks;
+
+		if (config.fileFormat == RELogger::FileFormat::Compressed)
+			return std::make_shared<RELogger::CompressedFileSink>(path, options, config.compressedSiteTable);
+		return std::make_shared<RELogger::FileSink>(path, options);
+	}
+
+	/**
+	 * @brief Gives a sink created by Init its own writer thread if configured.
+	 */
+	std::shared_ptr<RELogger::Sink> MakeOutput(std::shared_ptr<RELogger::Sink> sink, const RELogger::Config& config)
+	{
+		if (!config.sinkThreads)
+			return sink;
+		return std::make_shared<RELogger::ThreadedSink>(std::move(sink), config.sinkLagLimit, config.sinkOverrun);
+	}
+
+	/**
+	 * @brief Handles the end of the process for a logger that was never
+	 *        initialized or never shut down.
+	 *
+	 * Constant-initialized, so its destructor runs after every dynamically
+	 * initialized static has been destroyed. Early records that never saw an
+	 * Init are printed to stderr rather than lost; a logger still running
+	 * is shut down so queued records reach their sinks. Any later logging
+	 * falls back to stderr.
+	 */
+	struct ExitGuard
+	{
+		constexpr ExitGuard() = default;
+
+		~ExitGuard()
+		{
+			switch (lifecycle.load(std::memory_order_acquire))
+			{
+				case Lifecycle::PreInit:
+					lifecycle.store(Lifecycle::ShutDown, std::memory_order_release);
+					ReplayPendingRecords(TakePendingRecords(), nullptr);
+					break;
+				case Lifecycle::Running:
+					RELogger::Shutdown();
+					break;
+				case Lifecycle::ShutDown:
+					break;
+			}
+		}
+	};
+
+	constinit ExitGuard exitGuard;
+}
+
+// ============================================================================
+//                          INTERNAL IMPLEMENTATION
+// ============================================================================
+
+/**
+ * @brief Announces the current epoch in this thread's slot (outermost guard only).
+ */
+RELogger::Internal::EpochGuard::EpochGuard()
+{
+	if (threadReadDepth++ > 0)
+		return;
+
+	slot = ClaimReaderSlot();
+	if (slot)
+		slot->epoch.store(globalEpoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+	else
+		overflowReaders.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Clears this thread's announcement when the outermost guard ends.
+ */
+RELogger::Internal::EpochGuard::~EpochGuard()
+{
+	if (--threadReadDepth > 0)
+		return;
+
+	if (slot)
+		slot->epoch.store(0, std::memory_order_release);
+	else
+		overflowReaders.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the published sink set (caller holds an EpochGuard).
+ */
+const RELogger::Internal::SinkSet* RELogger::Internal::LoadActiveSinks()
+{
+	return activeSinks.load(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Waits for every reader that entered before the call to leave.
+ */
+void RELogger::Internal::SynchronizeReaders()
+{
+	WaitForGracePeriod(globalEpoch.fetch_add(1, std::memory_order_seq_cst));
+}
+
+/**
+ * @brief Builds the shared plain-text line for a record.
+ *
+ * The HH:MM:SS prefix is cached per thread and only recomputed when the
+ * second changes, which keeps localtime (and its timezone lock) off the
+ * per-record path. Message and context are user text and go through
+ * AppendEscaped, so they can neither end the line nor forge another.
+ */
+void RELogger::Internal::FormatRecordText(std::string& out, LogLevel level,
+										  std::chrono::system_clock::time_point time,
+										  const char* file, int line, const char* func,
+										  std::string_view message, std::string_view context)
+{
+	// -------------------------------------------------------------------------
+	// Timestamp Generation
+	// -------------------------------------------------------------------------
+	constinit thread_local std::time_t cachedSecond = -1;
+	constinit thread_local char cachedTime[16] = {};
+
+	std::time_t t_c = std::chrono::system_clock::to_time_t(time);
+	if (t_c != cachedSecond)
+	{
+		std::tm tm {};
+#ifdef _WIN32
+		localtime_s(&tm, &t_c);
+#else
+		localtime_r(&t_c, &tm);
+#endif
+		std::strftime(cachedTime, sizeof(cachedTime), "%H:%M:%S", &tm);
+		cachedSecond = t_c;
+	}
+
+	char lineStr[16];
+	int lineLen = std::snprintf(lineStr, sizeof(lineStr), "%d", line);
+
+	out.clear();
+	out += '[';
+	out += cachedTime;
+	out += "] ";
+	out += LevelToString(level);
+	out += ' ';
+	out += file;
+	out += ':';
+	out.append(lineStr, static_cast<std::size_t>(lineLen));
+	out += " (";
+	out += func;
+	out += ')';
+	if (!context.empty())
+	{
+		out += " [";
+		AppendEscaped(out, context);
+		out += ']';
+	}
+	out += " - ";
+	AppendEscaped(out, message);
+}
+
+/**
+ * @brief Delivers a record to every sink of a set, or to stderr without one.
+ */
+void RELogger::Internal::DispatchRecord(const SinkSet* sinks, const LogRecord& record)
+{
+	CountRecord(record);
+	if (!sinks)
+	{
+		WriteToStderr(record.text);
+		return;
+	}
+
+	for (const std::shared_ptr<Sink>& sink : sinks->sinks)
+		sink->Write(record);
+}
+
+/**
+ * @brief Flushes every sink of a set.
+ */
+void RELogger::Internal::FlushSinks(const SinkSet* sinks)
+{
+	if (!sinks)
+		return;
+
+	for (const std::shared_ptr<Sink>& sink : sinks->sinks)
+		sink->Flush();
+}
+
+/**
+ * @brief Replaces one sink of the active set; the caller holds logMutex.
+ * @param target Sink to take out, or nullptr to append replacement.
+ * @param replacement Sink to put in its place, or nullptr.
+ */
+void RELogger::Internal::ReplaceSinkLocked(const Sink* target, const std::shared_ptr<Sink>& replacement)
+{
+	SinkSet* next = CopyActiveSinkSet();
+	const bool present = replacement && std::find(next->sinks.begin(), next->sinks.end(), replacement) != next->sinks.end();
+
+	if (!target)
+	{
+		if (replacement && !present)
+			next->sinks.push_back(replacement);
+		PublishSinkSet(next);
+		return;
+	}
+
+	for (auto it = next->sinks.begin(); it != next->sinks.end(); ++it)
+	{
+		if (it->get() != target)
+			continue;
+		if (replacement && !present)
+			*it = replacement;
+		else
+			next->sinks.erase(it);
+		break;
+	}
+	PublishSinkSet(next);
+}
+
+/**
+ * @brief Replaces one sink of the active set unless logMutex is busy.
+ * @return False if the mutex was held by someone else.
+ */
+bool RELogger::Internal::TryReplaceSink(const Sink* target, const std::shared_ptr<Sink>& replacement)
+{
+	std::unique_lock<std::mutex> lock(logMutex, std::try_to_lock);
+	if (!lock.owns_lock())
+		return false;
+
+	ReplaceSinkLocked(target, replacement);
+	return true;
+}
+
+/**
+ * @brief Delivers a record whose time and context were already taken.
+ *
+ * The body of SubmitRecord, shared with LogBatch. See SubmitRecord for
+ * the paths a record can take.
+ */
+void RELogger::Internal::DeliverRecord(LogLevel level, std::chrono::system_clock::time_point now,
+									   const char* file, int line, const char* func,
+									   const char* category, const char* format, std::string_view payload,
+									   std::string_view context)
+{
+	// ---------------------------------------------------------------------
+	// Asynchronous Path: copy the raw record, format on the backend
+	// ---------------------------------------------------------------------
+	if (IsBackendActive() && !IsBackendThread())
+	{
+		EnqueueRecord(level, now, file, line, func, category, format, payload, context);
+		if (level == LogLevel::Fatal)
+			FlushBackend();
+		return;
+	}
+
+	// ---------------------------------------------------------------------
+	// Synchronous Path: format once, shared by every sink
+	// ---------------------------------------------------------------------
+	std::string formatted;
+	std::string_view message = payload;
+	if (format)
+	{
+		FormatArgs(formatted, format, payload);
+		message = formatted;
+	}
+
+	std::string text;
+	FormatRecordText(text, level, now, file, line, func, message, context);
+
+	const RELogger::LogRecord record { level, now, file, line, func, message, text,
+		format, format ? payload : std::string_view(), category, context };
+
+	const SinkSet* sinks = LoadActiveSinks();
+	if (!sinks)
 	{
-		switch (level)
+		// Only reached outside the Init..Shutdown window. A Fatal record
+		// goes straight to stderr: an abort that follows it would lose
+		// the buffer before Init or the exit replay gets to it.
+		if (lifecycle.load(std::memory_order_acquire) == Lifecycle::PreInit && level != LogLevel::Fatal)
 		{
-			case LogLevel::Trace: return "\033[37m"; // White
-			case LogLevel::Debug: return "\033[36m"; // Cyan
-			case LogLevel::Info:  return "\033[32m"; // Green
-			case LogLevel::Warn:  return "\033[33m"; // Yellow
-			case LogLevel::Error: return "\033[31m"; // Red
-			case LogLevel::Fatal: return "\033[41m"; // Red background
-			default: return "\033[0m";               // Reset
+			if (BufferPendingRecord(record))
+				return;
+			sinks = LoadActiveSinks(); // Init drained the buffer meanwhile.
 		}
 	}
+
+	DispatchRecord(sinks, record);
+}
+
+/**
+ * @brief Submits a RELOG_*F record (site format plus encoded arguments).
+ * @param site Static description of the call site.
+ * @param args Argument blob built by LogFormat.
+ */
+void RELogger::Internal::LogEncoded(const LogSite& site, std::string_view args)
+{
+#ifndef NDEBUG // Logging disabled in release builds unless explicitly enabled
+	if (!IsLogEnabled(site.level, site.file, site.line, site.category))
+		return;
+
+	const std::uint64_t start = BeginLogOverhead();
+	SubmitRecord(site.level, site.file, site.line, site.func, site.category, site.format, args,
+		RELOGGER_RETURN_ADDRESS());
+	EndLogOverhead(start);
+#endif
+}
+
+/**
+ * @brief Reports a failed RELOG_CHECK / RELOG_ASSERT and aborts.
+ *
+ * Written regardless of the active level or NDEBUG. Fatal records already
+ * wait for the backend, and go straight to stderr before Init; the extra
+ * Flush covers synchronous mode.
+ */
+void RELogger::Internal::FailCheck(const CheckSite& site, std::string_view detail)
+{
+	std::string message = "Check failed: ";
+	message += site.expression;
+	message += detail;
+
+	SubmitRecord(LogLevel::Fatal, site.file, site.line, site.func, nullptr, nullptr, message, RELOGGER_RETURN_ADDRESS());
+	RELogger::Flush();
+	std::abort();
+}
+
+/**
+ * @brief Replays the pre-Init buffer into a sink set.
+ */
+void RELogger::Internal::ReplayEarlyRecords(const SinkSet* sinks)
+{
+	ReplayPendingRecords(TakePendingRecords(), sinks);
 }
 
 // ============================================================================
@@ -85,72 +757,174 @@ namespace
 /**
  * @brief Initializes the logger and optionally opens a file for log output.
  *
- * If a file path is provided, it will open or overwrite the file for new logs.
- * If not provided, only console output will be active.
+ * Equivalent to Init with a default Config carrying the path.
  *
  * @param logFilePath Path to the log file. Leave empty to disable file logging.
  */
 void RELogger::Init(const std::string& logFilePath)
+{
+	Config config;
+	config.logFilePath = logFilePath;
+	Init(config);
+}
+
+/**
+ * @brief Initializes the logger with explicit options.
+ *
+ * Publishes a sink set containing the console and, if a file path is
+ * provided, a FileSink that opens or overwrites the file for new logs,
+ * plus one filtered file sink per entry of config.fileRoutes.
+ *
+ * In asynchronous mode the FileSink is created unopened and the backend
+ * thread opens it (creating its directories) before draining any queue,
+ * so Init itself does no file I/O. Records logged meanwhile are buffered
+ * in the per-thread queues.
+ *
+ * @param config Output and threading options.
+ */
+void RELogger::Init(const Config& config)
 {
 	std::lock_guard<std::mutex> lock(logMutex);
-	if (!logFilePath.empty())
+
+	StopBackend();
+	StartTickCalibration();
+	SetClock(config.clock);
+	SetStackCapture(config.stackFrames, config.stackLevel);
+
+	if (!config.sharedLevelPage)
+		CloseLevelPage();
+	else if (!OpenLevelPage())
+		WriteToStderr("[LOGGER WARNING] Shared level page unavailable; levels stay process-local");
+
+	if (!config.sharedStatsPage)
+		CloseStatsPage();
+	else if (!OpenStatsPage())
+		WriteToStderr("[LOGGER WARNING] Shared stats page unavailable");
+
+	SinkSet* sinks = new SinkSet();
+	sinks->sinks.push_back(MakeOutput(std::make_shared<ConsoleSink>(), config));
+	if (!config.logFilePath.empty())
+		sinks->sinks.push_back(MakeOutput(MakeFileSink(config.logFilePath, config), config));
+
+	for (const FileRoute& route : config.fileRoutes)
 	{
-		logFile.open(logFilePath, std::ios::out | std::ios::trunc);
-		if (!logFile)
-		{
-			std::cerr << "\033[31m[LOGGER ERROR] Failed to open log file: "
-					  << logFilePath << "\033[0m" << std::endl;
-		}
+		sinks->sinks.push_back(MakeOutput(std::make_shared<FilterSink>(
+			MakeFileSink(route.path, config), route.minLevel, route.category), config));
+	}
+
+	PublishSinkSet(sinks);
+	lifecycle.store(Lifecycle::Running, std::memory_order_release);
+
+	if (config.asynchronous)
+	{
+		// The backend replays early records itself, after opening the file.
+		StartBackend(config);
+		return;
 	}
+
+	// Records logged before the first Init are replayed into the new sinks.
+	// Threads that log concurrently already see the published set, so a few
+	// of their lines may land ahead of the replayed ones.
+	EpochGuard guard;
+	ReplayEarlyRecords(LoadActiveSinks());
 }
 
 /**
- * @brief Gracefully shuts down the logger, flushing and closing the log file.
+ * @brief Gracefully shuts down the logger, flushing and closing every sink.
+ *
+ * Drains the asynchronous queues first, then returns once no thread can
+ * still be writing to the old sinks. Records logged afterwards (e.g. from
+ * static destructors) are written directly to stderr.
  */
 void RELogger::Shutdown()
 {
 	std::lock_guard<std::mutex> lock(logMutex);
-	if (logFile.is_open())
-	{
-		logFile.flush();
-		logFile.close();
-	}
+
+	StopBackend();
+	CloseLevelPage();
+
+	lifecycle.store(Lifecycle::ShutDown, std::memory_order_release);
+	ReplayPendingRecords(TakePendingRecords(), nullptr);
+
+	FlushSinks(activeSinks.load(std::memory_order_acquire));
+
+	PublishSinkSet(nullptr);
+	WaitForRetiredSets();
+	CloseStatsPage();
+}
+
+/**
+ * @brief Waits until every record logged so far has reached the sinks.
+ *
+ * In asynchronous mode this waits for the backend to drain the queues;
+ * either way, every active sink is flushed before returning.
+ */
+void RELogger::Flush()
+{
+	EpochGuard guard;
+
+	if (IsBackendActive() && !IsBackendThread())
+		FlushBackend();
+	else
+		FlushSinks(LoadActiveSinks());
 }
 
 /**
- * @brief Sets the minimum severity level for log messages.
+ * @brief Attaches a sink to the active sink set.
  *
- * Any message below the specified level will be ignored.
+ * Builds a copy of the current set with the sink appended and publishes
+ * it atomically; concurrent loggers keep using the previous set until
+ * their current record is done.
  *
- * @param level The desired minimum log level (e.g., LogLevel::Warn).
+ * @param sink The sink to attach.
  */
-void RELogger::SetLevel(LogLevel level)
+void RELogger::AddSink(std::shared_ptr<Sink> sink)
 {
+	if (!sink)
+		return;
+
 	std::lock_guard<std::mutex> lock(logMutex);
-	currentLevel = level;
+
+	SinkSet* next = CopyActiveSinkSet();
+	next->sinks.push_back(std::move(sink));
+	PublishSinkSet(next);
 }
 
 /**
- * @brief Retrieves the currently active log level.
- * @return The current LogLevel setting.
+ * @brief Detaches a sink from the active sink set.
+ *
+ * The sink is flushed once detached. It is destroyed when the last
+ * reference (the caller's or a retired set's) goes away.
+ *
+ * @param sink The sink to detach.
  */
-LogLevel RELogger::GetLevel()
+void RELogger::RemoveSink(const std::shared_ptr<Sink>& sink)
 {
 	std::lock_guard<std::mutex> lock(logMutex);
-	return currentLevel;
+
+	SinkSet* next = CopyActiveSinkSet();
+	std::erase(next->sinks, sink);
+	PublishSinkSet(next);
+
+	if (sink)
+		sink->Flush();
 }
 
 /**
- * @brief Logs a message to both console and file with full contextual details.
+ * @brief Logs a message to every active sink with full contextual details.
  *
- * Produces colorized output in the console and a clean plain-text log in the file.
- * Each message includes:
+ * The record is formatted once into a plain-text line; the console adds
+ * color around it, files write it as-is. Each message includes:
  *  - Timestamp (HH:MM:SS)
  *  - Log level
  *  - File name, line number, and function name
  *  - Log message
  *
- * Thread-safe. Automatically skips logs below the active log level.
+ * Thread-safe without a global lock; see SubmitRecord. Automatically skips
+ * logs below the active log level. Callable at any point of the process
+ * lifetime: before Init the record is buffered in memory, after Shutdown
+ * it is written straight to stderr. Time spent here is added to the calling
+ * thread's totals (relogger_stats.h).
  *
  * @param level Severity of the message.
  * @param message The message to log.
@@ -161,47 +935,11 @@ LogLevel RELogger::GetLevel()
 void RELogger::Log(LogLevel level, std::string_view message, const char* file, int line, const char* func)
 {
 #ifndef NDEBUG // Logging disabled in release builds unless explicitly enabled
-	if (level < currentLevel)
+	if (!IsLogEnabled(level, file, line, nullptr))
 		return;
 
-	std::lock_guard<std::mutex> lock(logMutex);
-
-	// -------------------------------------------------------------------------
-	// Timestamp Generation
-	// -------------------------------------------------------------------------
-	auto now = std::chrono::system_clock::now();
-	std::time_t t_c = std::chrono::system_clock::to_time_t(now);
-	std::tm tm {};
-
-#ifdef _WIN32
-	localtime_s(&tm, &t_c);
-#else
-	localtime_r(&t_c, &tm);
-#endif
-
-	std::ostringstream oss;
-	oss << std::put_time(&tm, "%H:%M:%S");
-
-	// -------------------------------------------------------------------------
-	// Console Output
-	// -------------------------------------------------------------------------
-	std::ostream& out = (level >= LogLevel::Error) ? std::cerr : std::cout;
-	out << LevelToColor(level)
-		<< "[" << oss.str() << "] "
-		<< LevelToString(level) << " "
-		<< file << ":" << line << " (" << func << ") - "
-		<< message
-		<< "\033[0m" << std::endl;
-
-	// -------------------------------------------------------------------------
-	// File Output (if enabled)
-	// -------------------------------------------------------------------------
-	if (logFile.is_open())
-	{
-		logFile << "[" << oss.str() << "] "
-				<< LevelToString(level) << " "
-				<< file << ":" << line << " (" << func << ") - "
-				<< message << std::endl;
-	}
+	const std::uint64_t start = BeginLogOverhead();
+	SubmitRecord(level, file, line, func, nullptr, nullptr, message, RELOGGER_RETURN_ADDRESS());
+	EndLogOverhead(start);
 #endif
 }
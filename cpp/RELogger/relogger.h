@@ -13,6 +13,9 @@
     - Modern C++ interface (std::string_view, std::format)
     - Level-based filtering (Trace → Fatal)
     - Optional file logging
+    - Runtime-swappable output sinks (see relogger_sink.h)
+    - Asynchronous mode: per-thread queues drained by a backend thread
+    - Deferred "{}" formatting (see relogger_format.h)
     - Thread-safe (implemented in .cpp)
     - Platform-independent macros
 
@@ -27,8 +30,12 @@
 #ifndef RELOGGER_H
 #define RELOGGER_H
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <format>
 
 /*
@@ -58,6 +65,102 @@ enum class LogLevel
 */
 namespace RELogger
 {
+    class Clock;
+    class Sink;
+
+    /*
+    =======================================================================
+      ENUM CLASS: QueueFullPolicy
+      ---------------------------------------------------------------------
+      What a logging thread does when its asynchronous queue is full.
+    =======================================================================
+    */
+    enum class QueueFullPolicy
+    {
+        Block,  /**< Wait for the backend to make room (no record is lost). */
+        Drop,   /**< Discard the record; drops are reported by the backend. */
+    };
+
+    /*
+    =======================================================================
+      ENUM CLASS: SinkOverrunPolicy
+      ---------------------------------------------------------------------
+      What the backend does when a sink's writer thread is too far
+      behind (see ThreadedSink in relogger_sink.h).
+    =======================================================================
+    */
+    enum class SinkOverrunPolicy
+    {
+        Block,       /**< Wait for the writer (the backend slows down, nothing is lost). */
+        DropOldest,  /**< Discard the oldest records the writer has not started on. */
+        DropNewest,  /**< Discard the records being posted. */
+    };
+
+    /*
+    =======================================================================
+      ENUM CLASS: FileFormat
+      ---------------------------------------------------------------------
+      Encoding of the log file created by Init.
+    =======================================================================
+    */
+    enum class FileFormat
+    {
+        Text,        /**< Plain text, one line per record. */
+        Compressed,  /**< Template dictionary format (see relogger_compressed.h). */
+        TextBlocks,  /**< Plain text in independently LZ-compressed blocks (see relogger_block.h). */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: FileRoute
+      ---------------------------------------------------------------------
+      An extra log file that receives only the records matching its rule,
+      e.g. { "errors.log", LogLevel::Warn } or { "net.log",
+      LogLevel::Trace, "net.*" }. Every file shares the line formatted
+      once for the record.
+    =======================================================================
+    */
+    struct FileRoute
+    {
+        std::string path;                     /**< Output file. Parent directories are created. */
+        LogLevel minLevel = LogLevel::Trace;  /**< Lowest level written. */
+        std::string category;                 /**< "" for every record, "net" for exactly "net", "net.*" for "net" and its subcategories. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: Config
+      ---------------------------------------------------------------------
+      Startup options for RELogger::Init.
+    =======================================================================
+    */
+    struct Config
+    {
+        std::string logFilePath;        /**< Log file; empty for console only. Parent directories are created. */
+        FileFormat fileFormat = FileFormat::Text; /**< Encoding of the log file (and of every route). */
+        bool compressedSiteTable = false; /**< Compressed format: name sites by their index in the executable's site section (relogger_sites.h); decoding then needs relogread --binary. */
+        std::vector<FileRoute> fileRoutes;        /**< Additional files filtered by level and category. */
+        bool asynchronous = true;       /**< Hand records to a backend thread instead of writing inline. */
+        std::size_t queueCapacity = 256 * 1024;                 /**< Bytes per logging thread's queue (its starting size without a profile). */
+        std::size_t queueCapacityLimit = 0;                     /**< Size a full queue may double up to before queueFullPolicy applies; 0 keeps queueCapacity. */
+        std::string queueProfilePath;   /**< Async mode: file recording queue load between runs; the next run sizes its queues from it. */
+        QueueFullPolicy queueFullPolicy = QueueFullPolicy::Block; /**< Behavior when a queue is full. */
+        std::chrono::microseconds backendPollInterval { 1000 }; /**< Longest backend sleep when all queues are empty (it polls sooner right after activity). */
+        std::chrono::microseconds maxFlushDelay { 0 };          /**< Async mode: during bursts, how long written records may wait for a sink flush; 0 flushes after every pass. */
+        std::size_t formatThreads = 0;  /**< Async mode: worker threads formatting records for the backend; 0 formats on the backend. */
+        std::chrono::milliseconds sinkStallTimeout { 0 };       /**< Async mode: a sink call taking longer counts as hung; 0 disables the watchdog. */
+        std::shared_ptr<Sink> stallFallback;                    /**< Takes the place of a hung sink (e.g. a local FileSink or a MemorySink); nullptr just drops it. */
+        bool sinkThreads = false;       /**< Give the console and every file its own writer thread (ThreadedSink). */
+        std::size_t sinkLagLimit = 64 * 1024;                   /**< With sinkThreads: records a writer may fall behind before sinkOverrun applies. */
+        SinkOverrunPolicy sinkOverrun = SinkOverrunPolicy::DropOldest; /**< With sinkThreads: behavior when a writer is too far behind. */
+        std::string controlSocketPath;  /**< Async mode, POSIX: Unix socket for relogctl; empty disables it. */
+        bool sharedLevelPage = false;   /**< Keep levels in a shared-memory page named after the PID (relogger_levels.h). */
+        bool sharedStatsPage = false;   /**< Count records per level, category and site in a shared-memory page (relogger_stats.h). */
+        std::shared_ptr<Clock> clock;   /**< Record timestamps (relogger_clock.h); nullptr reads std::chrono::system_clock. */
+        std::size_t stackFrames = 0;    /**< Return addresses captured into records at stackLevel and above (up to 64); 0 disables. */
+        LogLevel stackLevel = LogLevel::Error; /**< Lowest level that captures a stack when stackFrames is set. */
+    };
+
     /*
     =======================================================================
       FUNCTION: Init
@@ -65,11 +168,27 @@ namespace RELogger
       Initializes the logging system. If a file path is provided, logs
       will also be written to that file in addition to the console.
 
+      In asynchronous mode (the default) Init returns immediately: the
+      file is opened, and its directories created, on the backend
+      thread while records logged in the meantime wait in the queues.
+
       @param logFilePath - Optional path for log file output.
     =======================================================================
     */
     void Init(const std::string& logFilePath = "");
 
+    /*
+    =======================================================================
+      FUNCTION: Init
+      ---------------------------------------------------------------------
+      Initializes the logging system with explicit options. Calling it
+      again replaces the previous configuration.
+
+      @param config - Output and threading options.
+    =======================================================================
+    */
+    void Init(const Config& config);
+
     /*
     =======================================================================
       FUNCTION: Shutdown
@@ -80,12 +199,24 @@ namespace RELogger
     */
     void Shutdown();
 
+    /*
+    =======================================================================
+      FUNCTION: Flush
+      ---------------------------------------------------------------------
+      Blocks until every record logged before the call has been written
+      to the active sinks and the sinks have been flushed.
+    =======================================================================
+    */
+    void Flush();
+
     /*
     =======================================================================
       FUNCTION: Log
       ---------------------------------------------------------------------
       Core logging function that handles message formatting and
-      level-based output.
+      level-based output. In asynchronous mode the record is copied into
+      the calling thread's queue and formatted on the backend; Fatal
+      records additionally wait until they have been written.
 
       @param level   - The severity level of the log.
       @param message - The log message text.
@@ -119,6 +250,32 @@ namespace RELogger
     =======================================================================
     */
     LogLevel GetLevel();
+
+    /*
+    =======================================================================
+      FUNCTION: AddSink
+      ---------------------------------------------------------------------
+      Attaches an additional output to the active sink set. Safe to call
+      while other threads are logging; records logged after this call
+      returns are delivered to the new sink.
+
+      @param sink - The sink to attach. Null sinks are ignored.
+    =======================================================================
+    */
+    void AddSink(std::shared_ptr<Sink> sink);
+
+    /*
+    =======================================================================
+      FUNCTION: RemoveSink
+      ---------------------------------------------------------------------
+      Detaches a sink from the active sink set. Threads already writing
+      to it may finish their current record; the logger releases its
+      reference once they have.
+
+      @param sink - The sink to detach.
+    =======================================================================
+    */
+    void RemoveSink(const std::shared_ptr<Sink>& sink);
 }
 
 /*
@@ -137,6 +294,8 @@ namespace RELogger
 #define RELOG_ERROR(msg) RELogger::Log(LogLevel::Error, msg, __FILE__, __LINE__, __func__)
 #define RELOG_FATAL(msg) RELogger::Log(LogLevel::Fatal, msg, __FILE__, __LINE__, __func__)
 
+#include "relogger_format.h"
+
 /*
 ===============================================================================
   END OF FILE
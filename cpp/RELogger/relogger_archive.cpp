@@ -0,0 +1,389 @@
+/**
+ * @file relogger_archive.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Time-indexed reader over directories of block-compressed logs.
+ */
+
+#include "relogger_archive.h"
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <string_view>
+
+namespace
+{
+	constexpr std::int64_t SecondsPerDay = 86400;
+
+	/**
+	 * @brief A block of one segment that overlaps the queried range.
+	 */
+	struct BlockRef
+	{
+		std::size_t segment;
+		std::size_t block;
+		std::int64_t firstTime;
+		std::int64_t lastTime;
+	};
+
+	/**
+	 * @brief A text line and the local time it was logged at, in seconds.
+	 */
+	struct MergeLine
+	{
+		std::string_view text;
+		std::int64_t second;
+	};
+
+	/**
+	 * @brief Epoch second of the local midnight before a timestamp, and the
+	 *        time of day (as in the "[HH:MM:SS]" prefix) of the timestamp.
+	 */
+	void LocalDay(std::int64_t timestamp, std::int64_t& midnight, std::int64_t& timeOfDay)
+	{
+		const std::time_t seconds = static_cast<std::time_t>(timestamp / 1000000000);
+		std::tm tm {};
+#ifdef _WIN32
+		localtime_s(&tm, &seconds);
+#else
+		localtime_r(&seconds, &tm);
+#endif
+		timeOfDay = tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+		midnight = static_cast<std::int64_t>(seconds) - timeOfDay;
+	}
+
+	/**
+	 * @brief Reads the "[HH:MM:SS]" prefix of a record line.
+	 * @return False for lines without one, such as "[LOGGER MODULE]".
+	 */
+	bool LineTimeOfDay(std::string_view line, std::int64_t& timeOfDay)
+	{
+		if (line.size() < 10 || line[0] != '[' || line[3] != ':' || line[6] != ':' || line[9] != ']')
+			return false;
+
+		int fields[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			const char high = line[1 + i * 3];
+			const char low = line[2 + i * 3];
+			if (high < '0' || high > '9' || low < '0' || low > '9')
+				return false;
+			fields[i] = (high - '0') * 10 + (low - '0');
+		}
+		timeOfDay = fields[0] * 3600 + fields[1] * 60 + fields[2];
+		return true;
+	}
+
+	/**
+	 * @brief Splits one segment's text into lines keyed by local second.
+	 *
+	 * The day comes from the first block's timestamp and moves on whenever
+	 * the time of day falls back by more than half a day. Lines without a
+	 * time take that of the line before them.
+	 */
+	void SplitLines(std::string_view text, std::int64_t firstTime, std::vector<MergeLine>& lines)
+	{
+		std::int64_t midnight, previous;
+		LocalDay(firstTime, midnight, previous);
+		std::int64_t second = midnight + previous;
+
+		while (!text.empty())
+		{
+			const std::size_t end = text.find('\n');
+			const std::string_view line = text.substr(0, end == std::string_view::npos ? text.size() : end + 1);
+			text.remove_prefix(line.size());
+
+			std::int64_t timeOfDay;
+			if (LineTimeOfDay(line, timeOfDay))
+			{
+				if (timeOfDay + SecondsPerDay / 2 < previous)
+					midnight += SecondsPerDay;
+				previous = timeOfDay;
+				second = midnight + timeOfDay;
+			}
+			lines.push_back(MergeLine { line, second });
+		}
+	}
+
+	/**
+	 * @brief Writes the lines of several segments in time order, each
+	 *        record once.
+	 *
+	 * Streams are ordered fullest first, and on equal seconds the earlier
+	 * stream goes first, so the main file's order wins over its routes'.
+	 * Writing a line consumes one identical line of the same second from
+	 * every other stream: that is the same record in a route file.
+	 */
+	void MergeStreams(std::vector<std::vector<MergeLine>>& streams, std::ostream& out)
+	{
+		std::stable_sort(streams.begin(), streams.end(),
+			[](const std::vector<MergeLine>& a, const std::vector<MergeLine>& b) { return a.size() > b.size(); });
+
+		std::vector<std::size_t> next(streams.size(), 0);
+		std::vector<std::vector<bool>> consumed(streams.size());
+		for (std::size_t i = 0; i < streams.size(); ++i)
+			consumed[i].resize(streams[i].size());
+
+		for (;;)
+		{
+			std::size_t pick = streams.size();
+			for (std::size_t i = 0; i < streams.size(); ++i)
+			{
+				while (next[i] < streams[i].size() && consumed[i][next[i]])
+					++next[i];
+				if (next[i] < streams[i].size()
+					&& (pick == streams.size() || streams[i][next[i]].second < streams[pick][next[pick]].second))
+				{
+					pick = i;
+				}
+			}
+			if (pick == streams.size())
+				return;
+
+			const MergeLine& line = streams[pick][next[pick]++];
+			out.write(line.text.data(), static_cast<std::streamsize>(line.text.size()));
+
+			for (std::size_t i = 0; i < streams.size(); ++i)
+			{
+				if (i == pick)
+					continue;
+				for (std::size_t j = next[i]; j < streams[i].size() && streams[i][j].second <= line.second; ++j)
+				{
+					if (!consumed[i][j] && streams[i][j].second == line.second && streams[i][j].text == line.text)
+					{
+						consumed[i][j] = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+// ============================================================================
+//                               RANGE INDEX
+// ============================================================================
+
+/**
+ * @brief Precomputes the running bounds for a list of time ranges.
+ * @param items Anything with firstTime / lastTime members.
+ */
+template<typename Items>
+void RELogger::LogArchive::RangeIndex::Build(const Items& items)
+{
+	const std::size_t count = items.size();
+	maxLastBefore.resize(count);
+	minFirstAfter.resize(count);
+
+	std::int64_t maxLast = std::numeric_limits<std::int64_t>::min();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		maxLast = std::max(maxLast, items[i].lastTime);
+		maxLastBefore[i] = maxLast;
+	}
+
+	std::int64_t minFirst = std::numeric_limits<std::int64_t>::max();
+	for (std::size_t i = count; i-- > 0;)
+	{
+		minFirst = std::min(minFirst, items[i].firstTime);
+		minFirstAfter[i] = minFirst;
+	}
+}
+
+/**
+ * @brief Narrows down the items that may overlap [from, to].
+ *
+ * Items before begin all end before from; items from end onwards all
+ * start after to. Items in between still need an individual check.
+ */
+void RELogger::LogArchive::RangeIndex::Find(std::int64_t from, std::int64_t to,
+											std::size_t& begin, std::size_t& end) const
+{
+	begin = static_cast<std::size_t>(std::lower_bound(maxLastBefore.begin(), maxLastBefore.end(), from)
+		- maxLastBefore.begin());
+	end = static_cast<std::size_t>(std::upper_bound(minFirstAfter.begin(), minFirstAfter.end(), to)
+		- minFirstAfter.begin());
+	end = std::max(begin, end);
+}
+
+// ============================================================================
+//                                 ARCHIVE
+// ============================================================================
+
+/**
+ * @brief Reads one file's block index and records it as a segment.
+ * @return False if the file is not a block-compressed log or holds no blocks.
+ */
+bool RELogger::LogArchive::AddSegment(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	LogSegment segment;
+	if (!in || !ReadLogBlockIndex(in, segment.blocks) || segment.blocks.empty())
+		return false;
+
+	segment.path = path;
+	segment.firstTime = segment.blocks.front().firstTime;
+	segment.lastTime = segment.blocks.front().lastTime;
+	for (const LogBlockInfo& block : segment.blocks)
+	{
+		segment.firstTime = std::min(segment.firstTime, block.firstTime);
+		segment.lastTime = std::max(segment.lastTime, block.lastTime);
+	}
+	segments.push_back(std::move(segment));
+	return true;
+}
+
+/**
+ * @brief Indexes a file or every block-compressed log in a directory.
+ * @param path File or directory.
+ */
+bool RELogger::LogArchive::Open(const std::string& path)
+{
+	segments.clear();
+	blockRanges.clear();
+
+	std::error_code error;
+	if (std::filesystem::is_directory(path, error))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+		{
+			if (entry.is_regular_file(error))
+				AddSegment(entry.path().string());
+		}
+	}
+	else
+	{
+		AddSegment(path);
+	}
+
+	std::sort(segments.begin(), segments.end(), [](const LogSegment& a, const LogSegment& b)
+	{
+		return a.firstTime != b.firstTime ? a.firstTime < b.firstTime : a.path < b.path;
+	});
+
+	segmentRanges.Build(segments);
+	blockRanges.resize(segments.size());
+	for (std::size_t i = 0; i < segments.size(); ++i)
+		blockRanges[i].Build(segments[i].blocks);
+
+	return !segments.empty();
+}
+
+/**
+ * @brief Earliest timestamp in the archive (0 if empty).
+ */
+std::int64_t RELogger::LogArchive::FirstTime() const
+{
+	return segments.empty() ? 0 : segments.front().firstTime;
+}
+
+/**
+ * @brief Latest timestamp in the archive (0 if empty).
+ */
+std::int64_t RELogger::LogArchive::LastTime() const
+{
+	return segmentRanges.maxLastBefore.empty() ? 0 : segmentRanges.maxLastBefore.back();
+}
+
+/**
+ * @brief Decodes only the blocks that overlap [from, to].
+ *
+ * The blocks are taken in order of their first timestamp and grouped
+ * into runs that overlap in time. A run from a single segment is written
+ * as stored; one spanning several segments is merged line by line.
+ */
+bool RELogger::LogArchive::Extract(std::int64_t from, std::int64_t to, std::ostream& out) const
+{
+	std::size_t firstSegment, endSegment;
+	segmentRanges.Find(from, to, firstSegment, endSegment);
+
+	std::vector<BlockRef> refs;
+	for (std::size_t s = firstSegment; s < endSegment; ++s)
+	{
+		const LogSegment& segment = segments[s];
+		if (segment.lastTime < from || segment.firstTime > to)
+			continue;
+
+		std::size_t firstBlock, endBlock;
+		blockRanges[s].Find(from, to, firstBlock, endBlock);
+		for (std::size_t b = firstBlock; b < endBlock; ++b)
+		{
+			const LogBlockInfo& block = segment.blocks[b];
+			if (block.lastTime >= from && block.firstTime <= to)
+				refs.push_back(BlockRef { s, b, block.firstTime, block.lastTime });
+		}
+	}
+	std::stable_sort(refs.begin(), refs.end(),
+		[](const BlockRef& a, const BlockRef& b) { return a.firstTime < b.firstTime; });
+
+	std::vector<std::ifstream> files(segments.size());
+	auto readBlock = [&](const BlockRef& ref, std::string& text)
+	{
+		std::ifstream& in = files[ref.segment];
+		if (!in.is_open())
+			in.open(segments[ref.segment].path, std::ios::binary);
+		if (!in)
+			return false;
+
+		LogBlockInfo header;
+		in.clear();
+		in.seekg(static_cast<std::streamoff>(segments[ref.segment].blocks[ref.block].offset));
+		return ReadLogBlockHeader(in, header) && ReadLogBlockText(in, header, text);
+	};
+
+	std::string text;
+	for (std::size_t begin = 0; begin < refs.size();)
+	{
+		std::size_t end = begin + 1;
+		std::int64_t lastTime = refs[begin].lastTime;
+		bool mixed = false;
+		for (; end < refs.size() && refs[end].firstTime <= lastTime; ++end)
+		{
+			lastTime = std::max(lastTime, refs[end].lastTime);
+			mixed = mixed || refs[end].segment != refs[begin].segment;
+		}
+
+		if (!mixed)
+		{
+			std::sort(refs.begin() + static_cast<std::ptrdiff_t>(begin), refs.begin() + static_cast<std::ptrdiff_t>(end),
+				[](const BlockRef& a, const BlockRef& b) { return a.block < b.block; });
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				if (!readBlock(refs[i], text))
+					return false;
+				out.write(text.data(), static_cast<std::streamsize>(text.size()));
+			}
+			begin = end;
+			continue;
+		}
+
+		// Each segment's blocks of the run, in file order, as one text.
+		std::sort(refs.begin() + static_cast<std::ptrdiff_t>(begin), refs.begin() + static_cast<std::ptrdiff_t>(end),
+			[](const BlockRef& a, const BlockRef& b) { return a.segment != b.segment ? a.segment < b.segment : a.block < b.block; });
+		std::vector<std::string> texts;
+		std::vector<std::int64_t> firstTimes;
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			if (!readBlock(refs[i], text))
+				return false;
+			if (i == begin || refs[i].segment != refs[i - 1].segment)
+			{
+				texts.emplace_back();
+				firstTimes.push_back(refs[i].firstTime);
+			}
+			texts.back() += text;
+			firstTimes.back() = std::min(firstTimes.back(), refs[i].firstTime);
+		}
+
+		std::vector<std::vector<MergeLine>> streams(texts.size());
+		for (std::size_t i = 0; i < texts.size(); ++i)
+			SplitLines(texts[i], firstTimes[i], streams[i]);
+		MergeStreams(streams, out);
+		begin = end;
+	}
+	return true;
+}
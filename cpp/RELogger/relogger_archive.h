@@ -0,0 +1,144 @@
+/*
+===============================================================================
+
+  RELogger - Log Archive Reader (C++ Header)
+  ------------------------------------------
+
+  Treats a directory of block-compressed log files (FileFormat::TextBlocks,
+  see relogger_block.h) as one stream ordered by time. Opening the
+  archive reads only each file's header and block index; a time range
+  query binary-searches the segments and their blocks and decompresses
+  just the blocks that overlap the range.
+
+  Granularity is one block: every line of an overlapping block is
+  returned, since the text lines themselves only carry HH:MM:SS.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_ARCHIVE_H
+#define RELOGGER_ARCHIVE_H
+
+#include "relogger_block.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: LogSegment
+      ---------------------------------------------------------------------
+      One file of an archive and the blocks it holds.
+    =======================================================================
+    */
+    struct LogSegment
+    {
+        std::string path;                 /**< File path. */
+        std::int64_t firstTime = 0;       /**< Earliest record (ns since epoch). */
+        std::int64_t lastTime = 0;        /**< Latest record (ns since epoch). */
+        std::vector<LogBlockInfo> blocks; /**< Text blocks in file order. */
+    };
+
+    /*
+    =======================================================================
+      CLASS: LogArchive
+      ---------------------------------------------------------------------
+      Read-only, time-indexed view over block-compressed log files.
+      Segments may follow each other in time (one stream cut into
+      files) or overlap, as the main file and the route files of one
+      run do (Config::fileRoutes). Blocks from different files whose
+      time ranges overlap are merged by the HH:MM:SS of their lines,
+      and a line repeated with the same second in another file is the
+      same record: it is written once.
+    =======================================================================
+    */
+    class LogArchive
+    {
+    public:
+        /*
+        ===================================================================
+          FUNCTION: Open
+          -----------------------------------------------------------------
+          Indexes a single file, or every block-compressed log directly
+          inside a directory (other files are ignored).
+
+          @param path - File or directory.
+          @return False if no readable segment was found.
+        ===================================================================
+        */
+        bool Open(const std::string& path);
+
+        /*
+        ===================================================================
+          FUNCTION: Segments
+          -----------------------------------------------------------------
+          @return The segments found by Open, sorted by first timestamp.
+        ===================================================================
+        */
+        const std::vector<LogSegment>& Segments() const { return segments; }
+
+        std::int64_t FirstTime() const;
+        std::int64_t LastTime() const;
+
+        /*
+        ===================================================================
+          FUNCTION: Extract
+          -----------------------------------------------------------------
+          Writes the text of every block holding records in [from, to],
+          in time order. Runs of overlapping blocks from one file keep
+          their stored order; runs spanning several files are merged as
+          described on LogArchive, so route copies are dropped.
+
+          @param from - Range start (ns since epoch).
+          @param to   - Range end, inclusive (ns since epoch).
+          @param out  - Destination for the lines.
+          @return False if a needed block could not be read or decoded
+                  (lines before it are still written).
+        ===================================================================
+        */
+        bool Extract(std::int64_t from, std::int64_t to, std::ostream& out) const;
+
+    private:
+        /*
+        ===================================================================
+          STRUCT: RangeIndex
+          -----------------------------------------------------------------
+          Running bounds that make "which items can overlap [from, to]"
+          a pair of binary searches even when neighbouring items overlap
+          slightly in time.
+        ===================================================================
+        */
+        struct RangeIndex
+        {
+            std::vector<std::int64_t> maxLastBefore;  ///< Max lastTime over items [0, i].
+            std::vector<std::int64_t> minFirstAfter;  ///< Min firstTime over items [i, n).
+
+            template<typename Items>
+            void Build(const Items& items);
+            void Find(std::int64_t from, std::int64_t to, std::size_t& begin, std::size_t& end) const;
+        };
+
+        bool AddSegment(const std::string& path);
+
+        std::vector<LogSegment> segments;        ///< Sorted by firstTime.
+        RangeIndex segmentRanges;                ///< Over segments.
+        std::vector<RangeIndex> blockRanges;     ///< Per segment, over its blocks.
+    };
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_ARCHIVE_H */
@@ -0,0 +1,1131 @@
+/**
+ * @file relogger_backend.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Backend thread for asynchronous RELogger mode.
+ *
+ * Logging threads copy raw records into their own queue and return; the
+ * backend merges all queues in timestamp order, formats each record once,
+ * and hands it to the active sinks. All file I/O, including opening the
+ * log file at Init, happens on this thread.
+ */
+
+#include "relogger_format.h"
+#include "relogger_intern.h"
+#include "relogger_internal.h"
+#include "relogger_pool.h"
+#include "relogger_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using namespace RELogger::Internal;
+
+	constexpr std::size_t MinPassRecords = 256;    ///< Pass budget when the queues keep up.
+	constexpr std::size_t MaxPassRecords = 65536;  ///< Pass budget under a sustained backlog.
+	constexpr std::size_t MaxUnflushedRecords = 65536; ///< Written records that force a flush.
+	constexpr std::chrono::microseconds MinIdleWait { 50 }; ///< First sleep after the queues ran dry.
+
+	/**
+	 * @brief A coroutine suspended in WaitDurable.
+	 */
+	struct FlushWaiter
+	{
+		std::uint64_t sequence;
+		std::coroutine_handle<> handle;
+		RELogger::Resumer resume;
+	};
+
+	/**
+	 * @brief Control block of a running backend. Created by StartBackend,
+	 *        destroyed by StopBackend (both under the control mutex). A
+	 *        backend abandoned inside a hung sink call keeps its block.
+	 */
+	struct BackendState
+	{
+		RELogger::Config config;
+		bool watched = false;               ///< True if the watchdog runs (sinkStallTimeout > 0).
+		std::atomic<std::size_t> queueCapacity { 0 }; ///< Size of new queues; set from the profile once loaded.
+		std::size_t queueLimit = 0;         ///< Largest size a queue grows to.
+		QueueProfile earlierProfile;        ///< Loaded by the backend thread, merged when saving.
+
+		std::thread thread;
+		std::thread watchdog;
+		std::mutex mutex;                   ///< Guards the request fields below.
+		std::condition_variable wake;       ///< Signals the backend about requests.
+		std::condition_variable flushed;    ///< Signals waiters that a flush completed or the backend stalled.
+		std::condition_variable watchdogWake; ///< Signals the watchdog to stop.
+		bool stopRequested = false;
+		bool stopWatchdog = false;
+		bool exited = false;                ///< Set by the backend thread when it returns.
+		std::uint64_t flushRequested = 0;   ///< Ticket of the latest flush request.
+		std::uint64_t flushCompleted = 0;   ///< Ticket of the latest finished flush.
+		std::vector<FlushWaiter> flushWaiters; ///< Coroutines waiting for a ticket.
+
+		std::atomic<RELogger::Sink*> busySink { nullptr }; ///< Sink the backend is inside, if any.
+		std::atomic<std::uint64_t> sinkCalls { 0 };        ///< Finished sink calls, for the watchdog.
+		std::atomic<RELogger::Sink*> stalledSink { nullptr }; ///< Sink the watchdog found hung.
+		ControlServer control;              ///< Control socket, used only by the backend thread.
+		std::chrono::steady_clock::time_point stallStart; ///< When stalledSink stopped progressing.
+	};
+
+	constinit std::atomic<bool> backendActive { false };  ///< True while producers should enqueue.
+	constinit std::atomic<bool> backendStalled { false }; ///< True while producers bypass a hung backend.
+	constinit BackendState* backend = nullptr;            ///< Running backend, if any.
+	constinit thread_local bool onBackendThread = false;  ///< Set on the backend thread itself.
+	constinit std::atomic<std::uint64_t> flushSequence { 0 };   ///< Latest flush ticket handed out.
+	constinit std::atomic<std::uint64_t> durableSequence { 0 }; ///< Every ticket up to this one has completed.
+
+	// -------------------------------------------------------------------------
+	// Flush Tickets
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Hands out the next ticket of a backend. State mutex held.
+	 */
+	std::uint64_t NextFlushTicket(BackendState* state)
+	{
+		const std::uint64_t ticket = flushSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+		state->flushRequested = std::max(state->flushRequested, ticket);
+		state->wake.notify_one();
+		return ticket;
+	}
+
+	/**
+	 * @brief Records that every ticket up to sequence has completed.
+	 */
+	void MarkDurable(std::uint64_t sequence)
+	{
+		std::uint64_t current = durableSequence.load(std::memory_order_relaxed);
+		while (current < sequence
+			&& !durableSequence.compare_exchange_weak(current, sequence, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/**
+	 * @brief Takes the waiters whose ticket completed (all of them if all is set).
+	 *        State mutex held.
+	 */
+	std::vector<FlushWaiter> TakeFlushWaiters(BackendState* state, bool all)
+	{
+		std::vector<FlushWaiter> ready;
+		auto waiting = std::stable_partition(state->flushWaiters.begin(), state->flushWaiters.end(),
+			[state, all](const FlushWaiter& waiter) { return !all && waiter.sequence > state->flushCompleted; });
+		std::move(waiting, state->flushWaiters.end(), std::back_inserter(ready));
+		state->flushWaiters.erase(waiting, state->flushWaiters.end());
+		return ready;
+	}
+
+	/**
+	 * @brief Hands waiters back to their executors. No lock held.
+	 */
+	void ResumeFlushWaiters(std::vector<FlushWaiter>& waiters)
+	{
+		for (FlushWaiter& waiter : waiters)
+			waiter.resume(waiter.handle);
+	}
+
+	// -------------------------------------------------------------------------
+	// Notices
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Writes a logger notice to the currently active sinks (stderr if none).
+	 */
+	void ReportNotice(const std::string& notice)
+	{
+		EpochGuard guard;
+		const RELogger::LogRecord record { LogLevel::Warn, Now(),
+			"", 0, "", notice, notice };
+		DispatchRecord(LoadActiveSinks(), record);
+	}
+
+	/**
+	 * @brief Milliseconds elapsed since a steady clock point, as text.
+	 */
+	std::string MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+
+	// -------------------------------------------------------------------------
+	// Draining
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Consumer-side view of every queue for one drain pass.
+	 *
+	 * The sinks are copied out of the active set at the start of each pass,
+	 * so no EpochGuard is held while they run and a hung sink cannot hold
+	 * up Init, AddSink or Shutdown.
+	 */
+	struct DrainContext
+	{
+		BackendState* state = nullptr;      ///< Beacon target, or nullptr when unwatched.
+		std::vector<ThreadQueue*> queues;
+		SinkSet sinks;
+		bool hasSinks = false;
+		std::vector<RELogger::Sink*> direct;            ///< Sinks of the snapshot written on this thread.
+		std::vector<RELogger::ThreadedSink*> threaded;  ///< Sinks with their own writer thread.
+		std::shared_ptr<RELogger::RecordBatch> outgoing; ///< This pass's records for the threaded sinks.
+		bool abandoned = false;             ///< The backend was given up on inside a sink call.
+		bool recovered = false;             ///< A stalled sink call returned; resnapshot the sinks.
+		std::string args;
+		std::string context;
+		std::string message;
+		std::string text;
+		FormatPool* pool = nullptr;         ///< Formats batches when Config::formatThreads is set.
+		std::vector<std::unique_ptr<FormatBatch>> batches;
+		std::size_t submitted = 0;          ///< Batches handed to the pool and not yet written.
+		QueueProfile profile;               ///< Load seen during this run.
+		std::size_t budget = MinPassRecords; ///< Records the next pass may handle.
+		std::chrono::microseconds maxFlushDelay { 0 }; ///< Config::maxFlushDelay.
+		std::size_t unflushed = 0;          ///< Records written since the last flush.
+		bool holding = false;               ///< A direct sink kept output back at the last flush.
+		std::chrono::steady_clock::time_point unflushedSince; ///< When the oldest of them was written.
+	};
+
+	/**
+	 * @brief Copies the active sinks into the context and sorts them by
+	 *        who writes to them.
+	 */
+	void SnapshotSinks(DrainContext& context)
+	{
+		{
+			EpochGuard guard;
+			const SinkSet* sinks = LoadActiveSinks();
+			context.hasSinks = sinks != nullptr;
+			if (sinks)
+				context.sinks.sinks = sinks->sinks;
+			else
+				context.sinks.sinks.clear();
+		}
+
+		context.direct.clear();
+		context.threaded.clear();
+		for (const std::shared_ptr<RELogger::Sink>& sink : context.sinks.sinks)
+		{
+			if (auto* threaded = dynamic_cast<RELogger::ThreadedSink*>(sink.get()))
+				context.threaded.push_back(threaded);
+			else
+				context.direct.push_back(sink.get());
+		}
+	}
+
+	/**
+	 * @brief Marks the start of a sink call for the watchdog.
+	 */
+	void EnterSink(DrainContext& context, RELogger::Sink* sink)
+	{
+		if (context.state)
+			context.state->busySink.store(sink, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Marks the end of a sink call for the watchdog.
+	 * @return False if StopBackend abandoned the backend meanwhile; the
+	 *         caller must then return without touching the queues.
+	 */
+	bool LeaveSink(DrainContext& context, RELogger::Sink* sink)
+	{
+		BackendState* state = context.state;
+		if (!state)
+			return true;
+
+		RELogger::Sink* expected = sink;
+		if (!state->busySink.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+		{
+			context.abandoned = true;
+			return false;
+		}
+		state->sinkCalls.fetch_add(1, std::memory_order_release);
+
+		if (state->stalledSink.load(std::memory_order_acquire) == sink)
+		{
+			state->stalledSink.store(nullptr, std::memory_order_seq_cst);
+			backendStalled.store(false, std::memory_order_seq_cst);
+			context.recovered = true;
+			ReportNotice("[LOGGER WARNING] Stalled sink returned after "
+				+ MillisecondsSince(state->stallStart) + " ms; asynchronous logging resumed");
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Hands a record to every sink of the pass snapshot.
+	 * @return False if the backend was abandoned.
+	 */
+	bool WriteRecord(DrainContext& context, const RELogger::LogRecord& record)
+	{
+		if (!context.hasSinks)
+		{
+			DispatchRecord(nullptr, record);
+			return true;
+		}
+
+		CountRecord(record);
+
+		for (RELogger::Sink* sink : context.direct)
+		{
+			EnterSink(context, sink);
+			sink->Write(record);
+			if (!LeaveSink(context, sink))
+				return false;
+		}
+
+		if (!context.threaded.empty())
+		{
+			if (!context.outgoing)
+				context.outgoing = std::make_shared<RELogger::RecordBatch>();
+			context.outgoing->Add(record);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Routinely flushes the sinks written on this thread and posts
+	 *        the pass's records to the threaded ones, which flush on their own.
+	 * @return False if the backend was abandoned.
+	 */
+	bool FlushRecords(DrainContext& context)
+	{
+		context.holding = false;
+		for (RELogger::Sink* sink : context.direct)
+		{
+			EnterSink(context, sink);
+			const bool holding = sink->FlushPeriodic();
+			if (!LeaveSink(context, sink))
+				return false;
+			context.holding = context.holding || holding;
+		}
+
+		if (!context.outgoing)
+			return true;
+
+		const std::shared_ptr<const RELogger::RecordBatch> batch = std::move(context.outgoing);
+		for (RELogger::ThreadedSink* sink : context.threaded)
+		{
+			EnterSink(context, sink);
+			sink->Post(batch);
+			if (!LeaveSink(context, sink))
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Formats a queued record and hands it to the sinks.
+	 * @return False if the backend was abandoned.
+	 */
+	bool EmitRecord(DrainContext& context, const QueuedRecord& queued)
+	{
+		const std::chrono::system_clock::time_point time {
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(
+				std::chrono::nanoseconds(queued.timestamp)) };
+		std::string_view payload(queued.Payload(), queued.payloadSize);
+		std::string_view logContext(queued.Context(), queued.contextSize);
+		const LogLevel level = static_cast<LogLevel>(queued.level);
+		const char* file = InternedString(queued.fileId);
+		const char* func = InternedString(queued.funcId);
+		const char* format = InternedString(queued.formatId);
+		const char* category = InternedString(queued.categoryId);
+
+		if (context.state)
+		{
+			// A watched sink may outlive the queue slot if it hangs and the
+			// backend is abandoned, so it gets its own copy of the arguments.
+			if (format)
+			{
+				context.args.assign(payload);
+				payload = context.args;
+			}
+			context.context.assign(logContext);
+			logContext = context.context;
+		}
+
+		std::string_view message = payload;
+		if (format)
+		{
+			FormatArgs(context.message, format, payload);
+			message = context.message;
+		}
+
+		FormatRecordText(context.text, level, time, file, queued.line, func, message, logContext);
+
+		const RELogger::LogRecord record { level, time, file, queued.line,
+			func, message, context.text, format,
+			format ? payload : std::string_view(), category, logContext };
+		return WriteRecord(context, record);
+	}
+
+	// -------------------------------------------------------------------------
+	// Parallel Formatting
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Copies a record into the open batch, handing it to the pool once full.
+	 */
+	void BatchRecord(DrainContext& context, const QueuedRecord& record)
+	{
+		if (context.submitted == context.batches.size())
+			context.batches.push_back(std::make_unique<FormatBatch>());
+
+		FormatBatch& batch = *context.batches[context.submitted];
+		batch.Add(record);
+		if (batch.Full())
+		{
+			context.pool->Submit(&batch);
+			++context.submitted;
+		}
+	}
+
+	/**
+	 * @brief Submits the partly filled batch, then writes every submitted
+	 *        batch in the order it was built.
+	 * @return False if the backend was abandoned.
+	 */
+	bool WriteBatches(DrainContext& context)
+	{
+		if (context.submitted < context.batches.size() && !context.batches[context.submitted]->entries.empty())
+		{
+			context.pool->Submit(context.batches[context.submitted].get());
+			++context.submitted;
+		}
+
+		for (std::size_t i = 0; i < context.submitted; ++i)
+		{
+			FormatBatch& batch = *context.batches[i];
+			context.pool->Wait(&batch);
+			for (std::size_t j = 0; j < batch.entries.size(); ++j)
+			{
+				if (!WriteRecord(context, batch.Record(j)))
+					return false;
+			}
+			batch.Clear();
+		}
+		context.submitted = 0;
+		return true;
+	}
+
+	/**
+	 * @brief Reports records that producers dropped because their queue was full.
+	 * @return False if the backend was abandoned.
+	 */
+	bool ReportDrops(DrainContext& context)
+	{
+		std::uint64_t dropped = 0;
+		for (ThreadQueue* queue : context.queues)
+			dropped += queue->TakeDropped();
+
+		if (dropped == 0)
+			return true;
+		context.profile.dropped += dropped;
+
+		std::string notice = "[LOGGER WARNING] " + std::to_string(dropped)
+			+ " records dropped (queue full)";
+		const RELogger::LogRecord record { LogLevel::Warn, Now(),
+			"", 0, "", notice, notice };
+		return WriteRecord(context, record);
+	}
+
+	/**
+	 * @brief Decides whether a pass ends with a sink flush.
+	 *
+	 * Once the queues are (nearly) empty the output is flushed at once, so
+	 * a quiet program's lines show up immediately. During a burst the
+	 * written records are left in the sink buffers, up to maxFlushDelay or
+	 * MaxUnflushedRecords, and go out as large writes.
+	 */
+	bool ShouldFlush(const DrainContext& context, bool complete)
+	{
+		if (complete || context.maxFlushDelay.count() == 0 || context.unflushed >= MaxUnflushedRecords)
+			return true;
+		return std::chrono::steady_clock::now() - context.unflushedSince >= context.maxFlushDelay;
+	}
+
+	/**
+	 * @brief Drains what every queue held at the start of the pass.
+	 *
+	 * Queues are merged by timestamp so that lines from different threads
+	 * come out in the order they were logged.
+	 *
+	 * @param context Reusable pass state.
+	 * @param budget  Maximum number of records to handle.
+	 * @param complete Set to true if the pass emptied every snapshot.
+	 * @return Number of records written.
+	 */
+	std::size_t DrainPass(DrainContext& context, std::size_t budget, bool& complete)
+	{
+		context.queues.clear();
+		for (ThreadQueue* queue = FirstThreadQueue(); queue; queue = queue->next)
+		{
+			queue->BeginRead();
+			context.queues.push_back(queue);
+			context.profile.peakPending = std::max(context.profile.peakPending, queue->PendingBytes());
+		}
+		// Oldest queue first: on equal timestamps the merge keeps the first
+		// queue it saw, and a thread's older records sit in its older queue.
+		std::reverse(context.queues.begin(), context.queues.end());
+
+		SnapshotSinks(context);
+		context.recovered = false;
+
+		std::size_t processed = 0;
+		complete = false;
+		while (processed < budget && !context.recovered)
+		{
+			ThreadQueue* oldest = nullptr;
+			const QueuedRecord* oldestRecord = nullptr;
+			for (ThreadQueue* queue : context.queues)
+			{
+				const QueuedRecord* record = queue->Front();
+				if (record && (!oldestRecord || record->timestamp < oldestRecord->timestamp))
+				{
+					oldest = queue;
+					oldestRecord = record;
+				}
+			}
+
+			if (!oldestRecord)
+			{
+				complete = true;
+				break;
+			}
+
+			context.profile.CountEntry(oldestRecord->size);
+			if (context.pool)
+				BatchRecord(context, *oldestRecord);
+			else if (!EmitRecord(context, *oldestRecord))
+				return processed;
+			oldest->Pop();
+			++processed;
+		}
+
+		if (context.pool && !WriteBatches(context))
+			return processed;
+		context.profile.records += processed;
+		context.profile.peakPassRecords = std::max<std::uint64_t>(context.profile.peakPassRecords, processed);
+		if (!ReportDrops(context))
+			return processed;
+		// A sink holding output back is flushed again on idle passes
+		// until it lets go of it.
+		if (processed > 0 || context.outgoing || context.unflushed > 0 || context.holding)
+		{
+			if (context.unflushed == 0)
+				context.unflushedSince = std::chrono::steady_clock::now();
+			context.unflushed += processed;
+			if (ShouldFlush(context, complete))
+			{
+				FlushRecords(context);
+				context.unflushed = 0;
+			}
+		}
+
+		// A pass that could not empty the queues doubles the next budget;
+		// one that could halves it, so the backend checks for flush and
+		// stop requests often when idle and amortizes each pass in bursts.
+		context.budget = complete ? std::max(context.budget / 2, MinPassRecords)
+			: std::min(context.budget * 2, MaxPassRecords);
+
+		std::uint64_t pending = 0;
+		std::uint64_t capacity = 0;
+		for (ThreadQueue* queue : context.queues)
+		{
+			pending += queue->PendingBytes();
+			capacity += queue->Capacity();
+		}
+		SetQueueDepth(pending, capacity);
+		return processed;
+	}
+
+	/**
+	 * @brief Runs passes until everything visible at the call has been
+	 *        written, then fully flushes every sink.
+	 *
+	 * The passes only flush routinely, which lets a sink keep a partial
+	 * block; flush tickets are marked durable after this, so here each
+	 * sink gets a Flush.
+	 */
+	void DrainAll(DrainContext& context)
+	{
+		bool complete = false;
+		while (!complete && !context.abandoned)
+			DrainPass(context, context.budget, complete);
+
+		for (RELogger::Sink* sink : context.direct)
+		{
+			if (context.abandoned)
+				return;
+			EnterSink(context, sink);
+			sink->Flush();
+			LeaveSink(context, sink);
+		}
+		context.holding = false;
+
+		for (RELogger::ThreadedSink* sink : context.threaded)
+		{
+			if (context.abandoned)
+				return;
+			EnterSink(context, sink);
+			sink->Flush();
+			LeaveSink(context, sink);
+		}
+	}
+
+	// -------------------------------------------------------------------------
+	// Queue Sizing
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Sizes new queues from the profile of earlier runs, if any.
+	 *
+	 * Runs on the backend thread to keep file I/O out of Init; threads
+	 * that create their queue before it finishes start at queueCapacity.
+	 */
+	void LoadProfile(BackendState* state)
+	{
+		TakeQueueGrowths();
+		const std::string& path = state->config.queueProfilePath;
+		if (path.empty() || !LoadQueueProfile(path, state->earlierProfile))
+			return;
+
+		const std::size_t capacity = std::min(state->earlierProfile.SuggestedCapacity(), state->queueLimit);
+		state->queueCapacity.store(capacity, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Writes this run's load, blended with earlier runs.
+	 */
+	void SaveProfile(BackendState* state, DrainContext& context)
+	{
+		const std::string& path = state->config.queueProfilePath;
+		if (path.empty())
+			return;
+
+		QueueProfile profile = context.profile;
+		profile.growths = TakeQueueGrowths();
+		profile.Merge(state->earlierProfile);
+		if (!SaveQueueProfile(path, profile))
+			ReportNotice("[LOGGER WARNING] Could not write queue profile " + path);
+	}
+
+	/**
+	 * @brief Body of the backend thread.
+	 *
+	 * Opens the sinks first, so the cost of creating directories and touching
+	 * a slow disk never lands on the thread that called Init. Records logged
+	 * meanwhile simply wait in their queues.
+	 */
+	void BackendMain(BackendState* state)
+	{
+		onBackendThread = true;
+		LoadProfile(state);
+
+		DrainContext context;
+		context.state = state->watched ? state : nullptr;
+		context.maxFlushDelay = state->config.maxFlushDelay;
+		const std::chrono::microseconds maxIdleWait = state->config.backendPollInterval;
+		std::chrono::microseconds idleWait = std::min(MinIdleWait, maxIdleWait);
+		std::unique_ptr<FormatPool> pool;
+		if (state->config.formatThreads > 0)
+		{
+			pool = std::make_unique<FormatPool>(state->config.formatThreads);
+			context.pool = pool.get();
+		}
+		SnapshotSinks(context);
+
+		for (const std::shared_ptr<RELogger::Sink>& sink : context.sinks.sinks)
+		{
+			EnterSink(context, sink.get());
+			sink->Open();
+			if (!LeaveSink(context, sink.get()))
+				return;
+		}
+		ReplayEarlyRecords(context.hasSinks ? &context.sinks : nullptr);
+
+		if (!state->config.controlSocketPath.empty() && !state->control.Open(state->config.controlSocketPath))
+		{
+			ReportNotice("[LOGGER WARNING] Could not open control socket "
+				+ state->config.controlSocketPath);
+		}
+
+		for (;;)
+		{
+			std::uint64_t flushTicket;
+			bool stopping;
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				flushTicket = state->flushRequested;
+				stopping = state->stopRequested;
+			}
+
+			if (stopping)
+			{
+				DrainAll(context);
+				break;
+			}
+
+			if (flushTicket != state->flushCompleted)
+			{
+				DrainAll(context);
+				if (context.abandoned)
+					return;
+				std::unique_lock<std::mutex> lock(state->mutex);
+				state->flushCompleted = flushTicket;
+				MarkDurable(flushTicket);
+				state->flushed.notify_all();
+				std::vector<FlushWaiter> ready = TakeFlushWaiters(state, false);
+				lock.unlock();
+				ResumeFlushWaiters(ready);
+				continue;
+			}
+
+			state->control.Serve();
+
+			bool complete = false;
+			if (DrainPass(context, context.budget, complete) > 0 || context.recovered)
+			{
+				idleWait = std::min(MinIdleWait, maxIdleWait);
+				continue;
+			}
+			if (context.abandoned)
+				return;
+
+			// Records tend to arrive in clusters: poll again soon after
+			// activity, then back off to backendPollInterval.
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->wake.wait_for(lock, idleWait, [state]
+			{
+				return state->stopRequested || state->flushRequested != state->flushCompleted;
+			});
+			idleWait = std::min(idleWait * 2, maxIdleWait);
+		}
+
+		if (context.abandoned)
+			return;
+
+		state->control.Close();
+		SaveProfile(state, context);
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->flushCompleted = state->flushRequested;
+		MarkDurable(state->flushCompleted);
+		std::vector<FlushWaiter> ready = TakeFlushWaiters(state, true);
+		state->exited = true;
+		state->flushed.notify_all();
+		lock.unlock();
+
+		// The state may be gone from here on; only the local list is used.
+		ResumeFlushWaiters(ready);
+	}
+
+	// -------------------------------------------------------------------------
+	// Watchdog
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Swaps a hung sink out of the active set and lets producers
+	 *        bypass the backend until the call returns.
+	 * @return False if the control mutex was busy; try again next tick.
+	 */
+	bool FailOver(BackendState* state, RELogger::Sink* sink)
+	{
+		if (!TryReplaceSink(sink, state->config.stallFallback))
+			return false;
+
+		backendStalled.store(true, std::memory_order_seq_cst);
+		if (state->stalledSink.load(std::memory_order_seq_cst) != sink)
+		{
+			// The call returned while the set was being swapped.
+			backendStalled.store(false, std::memory_order_seq_cst);
+		}
+		ReportNotice("[LOGGER WARNING] A sink made no progress for "
+			+ MillisecondsSince(state->stallStart) + " ms; "
+			+ (state->config.stallFallback ? "switched to the fallback sink" : "sink disabled"));
+		return true;
+	}
+
+	/**
+	 * @brief Body of the watchdog thread.
+	 *
+	 * Samples the backend's sink beacon a few times per timeout. A sink call
+	 * that has not finished after sinkStallTimeout is declared hung: waiters
+	 * in FlushBackend and StopBackend are woken and the sink is failed over.
+	 */
+	void WatchdogMain(BackendState* state)
+	{
+		const std::chrono::milliseconds timeout = state->config.sinkStallTimeout;
+		const std::chrono::milliseconds tick = std::max(timeout / 4, std::chrono::milliseconds(1));
+
+		RELogger::Sink* lastSink = nullptr;
+		std::uint64_t lastCalls = 0;
+		std::chrono::steady_clock::time_point since = std::chrono::steady_clock::now();
+		bool failedOver = false;
+
+		std::unique_lock<std::mutex> lock(state->mutex);
+		while (!state->watchdogWake.wait_for(lock, tick, [state] { return state->stopWatchdog; }))
+		{
+			RELogger::Sink* sink = state->busySink.load(std::memory_order_acquire);
+			const std::uint64_t calls = state->sinkCalls.load(std::memory_order_acquire);
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+			if (!sink || sink != lastSink || calls != lastCalls)
+			{
+				lastSink = sink;
+				lastCalls = calls;
+				since = now;
+				failedOver = false;
+				continue;
+			}
+
+			if (now - since < timeout || failedOver)
+				continue;
+
+			std::vector<FlushWaiter> ready;
+			if (!state->stalledSink.load(std::memory_order_acquire))
+			{
+				state->stallStart = since;
+				state->stalledSink.store(sink, std::memory_order_release);
+				state->flushed.notify_all();
+				ready = TakeFlushWaiters(state, true);
+			}
+
+			lock.unlock();
+			ResumeFlushWaiters(ready);
+			failedOver = FailOver(state, sink);
+			lock.lock();
+		}
+	}
+}
+
+// ============================================================================
+//                           BACKEND CONTROL
+// ============================================================================
+
+/**
+ * @brief Starts the backend thread and switches producers to queueing.
+ * @param config Options chosen at Init.
+ */
+void RELogger::Internal::StartBackend(const Config& config)
+{
+	BackendState* state = new BackendState();
+	state->config = config;
+	state->watched = config.sinkStallTimeout.count() > 0;
+	state->queueCapacity.store(config.queueCapacity, std::memory_order_relaxed);
+	state->queueLimit = std::max(config.queueCapacityLimit, config.queueCapacity);
+	state->flushRequested = flushSequence.load(std::memory_order_relaxed);
+	state->flushCompleted = state->flushRequested;
+
+	backend = state;
+	backendStalled.store(false, std::memory_order_seq_cst);
+	backendActive.store(true, std::memory_order_seq_cst);
+	state->thread = std::thread(BackendMain, state);
+	if (state->watched)
+		state->watchdog = std::thread(WatchdogMain, state);
+}
+
+/**
+ * @brief Stops accepting queued records, drains what is left and joins.
+ *
+ * Producers that already saw the backend as active are waited for, so no
+ * record can be left behind in a queue nobody reads. If the backend is
+ * stuck in a sink call the watchdog has declared hung, it is abandoned
+ * instead: the sink is taken out of the set, the thread detached (its
+ * state is leaked on purpose) and the queues drained on this thread.
+ */
+void RELogger::Internal::StopBackend()
+{
+	BackendState* state = backend;
+	if (!state)
+		return;
+
+	backendActive.store(false, std::memory_order_seq_cst);
+	SynchronizeReaders();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->stopRequested = true;
+	state->wake.notify_one();
+
+	bool abandoned = false;
+	if (state->watched)
+	{
+		state->flushed.wait(lock, [state] { return state->exited || state->stalledSink.load() != nullptr; });
+		RELogger::Sink* stalled = state->stalledSink.load(std::memory_order_acquire);
+		if (!state->exited && stalled)
+		{
+			RELogger::Sink* expected = stalled;
+			abandoned = state->busySink.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+		}
+		if (!abandoned)
+			state->flushed.wait(lock, [state] { return state->exited; });
+
+		state->stopWatchdog = true;
+		state->watchdogWake.notify_one();
+	}
+	lock.unlock();
+
+	if (state->watched)
+		state->watchdog.join();
+
+	backend = nullptr;
+	backendStalled.store(false, std::memory_order_seq_cst);
+
+	if (!abandoned)
+	{
+		state->thread.join();
+		delete state;
+		return;
+	}
+
+	// The hung call may still return and touch the sink or the state, so
+	// both stay alive; from here on the thread exits without further work.
+	RELogger::Sink* stalled = state->stalledSink.load(std::memory_order_acquire);
+	ReplaceSinkLocked(stalled, state->config.stallFallback);
+	state->thread.detach();
+	ReportNotice("[LOGGER WARNING] Backend abandoned in a hung sink after "
+		+ MillisecondsSince(state->stallStart) + " ms at shutdown");
+
+	DrainContext context;
+	DrainAll(context);
+
+	lock.lock();
+	MarkDurable(state->flushRequested);
+	std::vector<FlushWaiter> ready = TakeFlushWaiters(state, true);
+	lock.unlock();
+	ResumeFlushWaiters(ready);
+}
+
+/**
+ * @brief Reports whether producers should hand records to the backend.
+ */
+bool RELogger::Internal::IsBackendActive()
+{
+	return backendActive.load(std::memory_order_seq_cst) && !backendStalled.load(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Reports whether the caller is the backend thread.
+ */
+bool RELogger::Internal::IsBackendThread()
+{
+	return onBackendThread;
+}
+
+/**
+ * @brief Copies a record into the calling thread's queue.
+ *
+ * Payloads too large for the ring are truncated (encoded arguments are
+ * rendered to text first so they are cut cleanly). A full queue is first
+ * replaced by a larger one, up to Config::queueCapacityLimit; after that
+ * the configured policy decides between waiting for the backend and
+ * dropping.
+ */
+void RELogger::Internal::EnqueueRecord(LogLevel level, std::chrono::system_clock::time_point time,
+									   const char* file, int line, const char* func,
+									   const char* category, const char* format, std::string_view payload,
+									   std::string_view context)
+{
+	const Config& config = backend->config;
+
+	ThreadQueue* queue = AcquireThreadQueue(backend->queueCapacity.load(std::memory_order_relaxed));
+	if (context.size() > MaxContextSize)
+		context = context.substr(0, MaxContextSize);
+	const std::size_t maxPayload = queue ? queue->Capacity() / 2 - sizeof(QueuedRecord) - context.size() : 0;
+
+	std::string formatted;
+	if (format && (!queue || payload.size() > maxPayload))
+	{
+		FormatArgs(formatted, format, payload);
+		payload = formatted;
+		format = nullptr;
+	}
+
+	if (!queue)
+	{
+		// Thread is tearing down its thread-locals; write inline instead.
+		std::string text;
+		FormatRecordText(text, level, time, file, line, func, payload, context);
+		DispatchRecord(LoadActiveSinks(), LogRecord { level, time, file, line, func, payload, text,
+			nullptr, {}, category, context });
+		return;
+	}
+
+	if (payload.size() > maxPayload)
+		payload = payload.substr(0, maxPayload);
+
+	const std::size_t size = QueueEntrySize(payload.size(), context.size());
+	std::byte* slot = queue->Reserve(size);
+	while (!slot)
+	{
+		if (ThreadQueue* grown = GrowThreadQueue(backend->queueLimit))
+		{
+			queue = grown;
+			slot = queue->Reserve(size);
+			continue;
+		}
+		if (config.queueFullPolicy == QueueFullPolicy::Drop)
+		{
+			queue->CountDrop();
+			CountDrop(level, file, line, category);
+			return;
+		}
+		std::this_thread::yield();
+		slot = queue->Reserve(size);
+	}
+
+	QueuedRecord* record = new (slot) QueuedRecord {
+		static_cast<std::uint32_t>(size),
+		static_cast<std::uint32_t>(payload.size()),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(),
+		InternString(file), InternString(func), InternString(format), InternString(category), line,
+		static_cast<std::uint16_t>(context.size()), static_cast<std::uint8_t>(level) };
+	std::memcpy(record + 1, payload.data(), payload.size());
+	std::memcpy(reinterpret_cast<char*>(record + 1) + payload.size(), context.data(), context.size());
+
+	queue->Commit();
+}
+
+/**
+ * @brief Copies prepared entries into the calling thread's queue.
+ *
+ * Everything reserved is published by one Commit at the end. When the
+ * ring fills up, the entries copied so far are committed first, so the
+ * backend can make room. An entry too large for this ring goes through
+ * EnqueueRecord, which may grow the queue or truncate the entry; the
+ * thread's queue is looked up again afterwards.
+ */
+void RELogger::Internal::EnqueueRecords(const std::byte* records, std::size_t size)
+{
+	const Config& config = backend->config;
+	ThreadQueue* queue = AcquireThreadQueue(backend->queueCapacity.load(std::memory_order_relaxed));
+
+	for (std::size_t offset = 0; offset < size;)
+	{
+		const QueuedRecord& record = *reinterpret_cast<const QueuedRecord*>(records + offset);
+		offset += record.size;
+
+		if (!queue || record.size > queue->Capacity() / 2)
+		{
+			if (queue)
+				queue->Commit();
+			const std::chrono::system_clock::time_point time {
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(
+					std::chrono::nanoseconds(record.timestamp)) };
+			EnqueueRecord(static_cast<LogLevel>(record.level), time, InternedString(record.fileId), record.line,
+				InternedString(record.funcId), InternedString(record.categoryId), InternedString(record.formatId),
+				std::string_view(record.Payload(), record.payloadSize), std::string_view(record.Context(), record.contextSize));
+
+			// EnqueueRecord may have grown the queue, handing the old ring back.
+			queue = AcquireThreadQueue(backend->queueCapacity.load(std::memory_order_relaxed));
+			continue;
+		}
+
+		std::byte* slot = queue->Reserve(record.size);
+		if (!slot)
+		{
+			queue->Commit();
+			while (!slot)
+			{
+				if (ThreadQueue* grown = GrowThreadQueue(backend->queueLimit))
+				{
+					queue = grown;
+					slot = queue->Reserve(record.size);
+					continue;
+				}
+				if (config.queueFullPolicy == QueueFullPolicy::Drop)
+					break;
+				std::this_thread::yield();
+				slot = queue->Reserve(record.size);
+			}
+			if (!slot)
+			{
+				queue->CountDrop();
+				CountDrop(static_cast<LogLevel>(record.level), InternedString(record.fileId), record.line,
+					InternedString(record.categoryId));
+				continue;
+			}
+		}
+		std::memcpy(slot, &record, record.size);
+	}
+
+	if (queue)
+		queue->Commit();
+}
+
+/**
+ * @brief Blocks until the backend has written and flushed every record
+ *        committed before the call, or until the watchdog finds it hung.
+ */
+void RELogger::Internal::FlushBackend()
+{
+	BackendState* state = backend;
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	const std::uint64_t ticket = NextFlushTicket(state);
+	state->flushed.wait(lock, [state, ticket]
+	{
+		return state->flushCompleted >= ticket || state->stalledSink.load() != nullptr;
+	});
+}
+
+/**
+ * @brief Starts a flush of everything committed so far.
+ *
+ * With a backend (also when called on it, or while it is stalled) this
+ * only queues the ticket. In synchronous mode the sinks are flushed right
+ * here.
+ */
+std::uint64_t RELogger::Internal::RequestFlushSequence()
+{
+	if (backendActive.load(std::memory_order_seq_cst))
+	{
+		BackendState* state = backend;
+		std::lock_guard<std::mutex> lock(state->mutex);
+		return NextFlushTicket(state);
+	}
+
+	const std::uint64_t ticket = flushSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+	FlushSinks(LoadActiveSinks());
+	MarkDurable(ticket);
+	return ticket;
+}
+
+/**
+ * @brief Reports whether a flush ticket has completed.
+ */
+bool RELogger::Internal::IsFlushSequenceDone(std::uint64_t sequence)
+{
+	return durableSequence.load(std::memory_order_acquire) >= sequence;
+}
+
+/**
+ * @brief Parks a coroutine until its ticket completes.
+ * @return False if it need not wait: the ticket completed, the backend is
+ *         stalled, or there is no backend left to complete it.
+ */
+bool RELogger::Internal::AwaitFlushSequence(std::uint64_t sequence, std::coroutine_handle<> handle,
+											const Resumer& resume)
+{
+	if (!IsBackendActive())
+		return false;
+
+	BackendState* state = backend;
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (state->flushCompleted >= sequence || state->stalledSink.load(std::memory_order_acquire))
+		return false;
+
+	state->flushWaiters.push_back(FlushWaiter { sequence, handle, resume });
+	return true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file relogger_batch.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Record batches published with a single queue commit.
+ *
+ * Add builds each entry in the layout of relogger_queue.h, with site
+ * strings already interned, so publishing a batch is one copy per entry
+ * and one release store for all of them.
+ */
+
+#include "relogger_batch.h"
+#include "relogger_intern.h"
+#include "relogger_internal.h"
+#include "relogger_queue.h"
+#include "relogger_stack.h"
+
+#include <cstring>
+#include <new>
+
+RELogger::LogBatch::~LogBatch()
+{
+	Submit();
+}
+
+void RELogger::LogBatch::Add(LogLevel level, std::string_view message, const char* file, int line, const char* func)
+{
+#ifndef NDEBUG // Logging disabled in release builds unless explicitly enabled
+	if (!Internal::IsLogEnabled(level, file, line, nullptr))
+		return;
+
+	Append(level, file, line, func, nullptr, nullptr, message, RELOGGER_RETURN_ADDRESS());
+#endif
+}
+
+/**
+ * @brief Stamps a record and appends it as a queue entry.
+ * @param caller Where a captured stack starts; nullptr for the caller of
+ *        Append (AddFormat is inlined into the logging function).
+ */
+void RELogger::LogBatch::Append(LogLevel level, const char* file, int line, const char* func,
+								const char* category, const char* format, std::string_view payload,
+								const void* caller)
+{
+	using namespace Internal;
+
+	const std::uint64_t start = BeginLogOverhead();
+
+	std::chrono::system_clock::time_point now;
+	{
+		EpochGuard guard;
+		now = Now();
+	}
+	const LogContext* logContext = CurrentLogContext();
+	std::string_view context = AttachStack(level, logContext ? logContext->Fields() : std::string_view(),
+		caller ? caller : RELOGGER_RETURN_ADDRESS());
+	if (context.size() > MaxContextSize)
+		context = context.substr(0, MaxContextSize);
+
+	const std::size_t size = QueueEntrySize(payload.size(), context.size());
+	const std::size_t offset = records.size();
+	records.resize(offset + size);
+
+	QueuedRecord* record = new (records.data() + offset) QueuedRecord {
+		static_cast<std::uint32_t>(size),
+		static_cast<std::uint32_t>(payload.size()),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(),
+		InternString(file), InternString(func), InternString(format), InternString(category), line,
+		static_cast<std::uint16_t>(context.size()), static_cast<std::uint8_t>(level) };
+	std::memcpy(record + 1, payload.data(), payload.size());
+	std::memcpy(reinterpret_cast<char*>(record + 1) + payload.size(), context.data(), context.size());
+
+	++count;
+	fatal = fatal || level == LogLevel::Fatal;
+
+	EndLogOverhead(start);
+}
+
+/**
+ * @brief Publishes the batch: one commit in asynchronous mode, the
+ *        per-record path otherwise.
+ */
+void RELogger::LogBatch::Submit()
+{
+	using namespace Internal;
+
+	if (count == 0)
+		return;
+
+	const std::uint64_t start = BeginLogOverhead();
+	{
+		EpochGuard guard;
+		if (IsBackendActive() && !IsBackendThread())
+		{
+			EnqueueRecords(records.data(), records.size());
+			if (fatal)
+				FlushBackend();
+		}
+		else
+		{
+			for (std::size_t offset = 0; offset < records.size();)
+			{
+				const QueuedRecord& record = *reinterpret_cast<const QueuedRecord*>(records.data() + offset);
+				offset += record.size;
+
+				const std::chrono::system_clock::time_point time {
+					std::chrono::duration_cast<std::chrono::system_clock::duration>(
+						std::chrono::nanoseconds(record.timestamp)) };
+				DeliverRecord(static_cast<LogLevel>(record.level), time, InternedString(record.fileId), record.line,
+					InternedString(record.funcId), InternedString(record.categoryId), InternedString(record.formatId),
+					std::string_view(record.Payload(), record.payloadSize),
+					std::string_view(record.Context(), record.contextSize));
+			}
+		}
+	}
+	EndLogOverhead(start);
+
+	Clear();
+}
+
+void RELogger::LogBatch::Clear()
+{
+	records.clear();
+	count = 0;
+	fatal = false;
+}
@@ -0,0 +1,146 @@
+/*
+===============================================================================
+
+  RELogger - Record Batches (C++ Header)
+  --------------------------------------
+
+  Collects records that are produced together (e.g. every event of a
+  network tick) and publishes them at once. Each Add does the level
+  check and takes the record's time and context, like a RELOG_* call;
+  Submit then takes the epoch guard and the thread queue once and makes
+  the whole batch visible to the backend with a single commit.
+
+  Example:
+      RELogger::LogBatch batch;
+      for (const Event& event : tick.events)
+          RELOG_BATCH_LOGF(batch, LogLevel::Debug, "peer {} sent {} bytes", event.peer, event.bytes);
+      batch.Submit();
+
+  Records keep the time they were added, and the backend still merges
+  them with other threads by that time. In synchronous mode, before
+  Init and after Shutdown, Submit hands them on one by one as RELOG_*
+  would have. A batch belongs to the thread that fills it; Submit
+  empties it for reuse, and the destructor submits what is left.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_BATCH_H
+#define RELOGGER_BATCH_H
+
+#include "relogger.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      CLASS: LogBatch
+      ---------------------------------------------------------------------
+      Records laid out exactly as the asynchronous queues store them,
+      waiting for Submit.
+    =======================================================================
+    */
+    class LogBatch
+    {
+    public:
+        LogBatch() = default;
+        ~LogBatch();
+
+        LogBatch(const LogBatch&) = delete;
+        LogBatch& operator=(const LogBatch&) = delete;
+
+        /*
+        ===================================================================
+          FUNCTION: Add
+          -----------------------------------------------------------------
+          Adds a plain message, like RELogger::Log.
+        ===================================================================
+        */
+        void Add(LogLevel level, std::string_view message, const char* file, int line, const char* func);
+
+        /*
+        ===================================================================
+          FUNCTION: AddFormat
+          -----------------------------------------------------------------
+          Adds a RELOG_*F style record; only the arguments are encoded.
+        ===================================================================
+        */
+        template <typename... Args>
+        void AddFormat(const LogSite& site, const Args&... args)
+        {
+#ifndef NDEBUG
+            if (!Internal::IsLogEnabled(site.level, site.file, site.line, site.category))
+                return;
+
+            Internal::EncodeArgs([&](std::string_view blob)
+            {
+                Append(site.level, site.file, site.line, site.func, site.category, site.format, blob, nullptr);
+            }, args...);
+#endif
+        }
+
+        /*
+        ===================================================================
+          FUNCTION: Submit
+          -----------------------------------------------------------------
+          Publishes every record added so far and empties the batch. A
+          Fatal record in the batch makes Submit wait until it has been
+          written, like RELOG_FATAL.
+        ===================================================================
+        */
+        void Submit();
+
+        void Clear();
+        std::size_t Size() const { return count; }
+        bool Empty() const { return count == 0; }
+
+    private:
+        void Append(LogLevel level, const char* file, int line, const char* func,
+                    const char* category, const char* format, std::string_view payload, const void* caller);
+
+        std::vector<std::byte> records;  ///< QueuedRecord entries back to back.
+        std::size_t count = 0;
+        bool fatal = false;              ///< A Fatal record was added.
+    };
+}
+
+/*
+===============================================================================
+  MACRO DEFINITIONS
+===============================================================================
+*/
+
+#define RELOG_BATCH_LOG(batch, level, msg) (batch).Add(level, msg, __FILE__, __LINE__, __func__)
+
+#define RELOG_BATCH_LOGF(batch, level, fmt, ...)                                            \
+    do                                                                                      \
+    {                                                                                       \
+        static constexpr RELogger::LogSite reloggerSite { level, __FILE__, __LINE__, __func__, fmt }; \
+        RELOGGER_SITE_ENTRY(reloggerSite);                                                  \
+        (batch).AddFormat(reloggerSite __VA_OPT__(,) __VA_ARGS__);                          \
+    } while (0)
+
+#define RELOG_BATCH_CATEGORY_LOGF(batch, category, level, fmt, ...)                         \
+    do                                                                                      \
+    {                                                                                       \
+        static constexpr RELogger::LogSite reloggerSite { level, __FILE__, __LINE__, __func__, fmt, category }; \
+        RELOGGER_SITE_ENTRY(reloggerSite);                                                  \
+        (batch).AddFormat(reloggerSite __VA_OPT__(,) __VA_ARGS__);                          \
+    } while (0)
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_BATCH_H */
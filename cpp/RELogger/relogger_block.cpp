@@ -0,0 +1,309 @@
+/**
+ * @file relogger_block.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Encoding and decoding of block-compressed log files.
+ */
+
+#include "relogger_block.h"
+#include "relogger_lz.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace
+{
+	using RELogger::LogBlockInfo;
+
+	constexpr char BlockMagic[4] = { 'R', 'E', 'L', 'B' };
+	constexpr char IndexMagic[8] = { 'R', 'E', 'L', 'B', 'I', 'D', 'X', '1' };
+	constexpr std::uint8_t BlockVersion = 1;
+	constexpr std::uint32_t StoredRawFlag = 0x80000000u;  ///< storedSize bit for uncompressed data.
+	constexpr std::uint32_t IndexFlag = 0x40000000u;      ///< storedSize bit for the index block.
+	constexpr std::uint32_t StoredSizeMask = IndexFlag - 1;
+	constexpr std::size_t IndexEntrySize = 32;            ///< Bytes per block in the index.
+	constexpr std::size_t IndexFooterSize = 16;           ///< Index offset plus magic.
+
+	// -------------------------------------------------------------------------
+	// Little-Endian Helpers
+	// -------------------------------------------------------------------------
+
+	void PutLE(char* out, std::uint64_t value, std::size_t bytes)
+	{
+		for (std::size_t i = 0; i < bytes; ++i)
+			out[i] = static_cast<char>(value >> (8 * i));
+	}
+
+	void AppendLE(std::string& out, std::uint64_t value, std::size_t bytes)
+	{
+		for (std::size_t i = 0; i < bytes; ++i)
+			out += static_cast<char>(value >> (8 * i));
+	}
+
+	std::uint64_t GetLE(const char* in, std::size_t bytes)
+	{
+		std::uint64_t value = 0;
+		for (std::size_t i = 0; i < bytes; ++i)
+			value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in[i])) << (8 * i);
+		return value;
+	}
+
+	/**
+	 * @brief Fills the size fields of a block description from a stored size word.
+	 */
+	void SetStoredField(LogBlockInfo& info, std::uint32_t storedField)
+	{
+		info.storedSize = storedField & StoredSizeMask;
+		info.compressed = (storedField & StoredRawFlag) == 0;
+		info.index = (storedField & IndexFlag) != 0;
+	}
+
+	std::uint32_t StoredField(const LogBlockInfo& info)
+	{
+		return info.storedSize | (info.compressed ? 0 : StoredRawFlag) | (info.index ? IndexFlag : 0);
+	}
+
+	/**
+	 * @brief Loads the trailing index of a cleanly closed file.
+	 * @return False if the file has no (valid) index.
+	 */
+	bool ReadTrailingIndex(std::istream& in, std::vector<LogBlockInfo>& blocks)
+	{
+		in.clear();
+		in.seekg(0, std::ios::end);
+		const std::istream::pos_type end = in.tellg();
+		if (end == std::istream::pos_type(-1) ||
+			static_cast<std::uint64_t>(end) < RELogger::Internal::BlockLogHeaderSize + RELogger::Internal::LogBlockHeaderSize + IndexFooterSize)
+		{
+			return false;
+		}
+
+		char footer[IndexFooterSize];
+		in.seekg(static_cast<std::uint64_t>(end) - IndexFooterSize);
+		if (!in.read(footer, sizeof(footer)) || !std::equal(IndexMagic, IndexMagic + sizeof(IndexMagic), footer + 8))
+			return false;
+
+		const std::uint64_t indexOffset = GetLE(footer, 8);
+		in.seekg(static_cast<std::streamoff>(indexOffset));
+		LogBlockInfo header;
+		if (!RELogger::ReadLogBlockHeader(in, header) || !header.index || header.storedSize < IndexFooterSize ||
+			indexOffset + RELogger::Internal::LogBlockHeaderSize + header.storedSize != static_cast<std::uint64_t>(end) ||
+			(header.storedSize - IndexFooterSize) % IndexEntrySize != 0)
+		{
+			return false;
+		}
+
+		std::string data(header.storedSize - IndexFooterSize, '\0');
+		if (!in.read(data.data(), static_cast<std::streamsize>(data.size())))
+			return false;
+
+		blocks.clear();
+		blocks.reserve(data.size() / IndexEntrySize);
+		for (std::size_t pos = 0; pos < data.size(); pos += IndexEntrySize)
+		{
+			LogBlockInfo info;
+			info.offset = GetLE(&data[pos], 8);
+			info.rawSize = static_cast<std::uint32_t>(GetLE(&data[pos + 8], 4));
+			SetStoredField(info, static_cast<std::uint32_t>(GetLE(&data[pos + 12], 4)));
+			info.firstTime = static_cast<std::int64_t>(GetLE(&data[pos + 16], 8));
+			info.lastTime = static_cast<std::int64_t>(GetLE(&data[pos + 24], 8));
+			blocks.push_back(info);
+		}
+		return true;
+	}
+}
+
+// ============================================================================
+//                                 WRITING
+// ============================================================================
+
+/**
+ * @brief Appends the magic and version that start every block log.
+ */
+void RELogger::Internal::AppendBlockLogHeader(std::string& out)
+{
+	out.append(BlockMagic, sizeof(BlockMagic));
+	out += static_cast<char>(BlockVersion);
+}
+
+/**
+ * @brief Compresses one block of text and appends it with its header.
+ * @param out Destination buffer.
+ * @param text Whole lines, at most 1 GiB.
+ * @param firstTime Earliest timestamp of the block's records.
+ * @param lastTime Latest timestamp of the block's records.
+ * @return The block's header fields.
+ */
+RELogger::LogBlockInfo RELogger::Internal::AppendLogBlock(std::string& out, std::string_view text,
+														  std::int64_t firstTime, std::int64_t lastTime)
+{
+	const std::size_t headerPos = out.size();
+	out.resize(headerPos + LogBlockHeaderSize);
+
+	LogBlockInfo info;
+	info.rawSize = static_cast<std::uint32_t>(text.size());
+	info.firstTime = firstTime;
+	info.lastTime = lastTime;
+	info.compressed = true;
+
+	LzCompress(text, out);
+	if (out.size() - headerPos - LogBlockHeaderSize >= text.size())
+	{
+		out.resize(headerPos + LogBlockHeaderSize);
+		out.append(text);
+		info.compressed = false;
+	}
+	info.storedSize = static_cast<std::uint32_t>(out.size() - headerPos - LogBlockHeaderSize);
+
+	char* header = out.data() + headerPos;
+	PutLE(header, info.rawSize, 4);
+	PutLE(header + 4, StoredField(info), 4);
+	PutLE(header + 8, static_cast<std::uint64_t>(firstTime), 8);
+	PutLE(header + 16, static_cast<std::uint64_t>(lastTime), 8);
+	return info;
+}
+
+/**
+ * @brief Appends the index block that closes a file.
+ * @param out Destination buffer.
+ * @param blocks Every text block written, in order.
+ * @param indexOffset File offset at which the index block begins.
+ */
+void RELogger::Internal::AppendLogBlockIndex(std::string& out, const std::vector<LogBlockInfo>& blocks,
+											 std::uint64_t indexOffset)
+{
+	std::int64_t firstTime = blocks.empty() ? 0 : blocks.front().firstTime;
+	std::int64_t lastTime = blocks.empty() ? 0 : blocks.front().lastTime;
+	for (const LogBlockInfo& block : blocks)
+	{
+		firstTime = std::min(firstTime, block.firstTime);
+		lastTime = std::max(lastTime, block.lastTime);
+	}
+
+	const std::uint32_t storedSize = static_cast<std::uint32_t>(blocks.size() * IndexEntrySize + IndexFooterSize);
+	AppendLE(out, 0, 4);
+	AppendLE(out, storedSize | IndexFlag | StoredRawFlag, 4);
+	AppendLE(out, static_cast<std::uint64_t>(firstTime), 8);
+	AppendLE(out, static_cast<std::uint64_t>(lastTime), 8);
+
+	for (const LogBlockInfo& block : blocks)
+	{
+		AppendLE(out, block.offset, 8);
+		AppendLE(out, block.rawSize, 4);
+		AppendLE(out, StoredField(block), 4);
+		AppendLE(out, static_cast<std::uint64_t>(block.firstTime), 8);
+		AppendLE(out, static_cast<std::uint64_t>(block.lastTime), 8);
+	}
+
+	AppendLE(out, indexOffset, 8);
+	out.append(IndexMagic, sizeof(IndexMagic));
+}
+
+// ============================================================================
+//                                 READING
+// ============================================================================
+
+/**
+ * @brief Checks the magic and version at the start of a block log.
+ */
+bool RELogger::ReadBlockLogHeader(std::istream& in)
+{
+	char header[Internal::BlockLogHeaderSize];
+	if (!in.read(header, sizeof(header)))
+		return false;
+	return std::equal(BlockMagic, BlockMagic + sizeof(BlockMagic), header)
+		&& static_cast<std::uint8_t>(header[4]) == BlockVersion;
+}
+
+/**
+ * @brief Reads the header of the next block.
+ */
+bool RELogger::ReadLogBlockHeader(std::istream& in, LogBlockInfo& info)
+{
+	const std::istream::pos_type offset = in.tellg();
+	char header[Internal::LogBlockHeaderSize];
+	if (!in.read(header, sizeof(header)))
+		return false;
+
+	info.offset = offset == std::istream::pos_type(-1) ? 0 : static_cast<std::uint64_t>(offset);
+	info.rawSize = static_cast<std::uint32_t>(GetLE(header, 4));
+	SetStoredField(info, static_cast<std::uint32_t>(GetLE(header + 4, 4)));
+	info.firstTime = static_cast<std::int64_t>(GetLE(header + 8, 8));
+	info.lastTime = static_cast<std::int64_t>(GetLE(header + 16, 8));
+	return info.index ? info.rawSize == 0 : (info.compressed || info.storedSize == info.rawSize);
+}
+
+/**
+ * @brief Reads and decodes the data of the block whose header was just read.
+ */
+bool RELogger::ReadLogBlockText(std::istream& in, const LogBlockInfo& info, std::string& text)
+{
+	if (info.index)
+	{
+		text.clear();
+		return static_cast<bool>(in.seekg(info.storedSize, std::ios::cur));
+	}
+
+	if (!info.compressed)
+	{
+		text.resize(info.storedSize);
+		return static_cast<bool>(in.read(text.data(), info.storedSize));
+	}
+
+	std::string stored(info.storedSize, '\0');
+	if (!in.read(stored.data(), info.storedSize))
+		return false;
+	return Internal::LzDecompress(stored, info.rawSize, text);
+}
+
+/**
+ * @brief Decodes every block of a block log in order.
+ */
+bool RELogger::DecodeBlockLog(std::istream& in, std::ostream& out)
+{
+	if (!ReadBlockLogHeader(in))
+		return false;
+
+	LogBlockInfo info;
+	std::string text;
+	while (in.peek() != std::char_traits<char>::eof())
+	{
+		if (!ReadLogBlockHeader(in, info) || !ReadLogBlockText(in, info, text))
+			return false;
+		out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	}
+	return true;
+}
+
+/**
+ * @brief Lists the text blocks of a file from its index or its headers.
+ */
+bool RELogger::ReadLogBlockIndex(std::istream& in, std::vector<LogBlockInfo>& blocks)
+{
+	in.clear();
+	in.seekg(0);
+	if (!ReadBlockLogHeader(in))
+		return false;
+
+	if (ReadTrailingIndex(in, blocks))
+		return true;
+
+	// No index: walk the headers, ignoring a block cut short by a crash.
+	blocks.clear();
+	in.clear();
+	in.seekg(0, std::ios::end);
+	const std::uint64_t end = static_cast<std::uint64_t>(in.tellg());
+	in.seekg(static_cast<std::streamoff>(Internal::BlockLogHeaderSize));
+
+	LogBlockInfo info;
+	while (ReadLogBlockHeader(in, info) && !info.index &&
+		   info.offset + Internal::LogBlockHeaderSize + info.storedSize <= end)
+	{
+		blocks.push_back(info);
+		in.seekg(info.storedSize, std::ios::cur);
+	}
+	in.clear();
+	return true;
+}
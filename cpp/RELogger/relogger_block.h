@@ -0,0 +1,163 @@
+/*
+===============================================================================
+
+  RELogger - Block-Compressed Log Files (C++ Header)
+  --------------------------------------------------
+
+  Layout of the files FileSink writes when FileSinkOptions::compressBlocks
+  is set, and functions to read them back. The text is the same as an
+  ordinary log file; it is just cut into blocks (about 64 KB each) and
+  every block is compressed on its own, so a reader can jump to any
+  block without decoding the ones before it.
+
+  File layout (all integers little-endian):
+      magic "RELB", u8 version (1)
+      blocks, each:
+        u32 rawSize     : bytes of text in the block
+        u32 storedSize  : bytes that follow; bit 31 set means the text
+                          is stored uncompressed, bit 30 marks the index
+        i64 firstTime   : earliest record timestamp (ns since epoch)
+        i64 lastTime    : latest record timestamp (ns since epoch)
+        storedSize bytes: relogger_lz.h encoded text (or the raw text)
+
+  Blocks always end on a line boundary. A file closed cleanly ends with
+  an index block (rawSize 0) whose data lists every text block as
+      u64 offset, u32 rawSize, u32 storedSize, i64 firstTime,
+      i64 lastTime
+  followed by a 16-byte footer: u64 offset of the index block header
+  and the magic "RELBIDX1". A file without the footer (still being
+  written, or cut short) is read by walking the block headers instead.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_BLOCK_H
+#define RELOGGER_BLOCK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: LogBlockInfo
+      ---------------------------------------------------------------------
+      Header of one block, as returned by ReadLogBlockHeader.
+    =======================================================================
+    */
+    struct LogBlockInfo
+    {
+        std::uint64_t offset = 0;     /**< File offset of the block header. */
+        std::uint32_t rawSize = 0;    /**< Bytes of text once decoded. */
+        std::uint32_t storedSize = 0; /**< Bytes of block data after the header. */
+        bool compressed = false;      /**< False if the text is stored as-is. */
+        bool index = false;           /**< True for the trailing index block (no text). */
+        std::int64_t firstTime = 0;   /**< Earliest record timestamp (ns since epoch). */
+        std::int64_t lastTime = 0;    /**< Latest record timestamp (ns since epoch). */
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: ReadBlockLogHeader
+      ---------------------------------------------------------------------
+      @param in - Stream positioned at the start of the file.
+      @return True if the file is a block-compressed log this version
+              understands; the stream is then at the first block.
+    =======================================================================
+    */
+    bool ReadBlockLogHeader(std::istream& in);
+
+    /*
+    =======================================================================
+      FUNCTION: ReadLogBlockHeader
+      ---------------------------------------------------------------------
+      Reads the next block header. Follow with ReadLogBlockText, or skip
+      the block with in.seekg(info.storedSize, std::ios::cur).
+
+      @return False at end of file or on a truncated header.
+    =======================================================================
+    */
+    bool ReadLogBlockHeader(std::istream& in, LogBlockInfo& info);
+
+    /*
+    =======================================================================
+      FUNCTION: ReadLogBlockText
+      ---------------------------------------------------------------------
+      Reads and decodes the data of the block whose header was just read.
+      The index block decodes to no text.
+
+      @param text - Overwritten with the block's lines.
+      @return False if the data is truncated or corrupt.
+    =======================================================================
+    */
+    bool ReadLogBlockText(std::istream& in, const LogBlockInfo& info, std::string& text);
+
+    /*
+    =======================================================================
+      FUNCTION: DecodeBlockLog
+      ---------------------------------------------------------------------
+      Writes the text of a whole block-compressed log to a stream.
+
+      @return False on a bad header or a corrupt or truncated block
+              (blocks before it are still written).
+    =======================================================================
+    */
+    bool DecodeBlockLog(std::istream& in, std::ostream& out);
+
+    /*
+    =======================================================================
+      FUNCTION: ReadLogBlockIndex
+      ---------------------------------------------------------------------
+      Lists the text blocks of a file without reading their data: from
+      the trailing index if the file has one, otherwise by walking the
+      block headers (stopping quietly at a truncated tail).
+
+      @param in     - Seekable stream over the whole file.
+      @param blocks - Overwritten with the blocks in file order.
+      @return False if the file is not a block-compressed log.
+    =======================================================================
+    */
+    bool ReadLogBlockIndex(std::istream& in, std::vector<LogBlockInfo>& blocks);
+
+    namespace Internal
+    {
+        constexpr std::size_t BlockLogHeaderSize = 5;    ///< Magic plus version.
+        constexpr std::size_t LogBlockHeaderSize = 24;   ///< Per-block header.
+
+        /*
+        ===================================================================
+          FUNCTION: AppendBlockLogHeader / AppendLogBlock / AppendLogBlockIndex
+          -----------------------------------------------------------------
+          Encode the file header, one block (header plus data) and the
+          closing index onto out. AppendLogBlock falls back to storing
+          the text as-is when compression does not make it smaller and
+          returns the block's header (offset left at 0 for the caller to
+          fill in). indexOffset is where the index block will start in
+          the file.
+        ===================================================================
+        */
+        void AppendBlockLogHeader(std::string& out);
+        LogBlockInfo AppendLogBlock(std::string& out, std::string_view text,
+                                    std::int64_t firstTime, std::int64_t lastTime);
+        void AppendLogBlockIndex(std::string& out, const std::vector<LogBlockInfo>& blocks,
+                                 std::uint64_t indexOffset);
+    }
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_BLOCK_H */
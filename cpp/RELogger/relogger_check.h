@@ -0,0 +1,190 @@
+/*
+===============================================================================
+
+  RELogger - Checks and Assertions (C++ Header)
+  ---------------------------------------------
+
+  RELOG_CHECK* macros test a condition in every build; RELOG_ASSERT*
+  macros only when NDEBUG is not defined (like the RELOG_* macros) and
+  do not evaluate their arguments otherwise. A failure writes a Fatal
+  record, waits until every sink has it, and aborts.
+
+  Example:
+      RELOG_CHECK(handle != nullptr);
+      RELOG_CHECK(size <= capacity, "chunk {} too large for pool {}", size, pool);
+      RELOG_CHECK_LT(index, count);   // "Check failed: index < count (7 vs 4)"
+
+  At the call site a check is the condition and one branch marked
+  unlikely. Formatting the operands, building the record and the Fatal
+  handling live in a cold, never-inlined function. Operands and
+  message arguments take the types RELOG_*F accepts.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_CHECK_H
+#define RELOGGER_CHECK_H
+
+#include "relogger_format.h"
+
+#include <string>
+#include <string_view>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RELOGGER_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define RELOGGER_COLD __declspec(noinline)
+#else
+#define RELOGGER_COLD
+#endif
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: CheckSite
+      ---------------------------------------------------------------------
+      Constant description of one check, created by the macros.
+    =======================================================================
+    */
+    struct CheckSite
+    {
+        const char* file;        /**< Source file (__FILE__). */
+        int line;                /**< Source line (__LINE__). */
+        const char* func;        /**< Function name (__func__). */
+        const char* expression;  /**< Condition as written. */
+    };
+}
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      FUNCTION: FailCheck
+      ---------------------------------------------------------------------
+      Writes "Check failed: <expression><detail>" as a Fatal record,
+      bypassing the level check, flushes every sink and aborts. Defined
+      in relogger.cpp.
+    =======================================================================
+    */
+    [[noreturn]] void FailCheck(const CheckSite& site, std::string_view detail);
+
+    /*
+    =======================================================================
+      FUNCTION: FormatCheckArgs
+      ---------------------------------------------------------------------
+      Appends a format string rendered with arguments to out.
+    =======================================================================
+    */
+    template <typename... Args>
+    void FormatCheckArgs(std::string& out, std::string_view format, const Args&... args)
+    {
+        ArgBuffer buffer;
+        buffer.PutVarint(sizeof...(Args));
+        (EncodeArg(buffer, args), ...);
+
+        std::string text;
+        FormatArgs(text, format, buffer.View());
+        out += text;
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: CheckFailed
+      ---------------------------------------------------------------------
+      Failure of RELOG_CHECK / RELOG_ASSERT, with an optional message.
+    =======================================================================
+    */
+    [[noreturn]] RELOGGER_COLD inline void CheckFailed(const CheckSite& site)
+    {
+        FailCheck(site, {});
+    }
+
+    template <typename... Args>
+    [[noreturn]] RELOGGER_COLD void CheckFailed(const CheckSite& site, std::string_view format, const Args&... args)
+    {
+        std::string detail = ": ";
+        FormatCheckArgs(detail, format, args...);
+        FailCheck(site, detail);
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: CheckOperandsFailed
+      ---------------------------------------------------------------------
+      Failure of a comparison check; shows both operand values. Taken
+      by value so the call site need not keep operands in memory.
+    =======================================================================
+    */
+    template <typename A, typename B>
+    [[noreturn]] RELOGGER_COLD void CheckOperandsFailed(const CheckSite& site, A a, B b)
+    {
+        std::string detail = " (";
+        FormatCheckArgs(detail, "{} vs {}", a, b);
+        detail += ')';
+        FailCheck(site, detail);
+    }
+}
+
+/*
+===============================================================================
+  MACRO DEFINITIONS
+===============================================================================
+*/
+
+#define RELOG_CHECK(condition, ...)                                                         \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(condition)) [[unlikely]]                                                      \
+        {                                                                                   \
+            static constexpr RELogger::CheckSite reloggerCheck { __FILE__, __LINE__, __func__, #condition }; \
+            RELogger::Internal::CheckFailed(reloggerCheck __VA_OPT__(,) __VA_ARGS__);       \
+        }                                                                                   \
+    } while (0)
+
+#define RELOG_CHECK_OP(a, op, b)                                                            \
+    do                                                                                      \
+    {                                                                                       \
+        const auto& reloggerA = (a);                                                        \
+        const auto& reloggerB = (b);                                                        \
+        if (!(reloggerA op reloggerB)) [[unlikely]]                                         \
+        {                                                                                   \
+            static constexpr RELogger::CheckSite reloggerCheck { __FILE__, __LINE__, __func__, #a " " #op " " #b }; \
+            RELogger::Internal::CheckOperandsFailed(reloggerCheck, reloggerA, reloggerB);   \
+        }                                                                                   \
+    } while (0)
+
+#define RELOG_CHECK_EQ(a, b) RELOG_CHECK_OP(a, ==, b)
+#define RELOG_CHECK_NE(a, b) RELOG_CHECK_OP(a, !=, b)
+#define RELOG_CHECK_LT(a, b) RELOG_CHECK_OP(a, <,  b)
+#define RELOG_CHECK_LE(a, b) RELOG_CHECK_OP(a, <=, b)
+#define RELOG_CHECK_GT(a, b) RELOG_CHECK_OP(a, >,  b)
+#define RELOG_CHECK_GE(a, b) RELOG_CHECK_OP(a, >=, b)
+
+#ifndef NDEBUG
+#define RELOG_ASSERT(condition, ...) RELOG_CHECK(condition __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_ASSERT_OP(a, op, b)    RELOG_CHECK_OP(a, op, b)
+#else
+#define RELOG_ASSERT(condition, ...) ((void)sizeof(!(condition)))
+#define RELOG_ASSERT_OP(a, op, b)    ((void)sizeof((a) op (b)))
+#endif
+
+#define RELOG_ASSERT_EQ(a, b) RELOG_ASSERT_OP(a, ==, b)
+#define RELOG_ASSERT_NE(a, b) RELOG_ASSERT_OP(a, !=, b)
+#define RELOG_ASSERT_LT(a, b) RELOG_ASSERT_OP(a, <,  b)
+#define RELOG_ASSERT_LE(a, b) RELOG_ASSERT_OP(a, <=, b)
+#define RELOG_ASSERT_GT(a, b) RELOG_ASSERT_OP(a, >,  b)
+#define RELOG_ASSERT_GE(a, b) RELOG_ASSERT_OP(a, >=, b)
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_CHECK_H */
@@ -0,0 +1,119 @@
+/**
+ * @file relogger_clock.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Record clocks and the logger's active clock.
+ *
+ * The active clock is a raw pointer read once per record; with none set the
+ * logger reads system_clock directly, so the default path has no virtual
+ * call. Init swaps the pointer and waits for a grace period before dropping
+ * its reference to the old clock.
+ */
+
+#include "relogger_clock.h"
+#include "relogger_internal.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace
+{
+	constinit std::atomic<RELogger::Clock*> activeClock { nullptr }; ///< Clock read by Now, or nullptr.
+	std::shared_ptr<RELogger::Clock> clockOwner;                     ///< Keeps activeClock alive; guarded by logMutex.
+
+	std::chrono::system_clock::time_point FromNanoseconds(std::int64_t nanoseconds)
+	{
+		return std::chrono::system_clock::time_point(
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+	}
+
+	std::int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+}
+
+// ============================================================================
+//                               ACTIVE CLOCK
+// ============================================================================
+
+/**
+ * @brief Timestamp for a new record.
+ */
+std::chrono::system_clock::time_point RELogger::Internal::Now()
+{
+	Clock* clock = activeClock.load(std::memory_order_acquire);
+	return clock ? clock->Now() : std::chrono::system_clock::now();
+}
+
+/**
+ * @brief Replaces the record clock.
+ *
+ * Threads that loaded the old pointer hold an epoch guard, so once the
+ * grace period has passed no one can still be inside its Now.
+ */
+void RELogger::Internal::SetClock(std::shared_ptr<Clock> clock)
+{
+	if (clock == clockOwner)
+		return;
+
+	activeClock.store(clock.get(), std::memory_order_release);
+	if (clockOwner)
+		SynchronizeReaders();
+	clockOwner = std::move(clock);
+}
+
+// ============================================================================
+//                               BUILT-IN CLOCKS
+// ============================================================================
+
+std::chrono::system_clock::time_point RELogger::CoarseClock::Now()
+{
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+	timespec ts;
+	if (::clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0)
+		return FromNanoseconds(static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec);
+#endif
+	return std::chrono::system_clock::now();
+}
+
+RELogger::TscClock::TscClock()
+	: nanosecondsPerTick(Internal::TickPeriodNanoseconds())
+{
+	anchorTicks = Internal::ReadTickCounter();
+	anchorTime = std::chrono::system_clock::now();
+}
+
+std::chrono::system_clock::time_point RELogger::TscClock::Now()
+{
+	const std::uint64_t elapsed = Internal::ReadTickCounter() - anchorTicks;
+	return anchorTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+		std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(elapsed) * nanosecondsPerTick)));
+}
+
+RELogger::ManualClock::ManualClock(std::chrono::system_clock::time_point start, std::chrono::nanoseconds step)
+	: current(ToNanoseconds(start)), step(step.count())
+{
+}
+
+std::chrono::system_clock::time_point RELogger::ManualClock::Now()
+{
+	return FromNanoseconds(step != 0
+		? current.fetch_add(step, std::memory_order_relaxed)
+		: current.load(std::memory_order_relaxed));
+}
+
+void RELogger::ManualClock::Set(std::chrono::system_clock::time_point time)
+{
+	current.store(ToNanoseconds(time), std::memory_order_relaxed);
+}
+
+void RELogger::ManualClock::Advance(std::chrono::nanoseconds duration)
+{
+	current.fetch_add(duration.count(), std::memory_order_relaxed);
+}
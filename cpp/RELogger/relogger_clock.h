@@ -0,0 +1,133 @@
+/*
+===============================================================================
+
+  RELogger - Record Clocks (C++ Header)
+  -------------------------------------
+
+  Source of the timestamp stamped on every record. By default the logger
+  reads std::chrono::system_clock; Config::clock replaces it with one of
+  the clocks below or a custom Clock:
+
+    - CoarseClock: the kernel's tick-resolution wall clock, cheaper to
+      read where the platform has one (Linux CLOCK_REALTIME_COARSE).
+    - TscClock:    the CPU timestamp counter, anchored to system_clock
+      when constructed. Does not follow later wall clock adjustments.
+    - ManualClock: a time set and advanced by the program, optionally
+      stepping on each read, for deterministic tests and benchmarks.
+
+  A clock is read by every logging thread and by the backend, so Now
+  must be thread-safe. It is kept alive by the logger until the next
+  Init replaces it and no thread can still be reading it.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_CLOCK_H
+#define RELOGGER_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      CLASS: Clock
+      ---------------------------------------------------------------------
+      Interface for record timestamp sources.
+    =======================================================================
+    */
+    class Clock
+    {
+    public:
+        virtual ~Clock() = default;
+
+        /*
+        ===================================================================
+          FUNCTION: Now
+          -----------------------------------------------------------------
+          @return The time to stamp on a record logged now.
+        ===================================================================
+        */
+        virtual std::chrono::system_clock::time_point Now() = 0;
+    };
+
+    /*
+    =======================================================================
+      CLASS: CoarseClock
+      ---------------------------------------------------------------------
+      Wall clock at the kernel's tick resolution (typically 1-4 ms).
+      Falls back to system_clock where no coarse clock exists.
+    =======================================================================
+    */
+    class CoarseClock : public Clock
+    {
+    public:
+        std::chrono::system_clock::time_point Now() override;
+    };
+
+    /*
+    =======================================================================
+      CLASS: TscClock
+      ---------------------------------------------------------------------
+      Timestamp counter scaled to nanoseconds and added to the wall clock
+      time read at construction. The counter rate is measured once per
+      process; the first TscClock may wait up to 20 ms for it. Falls
+      back to steady_clock where no timestamp counter exists.
+    =======================================================================
+    */
+    class TscClock : public Clock
+    {
+    public:
+        TscClock();
+
+        std::chrono::system_clock::time_point Now() override;
+
+    private:
+        std::chrono::system_clock::time_point anchorTime;
+        std::uint64_t anchorTicks;
+        double nanosecondsPerTick;
+    };
+
+    /*
+    =======================================================================
+      CLASS: ManualClock
+      ---------------------------------------------------------------------
+      Returns the time last set, then moves it forward by step. With a
+      nonzero step every record gets a distinct, reproducible time; with
+      step 0 time only moves through Set and Advance.
+
+      @param start - Time of the first read.
+      @param step  - Added after each read.
+    =======================================================================
+    */
+    class ManualClock : public Clock
+    {
+    public:
+        explicit ManualClock(std::chrono::system_clock::time_point start = {},
+                             std::chrono::nanoseconds step = std::chrono::nanoseconds(0));
+
+        std::chrono::system_clock::time_point Now() override;
+
+        void Set(std::chrono::system_clock::time_point time);
+        void Advance(std::chrono::nanoseconds duration);
+
+    private:
+        std::atomic<std::int64_t> current; ///< Nanoseconds since the system_clock epoch.
+        std::int64_t step;
+    };
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_CLOCK_H */
@@ -0,0 +1,581 @@
+/**
+ * @file relogger_compressed.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Template dictionary log format: writer sink and decoder.
+ *
+ * Near-identical lines from the same call site cost a few bytes each: the
+ * site text is stored once and records carry only what varies.
+ */
+
+#include "relogger_compressed.h"
+#include "relogger_format.h"
+#include "relogger_intern.h"
+#include "relogger_internal.h"
+#include "relogger_stack.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	using RELogger::Internal::ArgType;
+
+	constexpr char CompressedMagic[4] = { 'R', 'E', 'L', 'C' };
+	constexpr std::uint8_t CompressedVersion = 5; ///< Written by this sink; records carry their context.
+	constexpr std::uint8_t InternedVersion = 2;   ///< First version with String entries.
+	constexpr std::uint8_t SiteTableVersion = 3;  ///< First version with SiteTable entries.
+	constexpr std::uint8_t DictionaryVersion = 4; ///< First version with Dictionary entries.
+
+	enum class EntryKind : std::uint8_t
+	{
+		Template = 1,
+		Record = 2,
+		String = 3,
+		SiteTable = 4,
+		SiteRecord = 5,
+		Dictionary = 6,
+		DictionarySite = 7,
+		ModuleMap = 8,
+	};
+
+	// -------------------------------------------------------------------------
+	// Encoding Helpers
+	// -------------------------------------------------------------------------
+
+	void PutVarint(std::string& out, std::uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out += static_cast<char>(value | 0x80);
+			value >>= 7;
+		}
+		out += static_cast<char>(value);
+	}
+
+	void PutString(std::string& out, std::string_view text)
+	{
+		PutVarint(out, text.size());
+		out += text;
+	}
+
+	// -------------------------------------------------------------------------
+	// Decoding Helpers
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Sequential reader over a stream buffer.
+	 */
+	struct StreamReader
+	{
+		std::streambuf* buffer;
+
+		bool AtEnd()
+		{
+			return buffer->sgetc() == std::char_traits<char>::eof();
+		}
+
+		bool Byte(std::uint8_t& value)
+		{
+			int c = buffer->sbumpc();
+			if (c == std::char_traits<char>::eof())
+				return false;
+			value = static_cast<std::uint8_t>(c);
+			return true;
+		}
+
+		bool Varint(std::uint64_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				std::uint8_t byte;
+				if (!Byte(byte))
+					return false;
+				value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		bool String(std::string& value)
+		{
+			std::uint64_t size;
+			if (!Varint(size) || size > (1u << 30))
+				return false;
+			value.resize(static_cast<std::size_t>(size));
+			return buffer->sgetn(value.data(), static_cast<std::streamsize>(size)) == static_cast<std::streamsize>(size);
+		}
+	};
+
+	/**
+	 * @brief A call site as read back from a compressed log.
+	 */
+	struct DecodedTemplate
+	{
+		LogLevel level;
+		int line;
+		std::string file;
+		std::string func;
+		std::string format;
+	};
+}
+
+// ============================================================================
+//                          COMPRESSED FILE SINK
+// ============================================================================
+
+/**
+ * @brief Hashes a template key by the identity of its strings.
+ */
+std::size_t RELogger::CompressedFileSink::TemplateKeyHash::operator()(const TemplateKey& key) const
+{
+	std::size_t hash = std::hash<const void*>()(key.file);
+	hash = hash * 31 + std::hash<const void*>()(key.func);
+	hash = hash * 31 + std::hash<const void*>()(key.format);
+	hash = hash * 31 + static_cast<std::size_t>(key.line);
+	return hash * 31 + static_cast<std::size_t>(key.level);
+}
+
+/**
+ * @brief Creates a sink for the given path and, unless deferred, opens it.
+ * @param path Path to the log file.
+ * @param options Open and flush behavior.
+ * @param siteTable Write SiteRecords for sites in the site section.
+ */
+RELogger::CompressedFileSink::CompressedFileSink(const std::string& path, const FileSinkOptions& options,
+												 bool siteTable)
+	: path(path), options(options), siteTable(siteTable), openAttempted(false), lastTimestamp(0)
+{
+	if (!options.deferOpen)
+		OpenLocked();
+}
+
+/**
+ * @brief Flushes and closes the file.
+ */
+RELogger::CompressedFileSink::~CompressedFileSink()
+{
+	if (file.is_open())
+	{
+		file.flush();
+		file.close();
+	}
+}
+
+/**
+ * @brief Opens the file now if it has not been opened yet.
+ */
+void RELogger::CompressedFileSink::Open()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	OpenLocked();
+}
+
+/**
+ * @brief Creates missing parent directories, opens the file and writes the header.
+ */
+void RELogger::CompressedFileSink::OpenLocked()
+{
+	if (openAttempted)
+		return;
+	openAttempted = true;
+
+	std::error_code error;
+	std::filesystem::path parent = std::filesystem::path(path).parent_path();
+	if (!parent.empty())
+		std::filesystem::create_directories(parent, error);
+
+	file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!file)
+	{
+		std::cerr << "\033[31m[LOGGER ERROR] Failed to open log file: "
+				  << path << "\033[0m" << std::endl;
+		return;
+	}
+
+	const std::span<const LogSite* const> table = siteTable ? Internal::SiteTable() : std::span<const LogSite* const>();
+	for (std::size_t i = 0; i < table.size(); ++i)
+	{
+		const LogSite& site = *table[i];
+		sites.emplace(TemplateKey { site.file, site.func, site.format, site.line, site.level }, static_cast<std::uint32_t>(i));
+	}
+
+	const std::span<const DictionarySite> registered = Internal::RegisteredDictionary();
+	for (const DictionarySite& site : registered)
+		dictionary.emplace(site.line, &site);
+
+	file.write(CompressedMagic, sizeof(CompressedMagic));
+	file.put(static_cast<char>(CompressedVersion));
+
+	scratch.clear();
+	if (!table.empty())
+	{
+		scratch += static_cast<char>(EntryKind::SiteTable);
+		PutVarint(scratch, table.size());
+		PutString(scratch, Internal::SiteTableBuildId());
+	}
+	if (!registered.empty())
+	{
+		scratch += static_cast<char>(EntryKind::Dictionary);
+		PutVarint(scratch, registered.size());
+		PutString(scratch, DictionaryHash(registered));
+	}
+	file.write(scratch.data(), static_cast<std::streamsize>(scratch.size()));
+}
+
+/**
+ * @brief Returns the interned id of a site string, emitting the string
+ *        into the scratch buffer the first time it is seen.
+ */
+std::uint32_t RELogger::CompressedFileSink::StringId(const char* text)
+{
+	const std::uint32_t id = Internal::InternString(text);
+	if (id == 0)
+		return 0;
+
+	if (id >= stringsWritten.size())
+		stringsWritten.resize(id + 1);
+	if (!stringsWritten[id])
+	{
+		stringsWritten[id] = true;
+		scratch += static_cast<char>(EntryKind::String);
+		PutVarint(scratch, id);
+		PutString(scratch, text);
+	}
+	return id;
+}
+
+/**
+ * @brief Returns the template id of a record's site, emitting the template
+ *        (and any new strings) into the scratch buffer the first time the
+ *        site is seen.
+ */
+std::uint32_t RELogger::CompressedFileSink::TemplateId(const LogRecord& record)
+{
+	const TemplateKey key { record.file, record.func, record.format, record.line, record.level };
+
+	auto found = templates.find(key);
+	if (found != templates.end())
+		return found->second;
+
+	const std::uint32_t id = static_cast<std::uint32_t>(templates.size());
+	templates.emplace(key, id);
+
+	const std::uint32_t fileId = StringId(record.file);
+	const std::uint32_t funcId = StringId(record.func);
+
+	if (const DictionarySite* site = FindDictionarySite(record))
+	{
+		scratch += static_cast<char>(EntryKind::DictionarySite);
+		PutVarint(scratch, id);
+		PutVarint(scratch, site->id);
+		PutVarint(scratch, fileId);
+		PutVarint(scratch, funcId);
+		return id;
+	}
+
+	const std::uint32_t formatId = StringId(record.format);
+
+	scratch += static_cast<char>(EntryKind::Template);
+	PutVarint(scratch, id);
+	scratch += static_cast<char>(record.level);
+	PutVarint(scratch, static_cast<std::uint64_t>(record.line));
+	PutVarint(scratch, fileId);
+	PutVarint(scratch, funcId);
+	PutVarint(scratch, formatId);
+	return id;
+}
+
+/**
+ * @brief Looks up a record's site in the registered dictionary.
+ * @return The matching site, or nullptr for plain messages and sites the
+ *         dictionary does not list.
+ */
+const RELogger::DictionarySite* RELogger::CompressedFileSink::FindDictionarySite(const LogRecord& record) const
+{
+	if (!record.format)
+		return nullptr;
+
+	const auto [first, last] = dictionary.equal_range(record.line);
+	for (auto candidate = first; candidate != last; ++candidate)
+	{
+		const DictionarySite& site = *candidate->second;
+		const char* category = site.category ? site.category : "";
+		if (site.level == record.level && std::strcmp(site.format, record.format) == 0
+			&& std::strcmp(category, record.category ? record.category : "") == 0
+			&& Internal::DictionaryFileMatches(record.file ? record.file : "", site.file))
+		{
+			return &site;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Appends one record (and its template, on first use).
+ *
+ * A record carrying a captured stack is preceded by the module map, as
+ * in FileSink.
+ *
+ * @param record The record to write.
+ */
+void RELogger::CompressedFileSink::Write(const LogRecord& record)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	OpenLocked();
+	if (!file.is_open())
+		return;
+
+	scratch.clear();
+	if (Internal::HasStackField(record.context))
+	{
+		const std::uint64_t version = Internal::ModuleMapVersion();
+		if (version != modulesWritten)
+		{
+			std::string modules;
+			Internal::AppendModuleMap(modules);
+			modulesWritten = version;
+			scratch += static_cast<char>(EntryKind::ModuleMap);
+			PutVarint(scratch, static_cast<std::uint64_t>(std::count(modules.begin(), modules.end(), '\n')));
+			PutString(scratch, modules);
+		}
+	}
+
+	EntryKind kind = EntryKind::Record;
+	std::uint32_t id;
+	const auto site = record.format
+		? sites.find(TemplateKey { record.file, record.func, record.format, record.line, record.level })
+		: sites.end();
+	if (site != sites.end())
+	{
+		kind = EntryKind::SiteRecord;
+		id = site->second;
+	}
+	else
+	{
+		id = TemplateId(record);
+	}
+
+	const std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		record.time.time_since_epoch()).count();
+	const std::int64_t delta = timestamp - lastTimestamp;
+	lastTimestamp = timestamp;
+
+	scratch += static_cast<char>(kind);
+	PutVarint(scratch, id);
+	PutVarint(scratch, Internal::ZigZag(delta));
+
+	if (record.format)
+	{
+		PutString(scratch, record.args);
+	}
+	else
+	{
+		// Plain message: a one-argument blob for the "{}" template.
+		std::string_view message = record.message;
+		std::size_t lengthBytes = 1;
+		for (std::uint64_t size = message.size(); size >= 0x80; size >>= 7)
+			++lengthBytes;
+
+		PutVarint(scratch, 2 + lengthBytes + message.size());
+		PutVarint(scratch, 1);
+		scratch += static_cast<char>(ArgType::String);
+		PutString(scratch, message);
+	}
+	PutString(scratch, record.context);
+
+	file.write(scratch.data(), static_cast<std::streamsize>(scratch.size()));
+	if (options.flushEachRecord)
+		file.flush();
+}
+
+/**
+ * @brief Flushes the file stream.
+ */
+void RELogger::CompressedFileSink::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (file.is_open())
+		file.flush();
+}
+
+/**
+ * @brief Reports whether the file was opened successfully.
+ */
+bool RELogger::CompressedFileSink::IsOpen() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return file.is_open();
+}
+
+// ============================================================================
+//                                 DECODER
+// ============================================================================
+
+/**
+ * @brief Converts a compressed log back into plain-text lines.
+ * @param in Binary input stream.
+ * @param out Text output stream.
+ * @param sites Sites of the writing binary, for logs with a site table.
+ * @param dictionary Site dictionary of the writing program, for logs with
+ *        a Dictionary entry.
+ * @return False on a bad header, a corrupt or truncated entry, or a site
+ *         table or dictionary that the arguments do not match.
+ */
+bool RELogger::DecodeCompressedLog(std::istream& in, std::ostream& out, const BinarySites* sites,
+								   const SiteDictionary* dictionary)
+{
+	StreamReader reader { in.rdbuf() };
+
+	char magic[sizeof(CompressedMagic)];
+	std::uint8_t version;
+	if (reader.buffer->sgetn(magic, sizeof(magic)) != sizeof(magic) ||
+		!std::equal(magic, magic + sizeof(magic), CompressedMagic) ||
+		!reader.Byte(version) || version < 1 || version > CompressedVersion)
+	{
+		return false;
+	}
+
+	std::unordered_map<std::uint64_t, std::string> strings;
+	auto readStringRef = [&](std::string& value, const char* fallback)
+	{
+		if (version == 1)
+			return reader.String(value);
+
+		std::uint64_t stringId;
+		if (!reader.Varint(stringId))
+			return false;
+		if (stringId == 0)
+		{
+			value = fallback;
+			return true;
+		}
+		auto found = strings.find(stringId);
+		if (found == strings.end())
+			return false;
+		value = found->second;
+		return true;
+	};
+
+	std::vector<DecodedTemplate> templates;
+	std::vector<DecodedTemplate> siteTemplates;
+	std::unordered_map<std::uint64_t, const DictionaryEntry*> dictionarySites;
+	std::int64_t timestamp = 0;
+	std::string args;
+	std::string context;
+	std::string message;
+	std::string text;
+
+	while (!reader.AtEnd())
+	{
+		std::uint8_t kind;
+		std::uint64_t id;
+		if (!reader.Byte(kind) || !reader.Varint(id))
+			return false;
+
+		if (kind == static_cast<std::uint8_t>(EntryKind::Template))
+		{
+			DecodedTemplate decoded;
+			std::uint8_t level;
+			std::uint64_t line;
+			if (id != templates.size() || !reader.Byte(level) || !reader.Varint(line) ||
+				!readStringRef(decoded.file, "") || !readStringRef(decoded.func, "") ||
+				!readStringRef(decoded.format, "{}"))
+			{
+				return false;
+			}
+			decoded.level = static_cast<LogLevel>(level);
+			decoded.line = static_cast<int>(line);
+			templates.push_back(std::move(decoded));
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::SiteTable) && version >= SiteTableVersion)
+		{
+			std::string buildId;
+			if (!reader.String(buildId) || !sites || sites->sites.size() != id || sites->buildId != buildId)
+				return false;
+
+			siteTemplates.clear();
+			for (const BinarySite& site : sites->sites)
+				siteTemplates.push_back(DecodedTemplate { site.level, site.line, site.file, site.func, site.format });
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::Dictionary) && version >= DictionaryVersion)
+		{
+			std::string hash;
+			if (!reader.String(hash) || !dictionary || dictionary->entries.size() != id
+				|| DictionaryHash(*dictionary) != hash)
+			{
+				return false;
+			}
+
+			dictionarySites.clear();
+			for (const DictionaryEntry& entry : dictionary->entries)
+				dictionarySites.emplace(entry.id, &entry);
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::DictionarySite) && version >= DictionaryVersion)
+		{
+			std::uint64_t dictionaryId;
+			DecodedTemplate decoded;
+			if (id != templates.size() || !reader.Varint(dictionaryId) ||
+				!readStringRef(decoded.file, "") || !readStringRef(decoded.func, ""))
+			{
+				return false;
+			}
+
+			const auto found = dictionarySites.find(dictionaryId);
+			if (found == dictionarySites.end())
+				return false;
+			decoded.level = found->second->level;
+			decoded.line = found->second->line;
+			decoded.format = found->second->format;
+			templates.push_back(std::move(decoded));
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::Record) ||
+				 (kind == static_cast<std::uint8_t>(EntryKind::SiteRecord) && version >= SiteTableVersion))
+		{
+			const std::vector<DecodedTemplate>& table =
+				kind == static_cast<std::uint8_t>(EntryKind::Record) ? templates : siteTemplates;
+			std::uint64_t delta;
+			context.clear();
+			if (id >= table.size() || !reader.Varint(delta) || !reader.String(args)
+				|| (version >= CompressedVersion && !reader.String(context)))
+			{
+				return false;
+			}
+
+			timestamp += Internal::UnZigZag(delta);
+			const DecodedTemplate& site = table[static_cast<std::size_t>(id)];
+			if (!Internal::FormatArgs(message, site.format, args))
+				return false;
+
+			const std::chrono::system_clock::time_point time {
+				std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestamp)) };
+			Internal::FormatRecordText(text, site.level, time, site.file.c_str(), site.line, site.func.c_str(), message,
+				context);
+			out << text << '\n';
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::String) && version >= InternedVersion)
+		{
+			if (!reader.String(strings[id]))
+				return false;
+		}
+		else if (kind == static_cast<std::uint8_t>(EntryKind::ModuleMap) && version >= CompressedVersion)
+		{
+			std::string modules;
+			if (!reader.String(modules))
+				return false;
+			out << modules;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
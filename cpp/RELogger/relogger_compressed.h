@@ -0,0 +1,183 @@
+/*
+===============================================================================
+
+  RELogger - Compressed Log Format (C++ Header)
+  ---------------------------------------------
+
+  A compact binary alternative to the plain-text log file. Each distinct
+  call site (level, file, line, function, format string) is written once
+  as a template; every record then stores only the template id, the
+  timestamp as a delta from the previous record, the encoded arguments
+  from relogger_format.h and the record's context (scoped fields and a
+  captured stack, see relogger_stack.h). Plain RELogger::Log messages
+  use the template "{}" with the message as its single argument.
+
+  File layout (varints are LEB128, deltas are zigzag-encoded):
+      magic "RELC", u8 version (5)
+      entries, each starting with a u8 kind:
+        3 String         : varint string id, varint length + text
+        1 Template       : varint id, u8 level, varint line, varint file
+                           string id, varint func string id, varint
+                           format string id
+        2 Record         : varint template id, varint timestamp delta
+                           (ns), varint length + argument blob,
+                           varint length + context
+        4 SiteTable      : varint site count, varint length + build ID
+        5 SiteRecord     : varint site index, varint timestamp delta
+                           (ns), varint length + argument blob,
+                           varint length + context
+        6 Dictionary     : varint site count, varint length + hash
+        7 DictionarySite : varint template id, varint dictionary id,
+                           varint file string id, varint func string id
+        8 ModuleMap      : varint line count, varint length + the
+                           "[LOGGER MODULE]" lines FileSink writes
+
+  String ids are the interned ids of relogger_intern.h, so a file name
+  shared by many sites is stored once; id 0 is "" (file, func) or "{}"
+  (format). Older files are still decoded: versions 2 to 4 have no
+  context in their records and no ModuleMap entries, and version 1
+  files spell the three strings out in each template.
+
+  Templates are keyed by the addresses of the file, function and format
+  strings, which the RELOG_* macros always pass as literals.
+
+  When the sink is created with siteTable set and the program has a
+  site section (relogger_sites.h), the file starts with a SiteTable
+  entry and records from listed sites are written as SiteRecords that
+  name the site by its index in the section, with no template at all.
+  Decoding such a file needs the sites read from the same binary
+  (relogread --binary).
+
+  Likewise, a program with a registered site dictionary
+  (relogger_dictionary.h) starts with a Dictionary entry, and a new
+  site that is not in the site section but is in the dictionary gets a
+  DictionarySite entry in place of its template: the level, line and
+  format come from the dictionary file (relogread --dictionary), only
+  the file and function names are written.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_COMPRESSED_H
+#define RELOGGER_COMPRESSED_H
+
+#include "relogger_dictionary.h"
+#include "relogger_sink.h"
+#include "relogger_sites.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      CLASS: CompressedFileSink
+      ---------------------------------------------------------------------
+      Writes records in the template dictionary format described above.
+      Use DecodeCompressedLog to turn the file back into text.
+
+      @param path      - Path of the file to write.
+      @param options   - Open and flush behavior (as for FileSink).
+      @param siteTable - Write SiteRecords for sites in the site section.
+    =======================================================================
+    */
+    class CompressedFileSink final : public Sink
+    {
+    public:
+        explicit CompressedFileSink(const std::string& path, const FileSinkOptions& options = FileSinkOptions(),
+                                    bool siteTable = false);
+        ~CompressedFileSink() override;
+
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+        void Open() override;
+
+        /*
+        ===================================================================
+          FUNCTION: IsOpen
+          -----------------------------------------------------------------
+          @return True if the file was opened successfully.
+        ===================================================================
+        */
+        bool IsOpen() const;
+
+    private:
+        struct TemplateKey
+        {
+            const char* file;
+            const char* func;
+            const char* format;
+            int line;
+            LogLevel level;
+
+            bool operator==(const TemplateKey&) const = default;
+        };
+
+        struct TemplateKeyHash
+        {
+            std::size_t operator()(const TemplateKey& key) const;
+        };
+
+        void OpenLocked();
+        std::uint32_t TemplateId(const LogRecord& record);
+        const DictionarySite* FindDictionarySite(const LogRecord& record) const;
+        std::uint32_t StringId(const char* text);
+
+        std::string path;             ///< Path of the log file.
+        FileSinkOptions options;      ///< Behavior chosen at construction.
+        bool siteTable;               ///< Name listed sites by their site section index.
+        bool openAttempted;           ///< Set once the file has been opened (or failed to).
+        std::ofstream file;           ///< Output stream for the log file.
+        std::unordered_map<TemplateKey, std::uint32_t, TemplateKeyHash> templates; ///< Sites already written.
+        std::unordered_map<TemplateKey, std::uint32_t, TemplateKeyHash> sites; ///< Site section index of each listed site.
+        std::unordered_multimap<int, const DictionarySite*> dictionary; ///< Registered dictionary, by line.
+        std::vector<bool> stringsWritten; ///< Interned string ids already written, by id.
+        std::uint64_t modulesWritten = 0; ///< ModuleMapVersion of the last module map written.
+        std::int64_t lastTimestamp;   ///< Timestamp of the previous record (ns).
+        std::string scratch;          ///< Reused encoding buffer.
+        mutable std::mutex mutex;     ///< Serializes writes from concurrent loggers.
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: DecodeCompressedLog
+      ---------------------------------------------------------------------
+      Converts a compressed log back to the plain-text format, one line
+      per record, as FileSink would have written it. Records of
+      version 2 to 4 files were stored without their context, so their
+      lines lack the context fields.
+
+      @param in         - Binary stream positioned at the file header.
+      @param out        - Destination for the text lines.
+      @param sites      - Sites of the binary that wrote the log;
+                          required if the log has a site table.
+      @param dictionary - Site dictionary the program was built with;
+                          required if the log has a Dictionary entry.
+      @return False if the input is not a compressed log, is corrupt
+              or truncated, or has a site table or dictionary that is
+              missing or does not match (everything decoded up to that
+              point is still written to out).
+    =======================================================================
+    */
+    bool DecodeCompressedLog(std::istream& in, std::ostream& out, const BinarySites* sites = nullptr,
+                             const SiteDictionary* dictionary = nullptr);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_COMPRESSED_H */
@@ -0,0 +1,361 @@
+/**
+ * @file relogger_control.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Local control socket served by the backend thread.
+ *
+ * A client connects to a Unix-domain stream socket, sends one command line
+ * and reads the reply until the server closes the connection (see
+ * Tools/relogctl.cpp). The listening socket is non-blocking and polled
+ * between drain passes, so no extra thread exists and logging threads
+ * never see the socket. Changes go through the same atomics the hot path
+ * reads: the level is a relaxed store, sinks are swapped as a new set.
+ *
+ * Commands:
+ *   level                          current level
+ *   level NAME                     set the level (trace ... fatal)
+ *   stats                          level, sinks, writer lag and per-thread overhead
+ *   capture PATH [LEVEL [CATEGORY]] also write matching records to PATH
+ *   uncapture                      detach the capture file
+ */
+
+#include "relogger_internal.h"
+#include "relogger_stats.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using namespace RELogger::Internal;
+
+	constexpr std::size_t MaxCommandSize = 1024;   ///< Longest command line accepted.
+	constexpr std::chrono::milliseconds ClientTimeout { 1000 }; ///< Longest a connection may stay open.
+	constexpr std::size_t MaxClients = 8;          ///< Connections open at once; more wait in the backlog.
+
+	/**
+	 * @brief Parses a level name, case-insensitively.
+	 */
+	bool ParseLevel(const std::string& text, LogLevel& level)
+	{
+		static constexpr LogLevel Levels[] = { LogLevel::Trace, LogLevel::Debug, LogLevel::Info,
+			LogLevel::Warn, LogLevel::Error, LogLevel::Fatal };
+
+		std::string upper = text;
+		for (char& c : upper)
+			c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+		for (LogLevel candidate : Levels)
+		{
+			if (upper == RELogger::LevelToString(candidate))
+			{
+				level = candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Splits a command line on whitespace.
+	 */
+	std::vector<std::string> SplitWords(const std::string& line)
+	{
+		std::vector<std::string> words;
+		std::istringstream stream(line);
+		std::string word;
+		while (stream >> word)
+			words.push_back(word);
+		return words;
+	}
+}
+
+// ============================================================================
+//                              COMMANDS
+// ============================================================================
+
+/**
+ * @brief Runs one command line and returns the reply text.
+ */
+std::string RELogger::Internal::ControlServer::Execute(const std::string& line)
+{
+	const std::vector<std::string> words = SplitWords(line);
+	if (words.empty())
+		return "error: empty command\n";
+
+	const std::string& command = words[0];
+	if (command == "level")
+	{
+		if (words.size() == 1)
+			return std::string(LevelToString(GetLevel())) + "\n";
+
+		LogLevel level;
+		if (!ParseLevel(words[1], level))
+			return "error: unknown level " + words[1] + "\n";
+		SetLevel(level);
+		return std::string("level ") + LevelToString(level) + "\n";
+	}
+
+	if (command == "stats")
+	{
+		std::ostringstream reply;
+		reply << "level " << LevelToString(GetLevel()) << "\n";
+		{
+			EpochGuard guard;
+			const SinkSet* sinks = LoadActiveSinks();
+			reply << "sinks " << (sinks ? sinks->sinks.size() : 0) << "\n";
+			for (std::size_t i = 0; sinks && i < sinks->sinks.size(); ++i)
+			{
+				if (auto* threaded = dynamic_cast<const ThreadedSink*>(sinks->sinks[i].get()))
+				{
+					const SinkLag lag = threaded->Lag();
+					reply << "sink " << i << " pending " << lag.pending << " written " << lag.written
+						  << " skipped " << lag.skipped << "\n";
+				}
+			}
+		}
+		reply << "capture " << (capture ? capturePath : std::string("none")) << "\n";
+		for (const ThreadLogOverhead& thread : GetLogOverhead())
+		{
+			reply << "thread " << std::hex << thread.threadId << std::dec
+				  << " name " << (thread.name.empty() ? "-" : thread.name)
+				  << " calls " << thread.calls
+				  << " us " << std::chrono::duration_cast<std::chrono::microseconds>(thread.time).count()
+				  << (thread.alive ? "" : " exited") << "\n";
+		}
+		return reply.str();
+	}
+
+	if (command == "capture")
+	{
+		if (words.size() < 2)
+			return "error: usage: capture PATH [LEVEL [CATEGORY]]\n";
+
+		LogLevel minLevel = LogLevel::Trace;
+		if (words.size() > 2 && !ParseLevel(words[2], minLevel))
+			return "error: unknown level " + words[2] + "\n";
+		const std::string category = words.size() > 3 ? words[3] : std::string();
+
+		FileSinkOptions options;
+		options.flushEachRecord = false;
+		std::shared_ptr<FileSink> file = std::make_shared<FileSink>(words[1], options);
+		if (!file->IsOpen())
+			return "error: cannot open " + words[1] + "\n";
+
+		std::shared_ptr<Sink> next = std::make_shared<FilterSink>(file, minLevel, category);
+		if (!TryReplaceSink(capture.get(), next))
+			return "error: logger busy, try again\n";
+
+		capture = next;
+		capturePath = words[1];
+		return "capturing to " + capturePath + "\n";
+	}
+
+	if (command == "uncapture")
+	{
+		if (!capture)
+			return "no capture\n";
+		if (!TryReplaceSink(capture.get(), nullptr))
+			return "error: logger busy, try again\n";
+
+		capture.reset();
+		return "stopped capturing to " + capturePath + "\n";
+	}
+
+	return "error: unknown command " + command + "\n";
+}
+
+// ============================================================================
+//                               SOCKET
+// ============================================================================
+
+#ifndef _WIN32
+
+/**
+ * @brief Closes the socket and detaches any capture file.
+ */
+RELogger::Internal::ControlServer::~ControlServer()
+{
+	Close();
+}
+
+/**
+ * @brief Creates the listening socket (owner-only permissions).
+ * @param socketPath Filesystem path of the socket; a stale file is replaced.
+ * @return False if the socket could not be created.
+ */
+bool RELogger::Internal::ControlServer::Open(const std::string& socketPath)
+{
+	sockaddr_un address {};
+	if (socketPath.size() >= sizeof(address.sun_path))
+		return false;
+
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+	listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0)
+		return false;
+
+	::unlink(socketPath.c_str());
+	const mode_t previousMask = ::umask(0077);
+	const bool bound = ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+	::umask(previousMask);
+
+	if (!bound || ::listen(listener, static_cast<int>(MaxClients)) != 0
+		|| ::fcntl(listener, F_SETFL, ::fcntl(listener, F_GETFL) | O_NONBLOCK) != 0)
+	{
+		::close(listener);
+		listener = -1;
+		return false;
+	}
+
+	path = socketPath;
+	return true;
+}
+
+/**
+ * @brief Accepts waiting connections and moves every open one along.
+ *
+ * Nothing here blocks: a client that has not sent its whole command line,
+ * or not taken its whole reply, keeps its state until a later pass, and
+ * is dropped once ClientTimeout has passed since it connected.
+ */
+void RELogger::Internal::ControlServer::Serve()
+{
+	if (listener < 0)
+		return;
+
+	while (clients.size() < MaxClients)
+	{
+		const int socket = ::accept(listener, nullptr, nullptr);
+		if (socket < 0)
+			break;
+		if (::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK) != 0)
+		{
+			::close(socket);
+			continue;
+		}
+
+		Client client;
+		client.socket = socket;
+		client.deadline = std::chrono::steady_clock::now() + ClientTimeout;
+		clients.push_back(std::move(client));
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	clients.erase(std::remove_if(clients.begin(), clients.end(), [&](Client& client)
+	{
+		if (ServeClient(client) || now >= client.deadline)
+		{
+			::close(client.socket);
+			return true;
+		}
+		return false;
+	}), clients.end());
+}
+
+/**
+ * @brief Reads and writes what one client's socket allows right now.
+ *
+ * The command runs once a newline arrives, MaxCommandSize bytes have
+ * been read or the client stops sending.
+ * @return True once the client is finished with (or failed).
+ */
+bool RELogger::Internal::ControlServer::ServeClient(Client& client)
+{
+	if (client.reply.empty())
+	{
+		char buffer[256];
+		bool complete = false;
+		while (!complete)
+		{
+			const ssize_t received = ::recv(client.socket, buffer, sizeof(buffer), 0);
+			if (received < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					return false;
+				if (errno == EINTR)
+					continue;
+				return true;
+			}
+
+			client.input.append(buffer, static_cast<std::size_t>(received));
+			complete = received == 0 || client.input.size() >= MaxCommandSize
+				|| client.input.find('\n') != std::string::npos;
+		}
+		client.reply = Execute(client.input.substr(0, client.input.find('\n')));
+	}
+
+	while (client.sent < client.reply.size())
+	{
+		const ssize_t written = ::send(client.socket, client.reply.data() + client.sent,
+			client.reply.size() - client.sent, MSG_NOSIGNAL);
+		if (written < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return false;
+			if (errno == EINTR)
+				continue;
+			return true;
+		}
+		client.sent += static_cast<std::size_t>(written);
+	}
+	return true;
+}
+
+/**
+ * @brief Stops listening and removes the socket file.
+ *
+ * A capture file stays attached until the logger shuts down, so records
+ * logged while stopping still reach it.
+ */
+void RELogger::Internal::ControlServer::Close()
+{
+	for (const Client& client : clients)
+		::close(client.socket);
+	clients.clear();
+
+	if (listener < 0)
+		return;
+
+	::close(listener);
+	::unlink(path.c_str());
+	listener = -1;
+}
+
+#else
+
+RELogger::Internal::ControlServer::~ControlServer() = default;
+
+/**
+ * @brief Unix-domain control sockets are not supported on Windows builds.
+ */
+bool RELogger::Internal::ControlServer::Open(const std::string&)
+{
+	return false;
+}
+
+void RELogger::Internal::ControlServer::Serve()
+{
+}
+
+void RELogger::Internal::ControlServer::Close()
+{
+}
+
+#endif
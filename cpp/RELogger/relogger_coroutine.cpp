@@ -0,0 +1,124 @@
+/**
+ * @file relogger_coroutine.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Log contexts and awaitable flushes.
+ *
+ * The current context is a plain thread-local pointer: the logging path
+ * reads it once per record and copies its fields into the record. The
+ * flush sequence bookkeeping and the waiting coroutines live with the
+ * backend (relogger_backend.cpp).
+ */
+
+#include "relogger_coroutine.h"
+#include "relogger_internal.h"
+
+#include <utility>
+
+namespace
+{
+	constinit thread_local const RELogger::LogContext* currentContext = nullptr; ///< Tags records of this thread.
+
+	void AppendFields(std::string& out, std::initializer_list<RELogger::LogContext::Field> fields)
+	{
+		for (const RELogger::LogContext::Field& field : fields)
+		{
+			if (!out.empty())
+				out += ' ';
+			out += field.first;
+			out += '=';
+			out += field.second;
+		}
+	}
+}
+
+// ============================================================================
+//                                 CONTEXT
+// ============================================================================
+
+RELogger::LogContext::LogContext(std::initializer_list<Field> fields)
+{
+	AppendFields(this->fields, fields);
+}
+
+RELogger::LogContext::LogContext(const LogContext& parent, std::initializer_list<Field> fields)
+	: fields(parent.fields)
+{
+	AppendFields(this->fields, fields);
+}
+
+const RELogger::LogContext* RELogger::CurrentLogContext()
+{
+	return currentContext;
+}
+
+const RELogger::LogContext* RELogger::ExchangeLogContext(const LogContext* context)
+{
+	return std::exchange(currentContext, context);
+}
+
+RELogger::ContextScope::ContextScope(std::shared_ptr<const LogContext> context)
+	: context(std::move(context)), previous(ExchangeLogContext(this->context.get()))
+{
+}
+
+RELogger::ContextScope::~ContextScope()
+{
+	ExchangeLogContext(previous);
+}
+
+// ============================================================================
+//                               ASYNC FLUSH
+// ============================================================================
+
+/**
+ * @brief Starts a flush; see FlushBackend for what it covers.
+ */
+std::uint64_t RELogger::RequestFlush()
+{
+	Internal::EpochGuard guard;
+	return Internal::RequestFlushSequence();
+}
+
+bool RELogger::IsDurable(std::uint64_t sequence)
+{
+	return Internal::IsFlushSequenceDone(sequence);
+}
+
+RELogger::FlushAwaiter::FlushAwaiter(std::uint64_t sequence, Resumer resume)
+	: sequence(sequence), resume(std::move(resume)), context(CurrentLogContext())
+{
+}
+
+bool RELogger::FlushAwaiter::await_ready() const
+{
+	return IsDurable(sequence);
+}
+
+/**
+ * @brief Parks the coroutine with the backend.
+ * @return False if the flush finished (or the backend stalled) meanwhile.
+ */
+bool RELogger::FlushAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+	ExchangeLogContext(nullptr);
+
+	Internal::EpochGuard guard;
+	return Internal::AwaitFlushSequence(sequence, handle, resume);
+}
+
+bool RELogger::FlushAwaiter::await_resume()
+{
+	ExchangeLogContext(context);
+	return IsDurable(sequence);
+}
+
+RELogger::FlushAwaiter RELogger::WaitDurable(std::uint64_t sequence, Resumer resume)
+{
+	return FlushAwaiter(sequence, std::move(resume));
+}
+
+RELogger::FlushAwaiter RELogger::FlushAsync(Resumer resume)
+{
+	return FlushAwaiter(RequestFlush(), std::move(resume));
+}
@@ -0,0 +1,264 @@
+/*
+===============================================================================
+
+  RELogger - Coroutine Support (C++ Header)
+  -----------------------------------------
+
+  Awaitable flushes and a log context that follows a coroutine rather
+  than a thread.
+
+  Flushes:
+    co_await RELogger::FlushAsync(resume) suspends until every record
+    logged before the call has been written and flushed, without
+    blocking the thread. RequestFlush / WaitDurable split the two steps
+    so a handler can log, start a flush and await it later. The
+    coroutine is handed to resume (e.g. a lambda posting it to the
+    caller's executor) from the backend thread; resume should only
+    schedule it, not run it inline. In synchronous mode, or once the
+    flush is already complete, co_await does not suspend. A sink hung
+    past Config::sinkStallTimeout also resumes waiters; co_await then
+    yields false.
+
+  Context:
+    A LogContext holds fields such as "req=42 user=7" that are written
+    with every record logged while it is current (after the function
+    name in the text line, in LogRecord::context for sinks). ContextScope
+    makes one current for a block. Inside a coroutine, await through
+    Carry(...) (FlushAsync and WaitDurable do it themselves): the
+    context is cleared from the thread the coroutine leaves and set
+    again on the thread it resumes on, one pointer store each way.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_COROUTINE_H
+#define RELOGGER_COROUTINE_H
+
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      TYPE: Resumer
+      ---------------------------------------------------------------------
+      Schedules a suspended coroutine on its executor, e.g.
+      [&io](std::coroutine_handle<> h) { asio::post(io, h); }.
+    =======================================================================
+    */
+    using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+    /*
+    =======================================================================
+      CLASS: LogContext
+      ---------------------------------------------------------------------
+      Immutable set of key=value fields. Share it between the tasks of a
+      request with std::shared_ptr; a child context copies the fields of
+      its parent and appends its own.
+    =======================================================================
+    */
+    class LogContext
+    {
+    public:
+        using Field = std::pair<std::string_view, std::string_view>;
+
+        LogContext(std::initializer_list<Field> fields);
+        LogContext(const LogContext& parent, std::initializer_list<Field> fields);
+
+        /*
+        ===================================================================
+          FUNCTION: Fields
+          -----------------------------------------------------------------
+          @return The fields as written to the log ("req=42 user=7").
+        ===================================================================
+        */
+        std::string_view Fields() const { return fields; }
+
+    private:
+        std::string fields;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: CurrentLogContext / ExchangeLogContext
+      ---------------------------------------------------------------------
+      The context records logged by this thread are tagged with, and a
+      way to replace it for custom executors. The logger does not own
+      the context: it must outlive its time as current.
+
+      @return The context that was current.
+    =======================================================================
+    */
+    const LogContext* CurrentLogContext();
+    const LogContext* ExchangeLogContext(const LogContext* context);
+
+    /*
+    =======================================================================
+      CLASS: ContextScope
+      ---------------------------------------------------------------------
+      Makes a context current until the scope ends, then restores the
+      one it replaced. In a coroutine the scope lives in the frame and
+      keeps the context alive across suspensions.
+    =======================================================================
+    */
+    class ContextScope
+    {
+    public:
+        explicit ContextScope(std::shared_ptr<const LogContext> context);
+        ~ContextScope();
+
+        ContextScope(const ContextScope&) = delete;
+        ContextScope& operator=(const ContextScope&) = delete;
+
+    private:
+        std::shared_ptr<const LogContext> context;
+        const LogContext* previous;
+    };
+
+    /*
+    =======================================================================
+      CLASS: CarryAwaiter
+      ---------------------------------------------------------------------
+      Wraps an awaiter so the current context survives the suspension.
+      Created by Carry.
+    =======================================================================
+    */
+    template <class Awaiter>
+    class CarryAwaiter
+    {
+    public:
+        explicit CarryAwaiter(Awaiter awaiter)
+            : awaiter(std::move(awaiter)), context(CurrentLogContext())
+        {
+        }
+
+        bool await_ready() { return awaiter.await_ready(); }
+
+        template <class Promise>
+        decltype(auto) await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            // The coroutine may resume elsewhere before this returns, so
+            // the thread is cleared first and this is not touched after.
+            ExchangeLogContext(nullptr);
+            return awaiter.await_suspend(handle);
+        }
+
+        decltype(auto) await_resume()
+        {
+            ExchangeLogContext(context);
+            return awaiter.await_resume();
+        }
+
+    private:
+        Awaiter awaiter;
+        const LogContext* context;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: Carry
+      ---------------------------------------------------------------------
+      co_await RELogger::Carry(socket.async_read(...));
+
+      @param awaitable - An awaiter, or a type with a member operator
+                         co_await.
+    =======================================================================
+    */
+    template <class Awaitable>
+    auto Carry(Awaitable&& awaitable)
+    {
+        if constexpr (requires { std::forward<Awaitable>(awaitable).operator co_await(); })
+        {
+            using Awaiter = decltype(std::forward<Awaitable>(awaitable).operator co_await());
+            return CarryAwaiter<Awaiter>(std::forward<Awaitable>(awaitable).operator co_await());
+        }
+        else
+        {
+            return CarryAwaiter<std::decay_t<Awaitable>>(std::forward<Awaitable>(awaitable));
+        }
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: RequestFlush
+      ---------------------------------------------------------------------
+      Starts a flush of every record logged so far without waiting for
+      it. In synchronous mode the sinks are flushed before returning.
+
+      @return Sequence number of the flush, for WaitDurable / IsDurable.
+    =======================================================================
+    */
+    std::uint64_t RequestFlush();
+
+    /*
+    =======================================================================
+      FUNCTION: IsDurable
+      ---------------------------------------------------------------------
+      @return True once the flush with this sequence has completed.
+    =======================================================================
+    */
+    bool IsDurable(std::uint64_t sequence);
+
+    /*
+    =======================================================================
+      CLASS: FlushAwaiter
+      ---------------------------------------------------------------------
+      Returned by WaitDurable and FlushAsync. The coroutine must not be
+      destroyed while suspended on it. co_await yields IsDurable.
+    =======================================================================
+    */
+    class FlushAwaiter
+    {
+    public:
+        FlushAwaiter(std::uint64_t sequence, Resumer resume);
+
+        bool await_ready() const;
+        bool await_suspend(std::coroutine_handle<> handle);
+        bool await_resume();
+
+    private:
+        std::uint64_t sequence;
+        Resumer resume;
+        const LogContext* context;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: WaitDurable
+      ---------------------------------------------------------------------
+      @param sequence - Value returned by RequestFlush.
+      @param resume   - Schedules the coroutine once the flush is done.
+    =======================================================================
+    */
+    FlushAwaiter WaitDurable(std::uint64_t sequence, Resumer resume);
+
+    /*
+    =======================================================================
+      FUNCTION: FlushAsync
+      ---------------------------------------------------------------------
+      Same as WaitDurable(RequestFlush(), resume).
+    =======================================================================
+    */
+    FlushAwaiter FlushAsync(Resumer resume);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_COROUTINE_H */
@@ -0,0 +1,278 @@
+/**
+ * @file relogger_dictionary.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Site dictionary files and the registered dictionary of a program.
+ */
+
+#include "relogger_dictionary.h"
+#include "relogger_sink.h"
+
+#include <cstdio>
+#include <fstream>
+#include <unordered_set>
+
+namespace
+{
+	constexpr LogLevel Levels[] = { LogLevel::Trace, LogLevel::Debug, LogLevel::Info,
+		LogLevel::Warn, LogLevel::Error, LogLevel::Fatal };
+
+	constexpr std::uint64_t FnvOffset = 14695981039346656037ull;
+	constexpr std::uint64_t FnvPrime = 1099511628211ull;
+
+	constinit std::span<const RELogger::DictionarySite> registered; ///< Set by DictionaryRegistration.
+
+	// -------------------------------------------------------------------------
+	// Hashing
+	// -------------------------------------------------------------------------
+
+	void HashText(std::uint64_t& hash, std::string_view text)
+	{
+		for (char c : text)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= FnvPrime;
+		}
+		hash ^= 0xFF; // Field separator; never a byte of UTF-8 text.
+		hash *= FnvPrime;
+	}
+
+	void HashEntry(std::uint64_t& hash, std::uint32_t id, LogLevel level, int line,
+				   std::string_view file, std::string_view format, std::string_view category)
+	{
+		HashText(hash, std::to_string(id));
+		HashText(hash, RELogger::LevelToString(level));
+		HashText(hash, std::to_string(line));
+		HashText(hash, file);
+		HashText(hash, format);
+		HashText(hash, category);
+	}
+
+	std::string HashString(std::uint64_t hash)
+	{
+		char text[17];
+		std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+		return text;
+	}
+
+	// -------------------------------------------------------------------------
+	// Dictionary File Fields
+	// -------------------------------------------------------------------------
+
+	std::string Escape(std::string_view text)
+	{
+		std::string out;
+		for (char c : text)
+		{
+			switch (c)
+			{
+				case '\t': out += "\\t"; break;
+				case '\n': out += "\\n"; break;
+				case '\r': out += "\\r"; break;
+				case '\\': out += "\\\\"; break;
+				default:   out += c; break;
+			}
+		}
+		return out;
+	}
+
+	bool Unescape(std::string_view text, std::string& out)
+	{
+		out.clear();
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			if (text[i] != '\\')
+			{
+				out += text[i];
+				continue;
+			}
+			if (++i == text.size())
+				return false;
+			switch (text[i])
+			{
+				case 't':  out += '\t'; break;
+				case 'n':  out += '\n'; break;
+				case 'r':  out += '\r'; break;
+				case '\\': out += '\\'; break;
+				default:   return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<std::string_view> SplitTabs(std::string_view line)
+	{
+		std::vector<std::string_view> fields;
+		std::size_t start = 0;
+		for (std::size_t tab = line.find('\t'); tab != std::string_view::npos; tab = line.find('\t', start))
+		{
+			fields.push_back(line.substr(start, tab - start));
+			start = tab + 1;
+		}
+		fields.push_back(line.substr(start));
+		return fields;
+	}
+
+	bool ParseNumber(std::string_view text, std::uint64_t& value)
+	{
+		if (text.empty() || text.size() > 10)
+			return false;
+		value = 0;
+		for (char c : text)
+		{
+			if (c < '0' || c > '9')
+				return false;
+			value = value * 10 + static_cast<std::uint64_t>(c - '0');
+		}
+		return true;
+	}
+
+	bool ParseLevel(std::string_view text, LogLevel& level)
+	{
+		for (LogLevel candidate : Levels)
+		{
+			if (text == RELogger::LevelToString(candidate))
+			{
+				level = candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// ============================================================================
+//                             DICTIONARY FILES
+// ============================================================================
+
+/**
+ * @brief Loads a dictionary file.
+ * @return False if the file cannot be read or a line is malformed.
+ */
+bool RELogger::ReadSiteDictionary(const std::string& path, SiteDictionary& dictionary)
+{
+	dictionary = SiteDictionary();
+
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return false;
+
+	std::unordered_set<std::uint32_t> ids;
+	std::string line;
+	while (std::getline(in, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		const std::vector<std::string_view> fields = SplitTabs(line);
+		std::uint64_t number;
+		if (fields.size() == 2 && fields[0] == "next-id")
+		{
+			if (!ParseNumber(fields[1], number) || number == 0 || number > UINT32_MAX)
+				return false;
+			dictionary.nextId = static_cast<std::uint32_t>(number);
+			continue;
+		}
+
+		DictionaryEntry entry;
+		std::uint64_t lineNumber;
+		if (fields.size() != 6 || !ParseNumber(fields[0], number) || number == 0 || number > UINT32_MAX
+			|| !ParseLevel(fields[1], entry.level) || !ParseNumber(fields[2], lineNumber) || lineNumber > INT32_MAX
+			|| fields[3].empty() || !Unescape(fields[4], entry.category) || !Unescape(fields[5], entry.format))
+		{
+			return false;
+		}
+		entry.id = static_cast<std::uint32_t>(number);
+		entry.line = static_cast<int>(lineNumber);
+		entry.file = fields[3];
+		if (!ids.insert(entry.id).second)
+			return false;
+		if (entry.id >= dictionary.nextId)
+			dictionary.nextId = entry.id + 1;
+		dictionary.entries.push_back(std::move(entry));
+	}
+	return true;
+}
+
+/**
+ * @brief Saves a dictionary file, replacing any existing one.
+ */
+bool RELogger::WriteSiteDictionary(const std::string& path, const SiteDictionary& dictionary)
+{
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+		return false;
+
+	out << "# RELogger site dictionary, written by relogscan. Ids are stable across scans;\n"
+		<< "# keep this file with the sources.\n"
+		<< "# id\tlevel\tline\tfile\tcategory\tformat\n"
+		<< "next-id\t" << dictionary.nextId << "\n";
+	for (const DictionaryEntry& entry : dictionary.entries)
+	{
+		out << entry.id << '\t' << LevelToString(entry.level) << '\t' << entry.line << '\t' << entry.file << '\t'
+			<< Escape(entry.category) << '\t' << Escape(entry.format) << '\n';
+	}
+	return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Hashes the entries of a dictionary file.
+ */
+std::string RELogger::DictionaryHash(const SiteDictionary& dictionary)
+{
+	std::uint64_t hash = FnvOffset;
+	for (const DictionaryEntry& entry : dictionary.entries)
+		HashEntry(hash, entry.id, entry.level, entry.line, entry.file, entry.format, entry.category);
+	return HashString(hash);
+}
+
+/**
+ * @brief Hashes a registered dictionary; equal to the hash of the file it
+ *        was generated with.
+ */
+std::string RELogger::DictionaryHash(std::span<const DictionarySite> sites)
+{
+	std::uint64_t hash = FnvOffset;
+	for (const DictionarySite& site : sites)
+	{
+		HashEntry(hash, site.id, site.level, site.line, site.file, site.format,
+			site.category ? std::string_view(site.category) : std::string_view());
+	}
+	return HashString(hash);
+}
+
+// ============================================================================
+//                           REGISTERED DICTIONARY
+// ============================================================================
+
+RELogger::Internal::DictionaryRegistration::DictionaryRegistration(std::span<const DictionarySite> sites)
+{
+	registered = sites;
+}
+
+std::span<const RELogger::DictionarySite> RELogger::Internal::RegisteredDictionary()
+{
+	return registered;
+}
+
+/**
+ * @brief Matches a __FILE__ against a dictionary path on whole components,
+ *        accepting either slash as the separator.
+ */
+bool RELogger::Internal::DictionaryFileMatches(std::string_view path, std::string_view file)
+{
+	if (path.size() < file.size())
+		return false;
+
+	const std::size_t start = path.size() - file.size();
+	for (std::size_t i = 0; i < file.size(); ++i)
+	{
+		const char a = path[start + i] == '\\' ? '/' : path[start + i];
+		const char b = file[i] == '\\' ? '/' : file[i];
+		if (a != b)
+			return false;
+	}
+	return start == 0 || path[start - 1] == '/' || path[start - 1] == '\\';
+}
@@ -0,0 +1,161 @@
+/*
+===============================================================================
+
+  RELogger - Site Dictionary (C++ Header)
+  ---------------------------------------
+
+  A build-time list of the RELOG_*F sites in a code base, written by
+  Tools/relogscan.cpp. Each site gets an id that stays the same from
+  one scan to the next, so the dictionary can be kept with the sources
+  and regenerated as part of the build:
+
+      relogscan --dictionary relogger_sites.dict --source relogger_sites.gen.cpp src/
+
+  relogscan writes two files. The dictionary is the decoder's table. The
+  generated source is compiled into the program, where it registers
+  the same table, so CompressedFileSink can name a site by its id
+  instead of writing its format string. Logs written that way are
+  decoded with relogread --dictionary, which checks that the dictionary
+  is the one the program was built with.
+
+  Dictionary file (UTF-8 text, one site per line, tab-separated):
+      # comment
+      next-id <first id not yet given out>
+      <id> <LEVEL> <line> <file> <category> <format>
+
+  The file is the path given to relogscan; a site matches a record
+  whose __FILE__ ends with it. Category is empty for sites without
+  one. Tab, newline, carriage return and backslash in the category and
+  format are written as \t, \n, \r and \\.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_DICTIONARY_H
+#define RELOGGER_DICTIONARY_H
+
+#include "relogger.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: DictionarySite
+      ---------------------------------------------------------------------
+      One site of a registered dictionary, as emitted by relogscan into
+      the generated source.
+    =======================================================================
+    */
+    struct DictionarySite
+    {
+        std::uint32_t id;
+        LogLevel level;
+        int line;
+        const char* file;
+        const char* format;
+        const char* category;  /**< nullptr for sites without one. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: DictionaryEntry / SiteDictionary
+      ---------------------------------------------------------------------
+      A dictionary file in memory, as read by relogread and written by
+      relogscan. Entries are kept in file order.
+    =======================================================================
+    */
+    struct DictionaryEntry
+    {
+        std::uint32_t id = 0;
+        LogLevel level = LogLevel::Info;
+        int line = 0;
+        std::string file;
+        std::string format;
+        std::string category;
+    };
+
+    struct SiteDictionary
+    {
+        std::uint32_t nextId = 1;
+        std::vector<DictionaryEntry> entries;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: ReadSiteDictionary / WriteSiteDictionary
+      ---------------------------------------------------------------------
+      Load and save a dictionary file. Reading fails on a malformed line
+      or a repeated id; a missing file is an error too, so relogscan
+      checks for one before reading.
+    =======================================================================
+    */
+    bool ReadSiteDictionary(const std::string& path, SiteDictionary& dictionary);
+    bool WriteSiteDictionary(const std::string& path, const SiteDictionary& dictionary);
+
+    /*
+    =======================================================================
+      FUNCTION: DictionaryHash
+      ---------------------------------------------------------------------
+      Identifies a dictionary's contents (ids, levels, lines, files,
+      formats and categories; not next-id) as 16 hex digits. The writer
+      notes it in the log and the decoder compares it.
+    =======================================================================
+    */
+    std::string DictionaryHash(const SiteDictionary& dictionary);
+    std::string DictionaryHash(std::span<const DictionarySite> sites);
+}
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      CLASS: DictionaryRegistration
+      ---------------------------------------------------------------------
+      Registers the sites of the generated source during static
+      initialization. A program has at most one dictionary; a later
+      registration replaces an earlier one.
+    =======================================================================
+    */
+    class DictionaryRegistration
+    {
+    public:
+        explicit DictionaryRegistration(std::span<const DictionarySite> sites);
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: RegisteredDictionary
+      ---------------------------------------------------------------------
+      @return The registered sites, or an empty span without one.
+    =======================================================================
+    */
+    std::span<const DictionarySite> RegisteredDictionary();
+
+    /*
+    =======================================================================
+      FUNCTION: DictionaryFileMatches
+      ---------------------------------------------------------------------
+      @return True if path (a __FILE__) names the dictionary file,
+              i.e. is equal to it or ends with it after a separator.
+    =======================================================================
+    */
+    bool DictionaryFileMatches(std::string_view path, std::string_view file);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_DICTIONARY_H */
@@ -0,0 +1,207 @@
+/**
+ * @file relogger_escape.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Escaping of control characters and invalid UTF-8 in text lines.
+ *
+ * The vector scan only answers "where does the printable ASCII end";
+ * everything after that point is rare and handled one sequence at a time.
+ */
+
+#include "relogger_escape.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RELOGGER_ESCAPE_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RELOGGER_ESCAPE_NEON 1
+#endif
+
+namespace
+{
+	constexpr char HexDigits[] = "0123456789ABCDEF";
+
+	bool IsPlain(unsigned char c)
+	{
+		return c >= 0x20 && c < 0x7F && c != '\\';
+	}
+
+	bool IsContinuation(unsigned char c)
+	{
+		return (c & 0xC0) == 0x80;
+	}
+
+	void AppendByte(std::string& out, unsigned char c)
+	{
+		const char escape[4] = { '\\', 'x', HexDigits[c >> 4], HexDigits[c & 0x0F] };
+		out.append(escape, sizeof(escape));
+	}
+
+	void AppendCodePoint(std::string& out, std::uint32_t codePoint)
+	{
+		const char escape[6] = { '\\', 'u', HexDigits[(codePoint >> 12) & 0x0F], HexDigits[(codePoint >> 8) & 0x0F],
+			HexDigits[(codePoint >> 4) & 0x0F], HexDigits[codePoint & 0x0F] };
+		out.append(escape, sizeof(escape));
+	}
+
+	void AppendControl(std::string& out, unsigned char c)
+	{
+		switch (c)
+		{
+		case '\n': out += "\\n"; break;
+		case '\r': out += "\\r"; break;
+		case '\t': out += "\\t"; break;
+		case '\\': out += "\\\\"; break;
+		default: AppendByte(out, c); break;
+		}
+	}
+
+	/**
+	 * @brief Length of the well-formed UTF-8 sequence at p (RFC 3629: no
+	 *        overlong forms, surrogates or code points past U+10FFFF).
+	 * @return 2 to 4, or 0 if the lead byte does not start one.
+	 */
+	std::size_t SequenceLength(const unsigned char* p, const unsigned char* end)
+	{
+		const std::size_t available = static_cast<std::size_t>(end - p);
+		const unsigned char lead = p[0];
+
+		if (lead >= 0xC2 && lead <= 0xDF)
+			return available >= 2 && IsContinuation(p[1]) ? 2 : 0;
+
+		if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			if (available < 3 || !IsContinuation(p[1]) || !IsContinuation(p[2]))
+				return 0;
+			if ((lead == 0xE0 && p[1] < 0xA0) || (lead == 0xED && p[1] > 0x9F))
+				return 0;
+			return 3;
+		}
+
+		if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			if (available < 4 || !IsContinuation(p[1]) || !IsContinuation(p[2]) || !IsContinuation(p[3]))
+				return 0;
+			if ((lead == 0xF0 && p[1] < 0x90) || (lead == 0xF4 && p[1] > 0x8F))
+				return 0;
+			return 4;
+		}
+
+		return 0;
+	}
+
+	std::uint32_t DecodeSequence(const unsigned char* p, std::size_t length)
+	{
+		switch (length)
+		{
+		case 2: return (std::uint32_t(p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+		case 3: return (std::uint32_t(p[0] & 0x0F) << 12) | (std::uint32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+		default: return (std::uint32_t(p[0] & 0x07) << 18) | (std::uint32_t(p[1] & 0x3F) << 12)
+			| (std::uint32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+		}
+	}
+
+	/**
+	 * @brief Code points that are valid but still move or reorder lines:
+	 *        C1 controls, U+2028/U+2029 and the bidi embeddings, overrides
+	 *        and isolates.
+	 */
+	bool IsUnsafeCodePoint(std::uint32_t codePoint)
+	{
+		return (codePoint >= 0x80 && codePoint <= 0x9F)
+			|| (codePoint >= 0x2028 && codePoint <= 0x202E)
+			|| (codePoint >= 0x2066 && codePoint <= 0x2069);
+	}
+}
+
+std::size_t RELogger::Internal::PlainPrefixLength(std::string_view text)
+{
+	const char* begin = text.data();
+	const char* p = begin;
+	const char* end = begin + text.size();
+
+#if defined(RELOGGER_ESCAPE_SSE2)
+	// Signed compare: bytes 0x80-0xFF are negative, so "< 0x20" also
+	// catches every non-ASCII byte.
+	const __m128i space = _mm_set1_epi8(0x20);
+	const __m128i del = _mm_set1_epi8(0x7F);
+	const __m128i backslash = _mm_set1_epi8('\\');
+	for (; end - p >= 16; p += 16)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmplt_epi8(bytes, space), _mm_cmpeq_epi8(bytes, del)),
+			_mm_cmpeq_epi8(bytes, backslash));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+		if (mask)
+			return static_cast<std::size_t>(p - begin) + static_cast<std::size_t>(std::countr_zero(mask));
+	}
+
+	// The tail is checked with one load ending at the last byte; the
+	// bytes it shares with the loop are already known to be plain.
+	if (p < end && text.size() >= 16)
+	{
+		p = end - 16;
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmplt_epi8(bytes, space), _mm_cmpeq_epi8(bytes, del)),
+			_mm_cmpeq_epi8(bytes, backslash));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+		return mask ? static_cast<std::size_t>(p - begin) + static_cast<std::size_t>(std::countr_zero(mask))
+			: text.size();
+	}
+#elif defined(RELOGGER_ESCAPE_NEON)
+	const uint8x16_t space = vdupq_n_u8(0x20);
+	const uint8x16_t del = vdupq_n_u8(0x7F);
+	const uint8x16_t backslash = vdupq_n_u8('\\');
+	for (; end - p >= 16; p += 16)
+	{
+		const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(p));
+		const uint8x16_t special = vorrq_u8(vorrq_u8(vcltq_u8(bytes, space), vcgeq_u8(bytes, del)),
+			vceqq_u8(bytes, backslash));
+		if (vmaxvq_u8(special))
+			break; // The scalar loop finds the byte.
+	}
+#endif
+
+	while (p < end && IsPlain(static_cast<unsigned char>(*p)))
+		++p;
+	return static_cast<std::size_t>(p - begin);
+}
+
+void RELogger::Internal::AppendEscaped(std::string& out, std::string_view text)
+{
+	while (!text.empty())
+	{
+		const std::size_t plain = PlainPrefixLength(text);
+		out.append(text.data(), plain);
+		text.remove_prefix(plain);
+		if (text.empty())
+			break;
+
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+		if (*p < 0x80)
+		{
+			AppendControl(out, *p);
+			text.remove_prefix(1);
+			continue;
+		}
+
+		const std::size_t length = SequenceLength(p, p + text.size());
+		if (length == 0)
+		{
+			AppendByte(out, *p);
+			text.remove_prefix(1);
+			continue;
+		}
+
+		const std::uint32_t codePoint = DecodeSequence(p, length);
+		if (IsUnsafeCodePoint(codePoint))
+			AppendCodePoint(out, codePoint);
+		else
+			out.append(text.data(), length);
+		text.remove_prefix(length);
+	}
+}
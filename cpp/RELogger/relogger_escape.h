@@ -0,0 +1,69 @@
+/*
+===============================================================================
+
+  RELogger - Text Escaping (C++ Header)
+  -------------------------------------
+
+  Keeps user-supplied text from breaking the one-record-per-line format.
+  Messages and context fields are copied into the text line through
+  AppendEscaped: printable ASCII and well-formed UTF-8 pass unchanged,
+  anything a terminal or a line-based parser would act on is written as
+  a visible escape. The backslash itself is doubled, so every escape
+  reads back unambiguously.
+
+    \\                            a backslash
+    \n \r \t                      control characters with a short form
+    \x1B, \x7F, ...               other C0 controls and DEL
+    \u0085, \u2028, \u202E, ...   C1 controls, line separators, bidi overrides
+    \xC3                          each byte that is not part of valid UTF-8
+
+  Runs of printable ASCII are found 16 bytes at a time (SSE2 / NEON)
+  and appended in one piece, so a clean message costs about a copy.
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_ESCAPE_H
+#define RELOGGER_ESCAPE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      FUNCTION: AppendEscaped
+      ---------------------------------------------------------------------
+      Appends text to out, escaped as described above.
+    =======================================================================
+    */
+    void AppendEscaped(std::string& out, std::string_view text);
+
+    /*
+    =======================================================================
+      FUNCTION: PlainPrefixLength
+      ---------------------------------------------------------------------
+      @return Length of the leading run of printable ASCII (0x20-0x7E)
+              other than backslash; text.size() if the whole text is
+              such a run.
+    =======================================================================
+    */
+    std::size_t PlainPrefixLength(std::string_view text);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_ESCAPE_H */
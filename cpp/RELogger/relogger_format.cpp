@@ -0,0 +1,220 @@
+/**
+ * @file relogger_format.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Rendering of deferred "{}" format strings from encoded arguments.
+ *
+ * Runs on the backend thread in asynchronous mode (or inline in
+ * synchronous mode) and when decoding compressed log files.
+ */
+
+#include "relogger_format.h"
+
+#include <charconv>
+
+namespace
+{
+	using RELogger::Internal::ArgType;
+
+	/**
+	 * @brief Bounds-checked cursor over an encoded argument blob.
+	 */
+	struct ArgReader
+	{
+		std::string_view bytes;
+		std::size_t position = 0;
+
+		bool Byte(std::uint8_t& value)
+		{
+			if (position >= bytes.size())
+				return false;
+			value = static_cast<std::uint8_t>(bytes[position++]);
+			return true;
+		}
+
+		bool Varint(std::uint64_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				std::uint8_t byte;
+				if (!Byte(byte))
+					return false;
+				value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		bool Fixed(std::uint64_t& value, std::size_t count)
+		{
+			if (bytes.size() - position < count)
+				return false;
+			value = 0;
+			for (std::size_t i = 0; i < count; ++i)
+				value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(bytes[position + i])) << (8 * i);
+			position += count;
+			return true;
+		}
+
+		bool Bytes(std::string_view& value, std::size_t count)
+		{
+			if (bytes.size() - position < count)
+				return false;
+			value = bytes.substr(position, count);
+			position += count;
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Appends a number rendered with std::to_chars.
+	 */
+	template <typename T, typename... Options>
+	void AppendNumber(std::string& out, T value, Options... options)
+	{
+		char digits[64];
+		std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, options...);
+		out.append(digits, result.ptr);
+	}
+
+	/**
+	 * @brief Decodes the next argument and appends its text.
+	 * @return False if the blob is truncated or carries an unknown tag.
+	 */
+	bool AppendArg(std::string& out, ArgReader& reader)
+	{
+		std::uint8_t tag;
+		if (!reader.Byte(tag))
+			return false;
+
+		std::uint64_t value;
+		switch (static_cast<ArgType>(tag))
+		{
+			case ArgType::Int:
+				if (!reader.Varint(value))
+					return false;
+				AppendNumber(out, RELogger::Internal::UnZigZag(value));
+				return true;
+
+			case ArgType::UInt:
+				if (!reader.Varint(value))
+					return false;
+				AppendNumber(out, value);
+				return true;
+
+			case ArgType::Bool:
+				if (!reader.Fixed(value, 1))
+					return false;
+				out += value ? "true" : "false";
+				return true;
+
+			case ArgType::Char:
+				if (!reader.Fixed(value, 1))
+					return false;
+				out += static_cast<char>(value);
+				return true;
+
+			case ArgType::Float32:
+			{
+				if (!reader.Fixed(value, 4))
+					return false;
+				std::uint32_t bits = static_cast<std::uint32_t>(value);
+				float number;
+				std::memcpy(&number, &bits, sizeof(number));
+				AppendNumber(out, number);
+				return true;
+			}
+
+			case ArgType::Float64:
+			{
+				if (!reader.Fixed(value, 8))
+					return false;
+				double number;
+				std::memcpy(&number, &value, sizeof(number));
+				AppendNumber(out, number);
+				return true;
+			}
+
+			case ArgType::String:
+			{
+				std::string_view text;
+				if (!reader.Varint(value) || !reader.Bytes(text, static_cast<std::size_t>(value)))
+					return false;
+				out += text;
+				return true;
+			}
+
+			case ArgType::Pointer:
+				if (!reader.Varint(value))
+					return false;
+				out += "0x";
+				AppendNumber(out, value, 16);
+				return true;
+		}
+		return false;
+	}
+}
+
+/**
+ * @brief Renders a format string with an encoded argument blob.
+ *
+ * Literal runs between braces are appended in one piece, so the cost is
+ * dominated by the number of placeholders rather than the format length.
+ *
+ * @param out Buffer to overwrite with the message.
+ * @param format Format string with "{}" placeholders.
+ * @param args Encoded arguments.
+ * @return False if the blob is malformed (out then holds a partial message).
+ */
+bool RELogger::Internal::FormatArgs(std::string& out, std::string_view format, std::string_view args)
+{
+	out.clear();
+
+	ArgReader reader { args };
+	std::uint64_t remaining;
+	if (!reader.Varint(remaining))
+		return false;
+
+	std::size_t position = 0;
+	while (position < format.size())
+	{
+		std::size_t brace = format.find_first_of("{}", position);
+		if (brace == std::string_view::npos)
+		{
+			out += format.substr(position);
+			break;
+		}
+
+		out += format.substr(position, brace - position);
+		position = brace;
+
+		char next = (brace + 1 < format.size()) ? format[brace + 1] : '\0';
+		if (format[brace] == '{' && next == '}')
+		{
+			if (remaining > 0)
+			{
+				if (!AppendArg(out, reader))
+					return false;
+				--remaining;
+			}
+			else
+			{
+				out += "{}";
+			}
+			position += 2;
+		}
+		else if (next == format[brace])
+		{
+			out += next; // "{{" or "}}"
+			position += 2;
+		}
+		else
+		{
+			out += format[brace];
+			position += 1;
+		}
+	}
+	return true;
+}
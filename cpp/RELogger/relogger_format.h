@@ -0,0 +1,460 @@
+/*
+===============================================================================
+
+  RELogger - Deferred Formatting (C++ Header)
+  -------------------------------------------
+
+  Format-string logging for RELogger. A RELOG_*F call site owns a static
+  LogSite (level, location and format string); only the argument values
+  are captured at the call, as a compact binary blob. Text is produced
+  later, on the backend thread in asynchronous mode, by substituting
+  each "{}" in the format with the next argument.
+
+  Example:
+      RELOG_INFOF("Loaded {} assets in {} ms", count, elapsed);
+
+  Argument blob layout (all integers little-endian):
+      varint count
+      per argument: u8 ArgType, payload
+        Int     : zigzag varint
+        UInt    : varint
+        Bool    : u8 (0 / 1)
+        Char    : u8
+        Float32 : 4 bytes (IEEE-754 bits)
+        Float64 : 8 bytes (IEEE-754 bits)
+        String  : varint length, bytes
+        Pointer : varint
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_FORMAT_H
+#define RELOGGER_FORMAT_H
+
+#include "relogger.h"
+#include "relogger_sites.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: LogSite
+      ---------------------------------------------------------------------
+      Constant description of one RELOG_*F call site. Constant-initialized
+      once per site by the macros; its address stays valid for the whole
+      program.
+    =======================================================================
+    */
+    struct LogSite
+    {
+        LogLevel level;      /**< Severity of every record from this site. */
+        const char* file;    /**< Source file (__FILE__). */
+        int line;            /**< Source line (__LINE__). */
+        const char* func;    /**< Function name (__func__). */
+        const char* format;  /**< Format string with "{}" placeholders. */
+        const char* category = nullptr; /**< Dotted category (e.g. "net.http") used for routing, or nullptr. */
+    };
+}
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      ENUM CLASS: ArgType
+      ---------------------------------------------------------------------
+      Tag byte preceding each encoded argument.
+    =======================================================================
+    */
+    enum class ArgType : std::uint8_t
+    {
+        Int = 1,
+        UInt,
+        Bool,
+        Char,
+        Float32,
+        Float64,
+        String,
+        Pointer,
+    };
+
+    /*
+    =======================================================================
+      CLASS: ArgBuffer
+      ---------------------------------------------------------------------
+      Growable byte buffer with inline storage, so encoding the
+      arguments of a typical call never touches the heap.
+    =======================================================================
+    */
+    class ArgBuffer
+    {
+    public:
+        ArgBuffer() = default;
+        ~ArgBuffer() { if (data != local) delete[] data; }
+
+        ArgBuffer(const ArgBuffer&) = delete;
+        ArgBuffer& operator=(const ArgBuffer&) = delete;
+
+        void PutByte(std::uint8_t value)
+        {
+            Reserve(1);
+            data[size++] = static_cast<char>(value);
+        }
+
+        void PutVarint(std::uint64_t value)
+        {
+            Reserve(10);
+            while (value >= 0x80)
+            {
+                data[size++] = static_cast<char>(value | 0x80);
+                value >>= 7;
+            }
+            data[size++] = static_cast<char>(value);
+        }
+
+        void PutFixed(std::uint64_t value, std::size_t bytes)
+        {
+            Reserve(bytes);
+            for (std::size_t i = 0; i < bytes; ++i)
+                data[size++] = static_cast<char>(value >> (8 * i));
+        }
+
+        void PutBytes(const void* bytes, std::size_t count)
+        {
+            Reserve(count);
+            std::memcpy(data + size, bytes, count);
+            size += count;
+        }
+
+        std::string_view View() const { return std::string_view(data, size); }
+
+    private:
+        void Reserve(std::size_t extra)
+        {
+            if (size + extra <= capacity)
+                return;
+
+            std::size_t grown = capacity * 2;
+            while (grown < size + extra)
+                grown *= 2;
+
+            char* bigger = new char[grown];
+            std::memcpy(bigger, data, size);
+            if (data != local)
+                delete[] data;
+            data = bigger;
+            capacity = grown;
+        }
+
+        char local[256];
+        char* data = local;
+        std::size_t size = 0;
+        std::size_t capacity = sizeof(local);
+    };
+
+    /*
+    =======================================================================
+      CLASS: FixedArgBuffer
+      ---------------------------------------------------------------------
+      ArgBuffer for argument lists whose encoded size has a compile-time
+      bound (no strings): Capacity covers the worst case, so every write
+      is a plain store with no capacity check.
+    =======================================================================
+    */
+    template <std::size_t Capacity>
+    class FixedArgBuffer
+    {
+    public:
+        void PutByte(std::uint8_t value)
+        {
+            data[size++] = static_cast<char>(value);
+        }
+
+        void PutVarint(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                data[size++] = static_cast<char>(value | 0x80);
+                value >>= 7;
+            }
+            data[size++] = static_cast<char>(value);
+        }
+
+        void PutFixed(std::uint64_t value, std::size_t bytes)
+        {
+            for (std::size_t i = 0; i < bytes; ++i)
+                data[size++] = static_cast<char>(value >> (8 * i));
+        }
+
+        std::string_view View() const { return std::string_view(data, size); }
+
+    private:
+        char data[Capacity];
+        std::size_t size = 0;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: ZigZag
+      ---------------------------------------------------------------------
+      Maps signed integers to unsigned so small magnitudes of either
+      sign encode to short varints.
+    =======================================================================
+    */
+    constexpr std::uint64_t ZigZag(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    constexpr std::int64_t UnZigZag(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: EncodeArg
+      ---------------------------------------------------------------------
+      Appends one tagged argument to the blob (an ArgBuffer or a
+      FixedArgBuffer).
+    =======================================================================
+    */
+    template <typename Buffer, typename T>
+    void EncodeArg(Buffer& buffer, const T& value)
+    {
+        using Type = std::remove_cv_t<std::decay_t<T>>;
+
+        if constexpr (std::is_same_v<Type, bool>)
+        {
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Bool));
+            buffer.PutByte(value ? 1 : 0);
+        }
+        else if constexpr (std::is_same_v<Type, char>)
+        {
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Char));
+            buffer.PutByte(static_cast<std::uint8_t>(value));
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+        {
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Int));
+            buffer.PutVarint(ZigZag(static_cast<std::int64_t>(value)));
+        }
+        else if constexpr (std::is_integral_v<Type> || std::is_enum_v<Type>)
+        {
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::UInt));
+            buffer.PutVarint(static_cast<std::uint64_t>(value));
+        }
+        else if constexpr (std::is_same_v<Type, float>)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Float32));
+            buffer.PutFixed(bits, sizeof(bits));
+        }
+        else if constexpr (std::is_floating_point_v<Type>)
+        {
+            double wide = static_cast<double>(value);
+            std::uint64_t bits;
+            std::memcpy(&bits, &wide, sizeof(bits));
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Float64));
+            buffer.PutFixed(bits, sizeof(bits));
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            std::string_view text;
+            if constexpr (std::is_pointer_v<Type>)
+                text = value ? std::string_view(value) : std::string_view("(null)");
+            else
+                text = std::string_view(value);
+
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::String));
+            buffer.PutVarint(text.size());
+            buffer.PutBytes(text.data(), text.size());
+        }
+        else if constexpr (std::is_pointer_v<Type> || std::is_null_pointer_v<Type>)
+        {
+            buffer.PutByte(static_cast<std::uint8_t>(ArgType::Pointer));
+            buffer.PutVarint(reinterpret_cast<std::uintptr_t>(static_cast<const void*>(value)));
+        }
+        else
+        {
+            static_assert(sizeof(T) == 0, "RELogger: unsupported argument type for RELOG_*F");
+        }
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: MaxEncodedSize
+      ---------------------------------------------------------------------
+      Largest blob EncodeArg can produce for a T (tag included), or 0 if
+      it depends on the value (strings).
+    =======================================================================
+    */
+    template <typename T>
+    constexpr std::size_t MaxEncodedSize()
+    {
+        using Type = std::remove_cv_t<std::decay_t<T>>;
+
+        if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, char>)
+            return 2;
+        else if constexpr (std::is_integral_v<Type> || std::is_enum_v<Type>)
+            return 11;
+        else if constexpr (std::is_same_v<Type, float>)
+            return 5;
+        else if constexpr (std::is_floating_point_v<Type>)
+            return 9;
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            return 0;
+        else if constexpr (std::is_pointer_v<Type> || std::is_null_pointer_v<Type>)
+            return 11;
+        else
+            return 0;
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: EncodeArgs
+      ---------------------------------------------------------------------
+      Encodes an argument list and passes the blob to submit. When no
+      argument is a string the blob is packed into a FixedArgBuffer
+      sized for the worst case, so each site compiles to straight-line
+      stores for its argument types.
+    =======================================================================
+    */
+    template <typename Submit, typename... Args>
+    void EncodeArgs(Submit&& submit, const Args&... args)
+    {
+        if constexpr (((MaxEncodedSize<Args>() != 0) && ...))
+        {
+            FixedArgBuffer<10 + (MaxEncodedSize<Args>() + ... + 0)> buffer;
+            buffer.PutVarint(sizeof...(Args));
+            (EncodeArg(buffer, args), ...);
+            submit(buffer.View());
+        }
+        else
+        {
+            ArgBuffer buffer;
+            buffer.PutVarint(sizeof...(Args));
+            (EncodeArg(buffer, args), ...);
+            submit(buffer.View());
+        }
+    }
+
+    /*
+    =======================================================================
+      FUNCTION: IsLogEnabled
+      ---------------------------------------------------------------------
+      Level check shared by every logging entry point: the global level,
+      plus the category and site overrides of a shared level page
+      (relogger_levels.h). Defined in relogger_levels.cpp.
+    =======================================================================
+    */
+    bool IsLogEnabled(LogLevel level, const char* file, int line, const char* category);
+
+    /*
+    =======================================================================
+      FUNCTION: LogEncoded
+      ---------------------------------------------------------------------
+      Submits a record whose message is a site format plus an encoded
+      argument blob. Defined in relogger.cpp.
+    =======================================================================
+    */
+    void LogEncoded(const LogSite& site, std::string_view args);
+
+    /*
+    =======================================================================
+      FUNCTION: FormatArgs
+      ---------------------------------------------------------------------
+      Renders a format string with an encoded argument blob, replacing
+      each "{}" with the next argument ("{{" and "}}" are literal
+      braces). Surplus placeholders are kept as-is.
+
+      @param out    - Buffer to overwrite with the message.
+      @param format - Format string of the site.
+      @param args   - Blob produced by EncodeArg.
+      @return False if the blob is malformed.
+    =======================================================================
+    */
+    bool FormatArgs(std::string& out, std::string_view format, std::string_view args);
+}
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      FUNCTION: LogFormat
+      ---------------------------------------------------------------------
+      Logs a format string with arguments. Only the argument values are
+      encoded on the calling thread; the text is produced later.
+
+      @param site - Static description of the call site.
+      @param args - Values for the "{}" placeholders.
+    =======================================================================
+    */
+    template <typename... Args>
+    void LogFormat(const LogSite& site, const Args&... args)
+    {
+#ifndef NDEBUG
+        if (!Internal::IsLogEnabled(site.level, site.file, site.line, site.category))
+            return;
+
+        Internal::EncodeArgs([&site](std::string_view blob) { Internal::LogEncoded(site, blob); }, args...);
+#endif
+    }
+}
+
+/*
+===============================================================================
+  MACRO DEFINITIONS
+  -----------------
+  Format-string variants of the RELOG_* macros. Each expansion defines
+  its own static constexpr LogSite and lists it in the site section
+  (relogger_sites.h), so level, fmt and category must be constant
+  expressions; a level chosen at run time does not compile (use
+  RELogger::Log for that).
+===============================================================================
+*/
+
+#define RELOG_LOGF(level, fmt, ...)                                                         \
+    do                                                                                      \
+    {                                                                                       \
+        static constexpr RELogger::LogSite reloggerSite { level, __FILE__, __LINE__, __func__, fmt }; \
+        RELOGGER_SITE_ENTRY(reloggerSite);                                                  \
+        RELogger::LogFormat(reloggerSite __VA_OPT__(,) __VA_ARGS__);                        \
+    } while (0)
+
+#define RELOG_CATEGORY_LOGF(category, level, fmt, ...)                                      \
+    do                                                                                      \
+    {                                                                                       \
+        static constexpr RELogger::LogSite reloggerSite { level, __FILE__, __LINE__, __func__, fmt, category }; \
+        RELOGGER_SITE_ENTRY(reloggerSite);                                                  \
+        RELogger::LogFormat(reloggerSite __VA_OPT__(,) __VA_ARGS__);                        \
+    } while (0)
+
+#define RELOG_TRACEF(fmt, ...) RELOG_LOGF(LogLevel::Trace, fmt __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_DEBUGF(fmt, ...) RELOG_LOGF(LogLevel::Debug, fmt __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_INFOF(fmt, ...)  RELOG_LOGF(LogLevel::Info,  fmt __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_WARNF(fmt, ...)  RELOG_LOGF(LogLevel::Warn,  fmt __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_ERRORF(fmt, ...) RELOG_LOGF(LogLevel::Error, fmt __VA_OPT__(,) __VA_ARGS__)
+#define RELOG_FATALF(fmt, ...) RELOG_LOGF(LogLevel::Fatal, fmt __VA_OPT__(,) __VA_ARGS__)
+
+#include "relogger_check.h"
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_FORMAT_H */
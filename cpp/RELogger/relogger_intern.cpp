@@ -0,0 +1,193 @@
+/**
+ * @file relogger_intern.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Lock-free table of interned site strings.
+ *
+ * Addresses are found through a chain of open-addressing hash tables, each
+ * twice the size of the previous one; a table is never rehashed, a new one
+ * is simply appended when it is half full. Ids index a directory of
+ * geometrically growing buckets, so resolving an id is two loads.
+ */
+
+#include "relogger_intern.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace
+{
+	constexpr unsigned FirstTableBits = 10;      ///< log2 of the first table's slot count.
+	constexpr std::size_t FirstBucketSize = 64;  ///< Ids held by the first directory bucket.
+	constexpr std::size_t BucketCount = 26;      ///< Enough buckets to cover every 32-bit id.
+
+	/**
+	 * @brief One hash slot. The key is claimed first; the id follows.
+	 */
+	struct InternSlot
+	{
+		std::atomic<const char*> key { nullptr };
+		std::atomic<std::uint32_t> id { 0 };
+	};
+
+	/**
+	 * @brief Fixed-size open-addressing table; links to a larger successor.
+	 */
+	struct InternTable
+	{
+		explicit InternTable(unsigned bits)
+			: bits(bits), slots(new InternSlot[std::size_t(1) << bits])
+		{
+		}
+
+		std::size_t Capacity() const { return std::size_t(1) << bits; }
+
+		const unsigned bits;
+		std::unique_ptr<InternSlot[]> slots;
+		std::atomic<std::size_t> used { 0 };         ///< Slots claimed or reserved.
+		std::atomic<InternTable*> next { nullptr };  ///< Larger table used once this one is half full.
+	};
+
+	constinit std::atomic<InternTable*> firstTable { nullptr };     ///< Head of the table chain.
+	constinit std::atomic<std::uint32_t> lastId { 0 };              ///< Highest id handed out.
+	constinit std::atomic<std::atomic<const char*>*> idBuckets[BucketCount] {}; ///< Id to address directory.
+
+	// -------------------------------------------------------------------------
+	// Helpers
+	// -------------------------------------------------------------------------
+
+	/**
+	 * @brief Returns the table following a link, creating it if missing.
+	 */
+	InternTable* LoadOrCreateTable(std::atomic<InternTable*>& link, unsigned bits)
+	{
+		InternTable* table = link.load(std::memory_order_acquire);
+		if (table)
+			return table;
+
+		InternTable* created = new InternTable(bits);
+		if (link.compare_exchange_strong(table, created, std::memory_order_acq_rel, std::memory_order_acquire))
+			return created;
+
+		delete created;
+		return table;
+	}
+
+	/**
+	 * @brief Locates the directory entry for an id, optionally allocating its bucket.
+	 */
+	std::atomic<const char*>* IdEntry(std::uint32_t id, bool create)
+	{
+		const std::size_t index = id - 1;
+		const std::size_t bucket = std::bit_width(index / FirstBucketSize + 1) - 1;
+		const std::size_t offset = index - FirstBucketSize * ((std::size_t(1) << bucket) - 1);
+
+		std::atomic<const char*>* entries = idBuckets[bucket].load(std::memory_order_acquire);
+		if (!entries && create)
+		{
+			std::atomic<const char*>* created = new std::atomic<const char*>[FirstBucketSize << bucket] {};
+			if (idBuckets[bucket].compare_exchange_strong(entries, created, std::memory_order_acq_rel, std::memory_order_acquire))
+				entries = created;
+			else
+				delete[] created;
+		}
+		return entries ? &entries[offset] : nullptr;
+	}
+
+	/**
+	 * @brief Waits for the thread that claimed a slot to publish its id.
+	 */
+	std::uint32_t AwaitId(const InternSlot& slot)
+	{
+		std::uint32_t id = slot.id.load(std::memory_order_acquire);
+		while (id == 0)
+		{
+			std::this_thread::yield();
+			id = slot.id.load(std::memory_order_acquire);
+		}
+		return id;
+	}
+
+	/**
+	 * @brief Assigns a fresh id to a slot this thread has just claimed.
+	 */
+	std::uint32_t PublishId(InternSlot& slot, const char* text)
+	{
+		const std::uint32_t id = lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+		IdEntry(id, true)->store(text, std::memory_order_release);
+		slot.id.store(id, std::memory_order_release);
+		return id;
+	}
+}
+
+// ============================================================================
+//                              STRING TABLE
+// ============================================================================
+
+/**
+ * @brief Returns the id of a site string, interning it on first use.
+ *
+ * The common case (address already present in the first table) is a hash
+ * and one or two acquire loads.
+ *
+ * @param text String literal, or nullptr.
+ */
+std::uint32_t RELogger::Internal::InternString(const char* text)
+{
+	if (!text)
+		return 0;
+
+	const std::uint64_t hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(text)) * 0x9E3779B97F4A7C15ull;
+
+	InternTable* table = LoadOrCreateTable(firstTable, FirstTableBits);
+	for (;;)
+	{
+		const std::size_t mask = table->Capacity() - 1;
+		bool reserved = false;
+
+		for (std::size_t probe = static_cast<std::size_t>(hash >> (64 - table->bits));; probe = (probe + 1) & mask)
+		{
+			InternSlot& slot = table->slots[probe];
+			const char* key = slot.key.load(std::memory_order_acquire);
+			if (key == text)
+				return AwaitId(slot);
+			if (key)
+				continue;
+
+			// Empty slot: the address is not in this table. Claim room for
+			// it, or move on to the next table if this one is half full.
+			if (!reserved)
+			{
+				if (table->used.fetch_add(1, std::memory_order_relaxed) >= table->Capacity() / 2)
+				{
+					table->used.fetch_sub(1, std::memory_order_relaxed);
+					break;
+				}
+				reserved = true;
+			}
+
+			if (slot.key.compare_exchange_strong(key, text, std::memory_order_acq_rel, std::memory_order_acquire))
+				return PublishId(slot, text);
+			if (key == text)
+				return AwaitId(slot);
+		}
+
+		table = LoadOrCreateTable(table->next, table->bits + 1);
+	}
+}
+
+/**
+ * @brief Resolves an id back to the interned address.
+ * @param id Value previously returned by InternString.
+ */
+const char* RELogger::Internal::InternedString(std::uint32_t id)
+{
+	if (id == 0)
+		return nullptr;
+
+	std::atomic<const char*>* entry = IdEntry(id, false);
+	return entry ? entry->load(std::memory_order_acquire) : nullptr;
+}
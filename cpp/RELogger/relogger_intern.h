@@ -0,0 +1,60 @@
+/*
+===============================================================================
+
+  RELogger - Interned Site Strings (C++ Header)
+  ---------------------------------------------
+
+  Process-wide table mapping the file, function and format strings of
+  log sites to small integer ids. Keys are compared by address only:
+  the RELOG_* macros always pass string literals, whose address is
+  stable for the life of the program and identifies their contents.
+  Lookups and inserts are lock-free; the table only grows.
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_INTERN_H
+#define RELOGGER_INTERN_H
+
+#include <cstdint>
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      FUNCTION: InternString
+      ---------------------------------------------------------------------
+      @param text - String with static storage duration, or nullptr.
+      @return Id of the string; 0 for nullptr. Repeated calls with the
+              same address return the same id (two threads interning a
+              new address at the same moment while the table grows may
+              rarely obtain different ids; both resolve to the address).
+    =======================================================================
+    */
+    std::uint32_t InternString(const char* text);
+
+    /*
+    =======================================================================
+      FUNCTION: InternedString
+      ---------------------------------------------------------------------
+      @param id - Value returned by InternString.
+      @return The interned address; nullptr for id 0.
+    =======================================================================
+    */
+    const char* InternedString(std::uint32_t id);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_INTERN_H */
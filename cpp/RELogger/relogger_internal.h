@@ -0,0 +1,366 @@
+/*
+===============================================================================
+
+  RELogger - Internal Declarations (C++ Header)
+  ---------------------------------------------
+
+  Shared plumbing between the RELogger translation units. Not part of
+  the public API; include relogger.h / relogger_sink.h instead.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_INTERNAL_H
+#define RELOGGER_INTERNAL_H
+
+#include "relogger.h"
+#include "relogger_clock.h"
+#include "relogger_coroutine.h"
+#include "relogger_sink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      STRUCT: SinkSet
+      ---------------------------------------------------------------------
+      Immutable snapshot of the outputs records are delivered to. A set
+      is never modified once published; AddSink / RemoveSink build a
+      copy, swap it in, and retire the old one until no reader can still
+      be iterating it.
+    =======================================================================
+    */
+    struct SinkSet
+    {
+        std::vector<std::shared_ptr<Sink>> sinks;
+        SinkSet* nextRetired = nullptr;   /**< Link in the retired list once unpublished. */
+        std::uint64_t retireEpoch = 0;    /**< Epoch at which the set was unpublished. */
+    };
+
+    struct ReaderSlot;
+
+    /*
+    =======================================================================
+      CLASS: EpochGuard
+      ---------------------------------------------------------------------
+      Marks the calling thread as reading shared logger state (the sink
+      set, the backend flag) for its lifetime. Entering costs one store
+      to a thread-owned cache line; no lock is taken. Guards nest.
+    =======================================================================
+    */
+    class EpochGuard
+    {
+    public:
+        EpochGuard();
+        ~EpochGuard();
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+    private:
+        ReaderSlot* slot = nullptr;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: LoadActiveSinks
+      ---------------------------------------------------------------------
+      @return The published sink set, or nullptr outside Init..Shutdown.
+              Only valid while an EpochGuard is held.
+    =======================================================================
+    */
+    const SinkSet* LoadActiveSinks();
+
+    /*
+    =======================================================================
+      FUNCTION: SynchronizeReaders
+      ---------------------------------------------------------------------
+      Blocks until every EpochGuard entered before the call has been
+      left. Must not be called while holding an EpochGuard.
+    =======================================================================
+    */
+    void SynchronizeReaders();
+
+    /*
+    =======================================================================
+      FUNCTION: FormatRecordText
+      ---------------------------------------------------------------------
+      Builds the plain-text line shared by every sink, with message and
+      context escaped (relogger_escape.h):
+        [HH:MM:SS] LEVEL file:line (func) - message
+        [HH:MM:SS] LEVEL file:line (func) [context] - message
+
+      @param out - Buffer to overwrite with the line (no newline).
+    =======================================================================
+    */
+    void FormatRecordText(std::string& out, LogLevel level,
+                          std::chrono::system_clock::time_point time,
+                          const char* file, int line, const char* func,
+                          std::string_view message, std::string_view context = {});
+
+    /*
+    =======================================================================
+      FUNCTION: DispatchRecord
+      ---------------------------------------------------------------------
+      Hands a record to every sink of a set, or to stderr if the set is
+      null.
+    =======================================================================
+    */
+    void DispatchRecord(const SinkSet* sinks, const LogRecord& record);
+
+    /*
+    =======================================================================
+      FUNCTION: FlushSinks
+      ---------------------------------------------------------------------
+      Calls Flush on every sink of a set (no-op for a null set).
+    =======================================================================
+    */
+    void FlushSinks(const SinkSet* sinks);
+
+    /*
+    =======================================================================
+      FUNCTION: ReplayEarlyRecords
+      ---------------------------------------------------------------------
+      Delivers the records buffered before the first Init to a sink set
+      and closes the pre-Init buffer.
+    =======================================================================
+    */
+    void ReplayEarlyRecords(const SinkSet* sinks);
+
+    /*
+    =======================================================================
+      FUNCTION: ReplaceSinkLocked / TryReplaceSink
+      ---------------------------------------------------------------------
+      Publishes a sink set in which target is replaced by replacement
+      (or just removed if replacement is null or already present). A
+      null target appends replacement instead. The
+      Locked variant requires the control mutex; TryReplaceSink takes
+      it only if it is free and returns false otherwise.
+    =======================================================================
+    */
+    void ReplaceSinkLocked(const Sink* target, const std::shared_ptr<Sink>& replacement);
+    bool TryReplaceSink(const Sink* target, const std::shared_ptr<Sink>& replacement);
+
+    /*
+    =======================================================================
+      FUNCTION: CreateSharedMemory / RemoveSharedMemory / CurrentProcessId
+      ---------------------------------------------------------------------
+      Named, zero-filled shared-memory regions (relogger_shm.cpp) for the
+      level and stats pages, which are named after the process id.
+      Mappings are never unmapped; removing the name only stops new
+      processes from opening it.
+    =======================================================================
+    */
+    void* CreateSharedMemory(const std::string& name, std::size_t size);
+    void RemoveSharedMemory(const std::string& name);
+    std::uint64_t CurrentProcessId();
+
+    /*
+    =======================================================================
+      FUNCTION: FileBaseName
+      ---------------------------------------------------------------------
+      @return The part of a source path after its last '/' or '\\'; the
+              name sites are known by in the level and stats pages.
+    =======================================================================
+    */
+    std::string_view FileBaseName(const char* file);
+
+    /*
+    =======================================================================
+      FUNCTION: OpenLevelPage / CloseLevelPage
+      ---------------------------------------------------------------------
+      Switch the level check to this process's shared level page and
+      back (relogger_levels.cpp). Called with the control mutex held.
+    =======================================================================
+    */
+    bool OpenLevelPage();
+    void CloseLevelPage();
+
+    /*
+    =======================================================================
+      FUNCTION: OpenStatsPage / CloseStatsPage / Count*
+      ---------------------------------------------------------------------
+      Shared stats page (relogger_stats.h). CountRecord is called once
+      per written record, CountDrop when a full queue refuses one, and
+      SetQueueDepth by the backend after each pass. All return at once
+      while no page is open.
+    =======================================================================
+    */
+    bool OpenStatsPage();
+    void CloseStatsPage();
+    void CountRecord(const LogRecord& record);
+    void CountDrop(LogLevel level, const char* file, int line, const char* category);
+    void SetQueueDepth(std::uint64_t pendingBytes, std::uint64_t capacityBytes);
+
+    /*
+    =======================================================================
+      FUNCTION: DeliverRecord
+      ---------------------------------------------------------------------
+      The path of a record once it has passed the level check and its
+      time and context are taken: queued for the backend, written to
+      the sinks, or buffered before Init. EpochGuard held. Defined in
+      relogger.cpp.
+    =======================================================================
+    */
+    void DeliverRecord(LogLevel level, std::chrono::system_clock::time_point now,
+                       const char* file, int line, const char* func,
+                       const char* category, const char* format, std::string_view payload,
+                       std::string_view context);
+
+    /*
+    =======================================================================
+      FUNCTION: BeginLogOverhead / EndLogOverhead
+      ---------------------------------------------------------------------
+      Times one producer-side logging call into the calling thread's
+      totals (see relogger_stats.h).
+    =======================================================================
+    */
+    std::uint64_t BeginLogOverhead();
+    void EndLogOverhead(std::uint64_t start);
+
+    /*
+    =======================================================================
+      FUNCTION: ReadTickCounter / TickPeriodNanoseconds /
+                StartTickCalibration
+      ---------------------------------------------------------------------
+      The raw counter behind overhead timing and TscClock, and its rate.
+      Init starts the calibration span; a TickPeriodNanoseconds call
+      less than 20 ms later waits for the rest of it.
+    =======================================================================
+    */
+    std::uint64_t ReadTickCounter();
+    double TickPeriodNanoseconds();
+    void StartTickCalibration();
+
+    /*
+    =======================================================================
+      FUNCTION: Now
+      ---------------------------------------------------------------------
+      Timestamp for a new record from Config::clock, or system_clock.
+      Callers that may race with Init must hold an EpochGuard.
+    =======================================================================
+    */
+    std::chrono::system_clock::time_point Now();
+
+    /*
+    =======================================================================
+      FUNCTION: SetClock
+      ---------------------------------------------------------------------
+      Makes clock (nullptr for system_clock) the record clock. Called by
+      Init under logMutex; waits for readers of the previous clock.
+    =======================================================================
+    */
+    void SetClock(std::shared_ptr<Clock> clock);
+
+    /*
+    =======================================================================
+      CLASS: ControlServer (relogger_control.cpp)
+      ---------------------------------------------------------------------
+      Unix-domain control socket (Config::controlSocketPath), owned and
+      polled by the backend thread. Serve never blocks: clients are
+      non-blocking and carried over between calls, each taking only the
+      bytes that are ready.
+    =======================================================================
+    */
+    class ControlServer
+    {
+    public:
+        ~ControlServer();
+
+        bool Open(const std::string& socketPath);
+        void Serve();
+        void Close();
+
+    private:
+        struct Client
+        {
+            int socket = -1;             ///< Accepted connection.
+            std::string input;           ///< Command bytes received so far.
+            std::string reply;           ///< Reply, once the command has run.
+            std::size_t sent = 0;        ///< Reply bytes already sent.
+            std::chrono::steady_clock::time_point deadline; ///< Dropped if not done by then.
+        };
+
+        bool ServeClient(Client& client);
+        std::string Execute(const std::string& line);
+
+        std::string path;                ///< Socket file, removed by Close.
+        int listener = -1;               ///< Listening socket, or -1.
+        std::vector<Client> clients;     ///< Connections still reading or replying.
+        std::shared_ptr<Sink> capture;   ///< Sink attached by "capture", if any.
+        std::string capturePath;         ///< File of the capture sink.
+    };
+
+    /*
+    =======================================================================
+      BACKEND (relogger_backend.cpp)
+      ---------------------------------------------------------------------
+      Asynchronous mode. StartBackend / StopBackend are called with the
+      control mutex held; EnqueueRecord and FlushBackend only while an
+      EpochGuard is held and IsBackendActive returned true.
+      IsBackendActive is false while a hung sink has stalled the
+      backend: producers then write synchronously to the remaining
+      sinks until the backend makes progress again.
+    =======================================================================
+    */
+    void StartBackend(const Config& config);
+    void StopBackend();
+    bool IsBackendActive();
+    bool IsBackendThread();
+    void EnqueueRecord(LogLevel level, std::chrono::system_clock::time_point time,
+                       const char* file, int line, const char* func,
+                       const char* category, const char* format, std::string_view payload,
+                       std::string_view context);
+    void FlushBackend();
+
+    /*
+    =======================================================================
+      FUNCTION: EnqueueRecords
+      ---------------------------------------------------------------------
+      Copies entries already laid out as QueuedRecords (see LogBatch)
+      into the calling thread's queue and publishes them with a single
+      Commit. Same preconditions and full-queue policy as EnqueueRecord.
+
+      @param records - Entries back to back, each QueueAlignment aligned.
+      @param size    - Total bytes.
+    =======================================================================
+    */
+    void EnqueueRecords(const std::byte* records, std::size_t size);
+
+    /*
+    =======================================================================
+      FUNCTION: RequestFlushSequence / IsFlushSequenceDone /
+                AwaitFlushSequence
+      ---------------------------------------------------------------------
+      Flush sequences behind RequestFlush and WaitDurable. Sequences keep
+      growing across backends. AwaitFlushSequence parks a coroutine
+      until its flush completes or the backend stalls; it returns false
+      (the caller does not suspend) if that already happened. The first
+      and last need an EpochGuard.
+    =======================================================================
+    */
+    std::uint64_t RequestFlushSequence();
+    bool IsFlushSequenceDone(std::uint64_t sequence);
+    bool AwaitFlushSequence(std::uint64_t sequence, std::coroutine_handle<> handle, const Resumer& resume);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_INTERNAL_H */
@@ -0,0 +1,289 @@
+/**
+ * @file relogger_levels.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Active log levels, optionally held in a shared-memory page.
+ *
+ * Without a page the level is a process-local atomic. With one, the level
+ * check reads the page instead, so a tool in another process changes it by
+ * writing the page. The mapping, once created, stays for the life of the
+ * process: logging threads may still be reading it when it is detached.
+ */
+
+#include "relogger_internal.h"
+#include "relogger_levels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace
+{
+	using RELogger::LevelOverride;
+	using RELogger::LevelOverrideKind;
+	using RELogger::LevelPage;
+
+	constinit std::atomic<LogLevel> currentLevel { LogLevel::Trace }; ///< Minimum level to log (default: Trace).
+	constinit std::atomic<LevelPage*> activePage { nullptr };         ///< Page the level check reads, if any.
+
+	constexpr std::uint8_t NoOverride = 0xFF;     ///< OverrideLevel result when no slot matches.
+	constexpr int SlotReadAttempts = 64;          ///< Tries at reading a slot a writer keeps busy.
+	constexpr std::size_t OverrideCacheSize = 64; ///< Sites each thread remembers the override of.
+
+	/**
+	 * @brief A site's override as of one page generation.
+	 */
+	struct CachedOverride
+	{
+		const char* file;
+		const char* category;
+		int line;
+		std::uint32_t generation;
+		std::uint8_t level;       ///< Override level, or NoOverride.
+		bool valid;
+	};
+
+	constinit thread_local CachedOverride overrideCache[OverrideCacheSize] = {};
+
+	/**
+	 * @brief Owns the mapping and its name; removes the name at process exit.
+	 */
+	struct PageMapping
+	{
+		LevelPage* page = nullptr;
+		std::string name;
+
+		~PageMapping()
+		{
+			if (page)
+				RELogger::Internal::RemoveSharedMemory(name);
+		}
+	};
+
+	PageMapping mapping;
+
+	/**
+	 * @brief Reports whether a category matches an override pattern.
+	 *
+	 * Same rules as FilterSink: "*" matches every category, "net.*" matches
+	 * "net" and its children, anything else matches exactly.
+	 */
+	bool CategoryMatches(std::string_view pattern, const char* category)
+	{
+		if (!category)
+			return false;
+		if (pattern == "*")
+			return true;
+
+		const std::string_view name = category;
+		if (pattern.ends_with(".*"))
+		{
+			pattern.remove_suffix(2);
+			return name == pattern
+				|| (name.size() > pattern.size() && name.starts_with(pattern) && name[pattern.size()] == '.');
+		}
+		return name == pattern;
+	}
+
+	/**
+	 * @brief Copies an override slot under its seqlock.
+	 * @return False if the slot is free, or a writer kept it busy for every
+	 *         attempt (one that died mid-write leaves the slot ignored).
+	 */
+	bool ReadSlot(LevelOverride& slot, LevelOverride& copy)
+	{
+		const std::atomic_ref<std::uint16_t> sequence(slot.sequence);
+		for (int attempt = 0; attempt < SlotReadAttempts; ++attempt)
+		{
+			const std::uint16_t before = sequence.load(std::memory_order_acquire);
+			if (before & 1)
+				continue;
+
+			copy.kind = std::atomic_ref<std::uint8_t>(slot.kind).load(std::memory_order_relaxed);
+			copy.level = std::atomic_ref<std::uint8_t>(slot.level).load(std::memory_order_relaxed);
+			copy.line = std::atomic_ref<std::uint32_t>(slot.line).load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < sizeof(copy.name); ++i)
+				copy.name[i] = std::atomic_ref<char>(slot.name[i]).load(std::memory_order_relaxed);
+			copy.name[sizeof(copy.name) - 1] = '\0';
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (sequence.load(std::memory_order_relaxed) == before)
+				return copy.kind != static_cast<std::uint8_t>(LevelOverrideKind::Free);
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Level of the override slot that applies to a record.
+	 * @return The slot's level, or NoOverride if none matches.
+	 */
+	std::uint8_t OverrideLevel(LevelPage* page, const char* file, int line, const char* category)
+	{
+		std::uint8_t level = NoOverride;
+		const std::string_view base = RELogger::Internal::FileBaseName(file);
+
+		LevelOverride copy;
+		for (LevelOverride& slot : page->overrides)
+		{
+			if (!ReadSlot(slot, copy))
+				continue;
+
+			const LevelOverrideKind kind = static_cast<LevelOverrideKind>(copy.kind);
+			if (kind == LevelOverrideKind::Site)
+			{
+				if (base == copy.name && (copy.line == 0 || copy.line == static_cast<std::uint32_t>(line)))
+					return copy.level;
+			}
+			else if (kind == LevelOverrideKind::Category && level == NoOverride && CategoryMatches(copy.name, category))
+			{
+				level = copy.level;
+			}
+		}
+		return level;
+	}
+
+	/**
+	 * @brief OverrideLevel through this thread's cache.
+	 *
+	 * Entries are keyed by the addresses of the file and category, which
+	 * the logging macros always pass as literals, and hold until the page
+	 * generation changes.
+	 */
+	std::uint8_t CachedOverrideLevel(LevelPage* page, const char* file, int line, const char* category)
+	{
+		const std::uint32_t generation = std::atomic_ref<std::uint32_t>(page->generation).load(std::memory_order_acquire);
+		const std::size_t hash = std::hash<const void*>()(file) ^ std::hash<const void*>()(category)
+			^ static_cast<std::size_t>(line) * 0x9E3779B1u;
+		CachedOverride& entry = overrideCache[hash % OverrideCacheSize];
+		if (entry.valid && entry.generation == generation && entry.file == file && entry.line == line
+			&& entry.category == category)
+		{
+			return entry.level;
+		}
+
+		entry = CachedOverride { file, category, line, generation, OverrideLevel(page, file, line, category), true };
+		return entry.level;
+	}
+}
+
+// ============================================================================
+//                               LEVEL CHECK
+// ============================================================================
+
+/**
+ * @brief Returns the part of a path after its last separator.
+ */
+std::string_view RELogger::Internal::FileBaseName(const char* file)
+{
+	if (!file)
+		return {};
+
+	const std::string_view path = file;
+	const std::size_t slash = path.find_last_of("/\\");
+	return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+/**
+ * @brief Decides whether a record passes the active levels.
+ *
+ * Without overrides this is one or two relaxed loads. With overrides in the
+ * shared page a record below every level is rejected from the page header;
+ * the rest look up their site in the thread's cache, and only scan the
+ * slots after an override was edited.
+ */
+bool RELogger::Internal::IsLogEnabled(LogLevel level, const char* file, int line, const char* category)
+{
+	LevelPage* page = activePage.load(std::memory_order_relaxed);
+	if (!page)
+		return level >= currentLevel.load(std::memory_order_relaxed);
+
+	const std::uint8_t value = static_cast<std::uint8_t>(level);
+	const std::uint8_t global = std::atomic_ref<std::uint8_t>(page->level).load(std::memory_order_relaxed);
+	if (std::atomic_ref<std::uint8_t>(page->overrideCount).load(std::memory_order_relaxed) == 0)
+		return value >= global;
+	if (value < global && value < std::atomic_ref<std::uint8_t>(page->minOverrideLevel).load(std::memory_order_relaxed))
+		return false;
+
+	const std::uint8_t override = CachedOverrideLevel(page, file, line, category);
+	return value >= (override == NoOverride ? global : override);
+}
+
+/**
+ * @brief Moves the levels into this process's shared page.
+ * @return False if shared memory is unavailable (levels stay local).
+ */
+bool RELogger::Internal::OpenLevelPage()
+{
+	if (activePage.load(std::memory_order_relaxed))
+		return true;
+
+	if (!mapping.page)
+	{
+		mapping.name = LevelPageName(CurrentProcessId());
+		mapping.page = static_cast<LevelPage*>(CreateSharedMemory(mapping.name, LevelPageSize));
+		if (!mapping.page)
+			return false;
+
+		std::memcpy(mapping.page->magic, LevelPageMagic, sizeof(mapping.page->magic));
+		mapping.page->version = LevelPageVersion;
+		mapping.page->size = sizeof(LevelPage);
+	}
+
+	std::atomic_ref<std::uint8_t>(mapping.page->level).store(
+		static_cast<std::uint8_t>(currentLevel.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+	activePage.store(mapping.page, std::memory_order_release);
+	return true;
+}
+
+/**
+ * @brief Makes the levels process-local again, keeping the page's global level.
+ *
+ * The mapping is kept (and reused by a later OpenLevelPage): a thread may
+ * still be reading it.
+ */
+void RELogger::Internal::CloseLevelPage()
+{
+	LevelPage* page = activePage.load(std::memory_order_relaxed);
+	if (!page)
+		return;
+
+	currentLevel.store(GetLevel(), std::memory_order_relaxed);
+	activePage.store(nullptr, std::memory_order_release);
+}
+
+// ============================================================================
+//                                PUBLIC API
+// ============================================================================
+
+/**
+ * @brief Sets the minimum severity level for log messages.
+ *
+ * Any message below the specified level will be ignored. With a shared
+ * level page the page's global level is written; its overrides remain.
+ *
+ * @param level The desired minimum log level (e.g., LogLevel::Warn).
+ */
+void RELogger::SetLevel(LogLevel level)
+{
+	currentLevel.store(level, std::memory_order_relaxed);
+
+	LevelPage* page = activePage.load(std::memory_order_relaxed);
+	if (page)
+		std::atomic_ref<std::uint8_t>(page->level).store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Retrieves the currently active log level.
+ * @return The current LogLevel setting (LevelOff in the page reads as Fatal).
+ */
+LogLevel RELogger::GetLevel()
+{
+	LevelPage* page = activePage.load(std::memory_order_relaxed);
+	if (!page)
+		return currentLevel.load(std::memory_order_relaxed);
+
+	const std::uint8_t value = std::atomic_ref<std::uint8_t>(page->level).load(std::memory_order_relaxed);
+	return static_cast<LogLevel>(std::min<std::uint8_t>(value, static_cast<std::uint8_t>(LogLevel::Fatal)));
+}
@@ -0,0 +1,125 @@
+/*
+===============================================================================
+
+  RELogger - Shared Level Page (C++ Header)
+  -----------------------------------------
+
+  Layout of the shared-memory page that holds the active levels when
+  Config::sharedLevelPage is set. The page is named after the process
+  id (LevelPageName) so an external tool such as Tools/relogpage can map
+  it and change verbosity of a running process: no thread, socket or
+  lock is involved on either side.
+
+  Every field is read and written with std::atomic_ref. Each override
+  slot is a seqlock: a writer makes its sequence odd, rewrites kind,
+  level, line and name, then makes the sequence even again; a reader
+  copies the slot and retries while the sequence is odd or changed in
+  between. After editing slots the writer updates overrideCount and
+  minOverrideLevel and increments generation.
+
+  The logging path reads nothing but the global level while
+  overrideCount is zero, and rejects a record below both the global
+  level and minOverrideLevel without looking further. Otherwise each
+  thread keeps the override found for a site, and scans the slots again
+  only once generation has changed.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_LEVELS_H
+#define RELOGGER_LEVELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace RELogger
+{
+    constexpr std::size_t LevelPageSize = 4096;        /**< Bytes mapped. */
+    constexpr std::size_t MaxLevelOverrides = 63;      /**< Override slots in the page. */
+    constexpr std::size_t LevelOverrideNameSize = 56;  /**< Bytes of a pattern or file name, with terminator. */
+    constexpr std::uint32_t LevelPageVersion = 2;
+    constexpr std::uint8_t LevelOff = 6;               /**< Level value that disables logging. */
+    inline constexpr char LevelPageMagic[8] = "RELVLPG";
+
+    /*
+    =======================================================================
+      ENUM: LevelOverrideKind
+    =======================================================================
+    */
+    enum class LevelOverrideKind : std::uint8_t
+    {
+        Free = 0,       /**< Slot unused. */
+        Category = 1,   /**< name is a category pattern: "net", "net.*" or "*". */
+        Site = 2,       /**< name is a file base name; line 0 matches the whole file. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: LevelOverride
+      ---------------------------------------------------------------------
+      Minimum level for matching records. Site overrides take precedence
+      over category overrides, which take precedence over the global
+      level; the first matching slot of a kind wins.
+    =======================================================================
+    */
+    struct LevelOverride
+    {
+        std::uint8_t kind;                  /**< LevelOverrideKind. */
+        std::uint8_t level;                 /**< LogLevel value, or LevelOff. */
+        std::uint16_t sequence;             /**< Odd while a writer rewrites the slot. */
+        std::uint32_t line;                 /**< Site line, 0 for any. */
+        char name[LevelOverrideNameSize];   /**< NUL-terminated pattern or file name. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: LevelPage
+    =======================================================================
+    */
+    struct LevelPage
+    {
+        char magic[8];                      /**< LevelPageMagic. */
+        std::uint32_t version;              /**< LevelPageVersion. */
+        std::uint32_t size;                 /**< sizeof(LevelPage). */
+        std::uint8_t level;                 /**< Global LogLevel value, or LevelOff. */
+        std::uint8_t overrideCount;         /**< Number of used slots (0 keeps the fast path). */
+        std::uint8_t minOverrideLevel;      /**< Lowest level of the used slots. */
+        std::uint8_t reserved;
+        std::uint32_t generation;           /**< Incremented after every override edit. */
+        LevelOverride overrides[MaxLevelOverrides];
+    };
+
+    static_assert(sizeof(LevelOverride) == 64, "LevelOverride layout is shared with other processes");
+    static_assert(sizeof(LevelPage) <= LevelPageSize, "LevelPage must fit one page");
+
+    /*
+    =======================================================================
+      FUNCTION: LevelPageName
+      ---------------------------------------------------------------------
+      @return The shared-memory object name of a process's level page
+              (shm_open name on POSIX, file mapping name on Windows).
+    =======================================================================
+    */
+    inline std::string LevelPageName(std::uint64_t processId)
+    {
+#ifdef _WIN32
+        return "Local\\relogger." + std::to_string(processId);
+#else
+        return "/relogger." + std::to_string(processId);
+#endif
+    }
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_LEVELS_H */
@@ -0,0 +1,182 @@
+/**
+ * @file relogger_lz.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief LZ77 block codec for compressed log files.
+ *
+ * Tuned for speed on the backend thread rather than ratio: a single-entry
+ * hash of the next four bytes finds match candidates, and matches are
+ * only extended forwards. Log text is repetitive enough that this alone
+ * typically shrinks it several times over.
+ */
+
+#include "relogger_lz.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+	constexpr unsigned HashBits = 12;                   ///< log2 of the match-finder table size.
+	constexpr std::size_t MinMatch = 4;                 ///< Shortest match worth encoding.
+	constexpr std::size_t MaxOffset = 65535;            ///< Farthest distance an offset can express.
+	constexpr std::uint32_t NoPosition = 0xFFFFFFFFu;   ///< Empty hash table entry.
+
+	std::uint32_t Read32(const char* p)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	std::uint32_t HashOf(std::uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - HashBits);
+	}
+
+	/**
+	 * @brief Appends the extra bytes of a length that did not fit its nibble.
+	 */
+	void PutLength(std::string& out, std::size_t length)
+	{
+		for (; length >= 255; length -= 255)
+			out += static_cast<char>(255);
+		out += static_cast<char>(length);
+	}
+
+	/**
+	 * @brief Appends one sequence; offset 0 marks the final literals-only run.
+	 */
+	void PutSequence(std::string& out, const char* literals, std::size_t literalCount,
+					 std::size_t offset, std::size_t matchLength)
+	{
+		const std::size_t matchCode = offset ? matchLength - MinMatch : 0;
+		out += static_cast<char>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+		if (literalCount >= 15)
+			PutLength(out, literalCount - 15);
+		out.append(literals, literalCount);
+
+		if (!offset)
+			return;
+		out += static_cast<char>(offset & 0xFF);
+		out += static_cast<char>(offset >> 8);
+		if (matchCode >= 15)
+			PutLength(out, matchCode - 15);
+	}
+
+	/**
+	 * @brief Reads the extra bytes of a length whose nibble was 15.
+	 */
+	bool GetLength(std::string_view input, std::size_t& pos, std::size_t& length)
+	{
+		for (;;)
+		{
+			if (pos >= input.size())
+				return false;
+			const std::uint8_t byte = static_cast<std::uint8_t>(input[pos++]);
+			length += byte;
+			if (byte != 255)
+				return true;
+		}
+	}
+}
+
+// ============================================================================
+//                                  CODEC
+// ============================================================================
+
+/**
+ * @brief Compresses one independent block.
+ * @param input Bytes to compress.
+ * @param out Buffer the encoded bytes are appended to.
+ */
+void RELogger::Internal::LzCompress(std::string_view input, std::string& out)
+{
+	const char* data = input.data();
+	const std::size_t size = input.size();
+
+	std::unique_ptr<std::uint32_t[]> table(new std::uint32_t[std::size_t(1) << HashBits]);
+	std::fill_n(table.get(), std::size_t(1) << HashBits, NoPosition);
+
+	std::size_t anchor = 0;
+	std::size_t pos = 0;
+	while (size >= MinMatch && pos <= size - MinMatch)
+	{
+		const std::uint32_t sequence = Read32(data + pos);
+		std::uint32_t& slot = table[HashOf(sequence)];
+		const std::uint32_t candidate = slot;
+		slot = static_cast<std::uint32_t>(pos);
+
+		if (candidate == NoPosition || pos - candidate > MaxOffset || Read32(data + candidate) != sequence)
+		{
+			++pos;
+			continue;
+		}
+
+		std::size_t length = MinMatch;
+		while (pos + length < size && data[candidate + length] == data[pos + length])
+			++length;
+
+		PutSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+		pos += length;
+		anchor = pos;
+	}
+
+	PutSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+/**
+ * @brief Decompresses one block produced by LzCompress.
+ *
+ * Every length and offset is checked against the input and the expected
+ * output size, so corrupt data fails cleanly instead of overrunning.
+ */
+bool RELogger::Internal::LzDecompress(std::string_view input, std::size_t rawSize, std::string& out)
+{
+	out.resize(rawSize);
+	char* output = out.data();
+	std::size_t written = 0;
+	std::size_t pos = 0;
+
+	for (;;)
+	{
+		if (pos >= input.size())
+			return false;
+		const std::uint8_t token = static_cast<std::uint8_t>(input[pos++]);
+
+		std::size_t literalCount = token >> 4;
+		if (literalCount == 15 && !GetLength(input, pos, literalCount))
+			return false;
+		if (literalCount > input.size() - pos || literalCount > rawSize - written)
+			return false;
+		std::memcpy(output + written, input.data() + pos, literalCount);
+		pos += literalCount;
+		written += literalCount;
+
+		if (pos == input.size())
+			return written == rawSize;
+
+		if (input.size() - pos < 2)
+			return false;
+		const std::size_t offset = static_cast<std::uint8_t>(input[pos])
+			| (static_cast<std::size_t>(static_cast<std::uint8_t>(input[pos + 1])) << 8);
+		pos += 2;
+		if (offset == 0 || offset > written)
+			return false;
+
+		std::size_t length = token & 0x0F;
+		if (length == 15 && !GetLength(input, pos, length))
+			return false;
+		length += MinMatch;
+		if (length > rawSize - written)
+			return false;
+
+		// Matches may overlap their own output (runs), so copy forwards.
+		const char* from = output + written - offset;
+		for (std::size_t i = 0; i < length; ++i)
+			output[written + i] = from[i];
+		written += length;
+	}
+}
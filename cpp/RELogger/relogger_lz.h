@@ -0,0 +1,70 @@
+/*
+===============================================================================
+
+  RELogger - LZ Block Codec (C++ Header)
+  --------------------------------------
+
+  Small byte-oriented LZ77 codec used for compressed log blocks. Each
+  call compresses one self-contained block: no state is carried from
+  one block to the next, so any block can be decoded on its own.
+
+  Encoded form is a series of sequences:
+      token      : u8, high nibble = literal count, low nibble =
+                   match length - 4 (15 means "more length bytes follow")
+      [length]   : extra literal count, as bytes of 255 plus a final
+                   byte < 255
+      literals   : copied as-is
+      offset     : u16 little-endian distance back into the output
+                   (absent in the final sequence, which ends the input)
+      [length]   : extra match length, encoded like the literal count
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_LZ_H
+#define RELOGGER_LZ_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      FUNCTION: LzCompress
+      ---------------------------------------------------------------------
+      @param input - Bytes to compress (at most 4 GiB).
+      @param out   - Buffer the encoded block is appended to.
+    =======================================================================
+    */
+    void LzCompress(std::string_view input, std::string& out);
+
+    /*
+    =======================================================================
+      FUNCTION: LzDecompress
+      ---------------------------------------------------------------------
+      @param input   - One encoded block.
+      @param rawSize - Exact decoded size, stored alongside the block.
+      @param out     - Buffer overwritten with the decoded bytes.
+      @return False if the block is corrupt or does not decode to
+              exactly rawSize bytes.
+    =======================================================================
+    */
+    bool LzDecompress(std::string_view input, std::size_t rawSize, std::string& out);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_LZ_H */
@@ -0,0 +1,155 @@
+/**
+ * @file relogger_pool.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Worker pool formatting record batches for the backend.
+ *
+ * A batch is formatted by one worker from start to end, so the per-thread
+ * timestamp cache of FormatRecordText stays effective. Workers share
+ * nothing but the job list; the formatted text stays in the batch until
+ * the backend has written it.
+ */
+
+#include "relogger_pool.h"
+#include "relogger_format.h"
+#include "relogger_intern.h"
+#include "relogger_internal.h"
+
+#include <chrono>
+
+// ============================================================================
+//                                  BATCH
+// ============================================================================
+
+void RELogger::Internal::FormatBatch::Clear()
+{
+	entries.clear();
+	bytes.clear();
+	messages.clear();
+	texts.clear();
+	formatted = false;
+}
+
+/**
+ * @brief Copies a queued record into the batch.
+ */
+void RELogger::Internal::FormatBatch::Add(const QueuedRecord& record)
+{
+	entries.push_back(Entry { record.timestamp, record.fileId, record.funcId, record.formatId,
+		record.categoryId, record.line, static_cast<LogLevel>(record.level), bytes.size(),
+		record.payloadSize, record.contextSize, 0, 0, 0, 0 });
+	bytes.append(record.Payload(), record.payloadSize);
+	bytes.append(record.Context(), record.contextSize);
+}
+
+void RELogger::Internal::FormatBatch::Format()
+{
+	std::string message;
+	std::string text;
+	for (Entry& entry : entries)
+	{
+		const std::string_view payload(bytes.data() + entry.payloadOffset, entry.payloadSize);
+		const std::string_view context(bytes.data() + entry.payloadOffset + entry.payloadSize, entry.contextSize);
+		const char* format = InternedString(entry.formatId);
+
+		std::string_view body = payload;
+		if (format)
+		{
+			FormatArgs(message, format, payload);
+			entry.messageOffset = messages.size();
+			entry.messageSize = message.size();
+			messages += message;
+			body = message;
+		}
+
+		const std::chrono::system_clock::time_point time {
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(
+				std::chrono::nanoseconds(entry.timestamp)) };
+		FormatRecordText(text, entry.level, time, InternedString(entry.fileId), entry.line,
+			InternedString(entry.funcId), body, context);
+		entry.textOffset = texts.size();
+		entry.textSize = text.size();
+		texts += text;
+	}
+}
+
+RELogger::LogRecord RELogger::Internal::FormatBatch::Record(std::size_t i) const
+{
+	const Entry& entry = entries[i];
+	const std::string_view payload(bytes.data() + entry.payloadOffset, entry.payloadSize);
+	const char* format = InternedString(entry.formatId);
+	const std::chrono::system_clock::time_point time {
+		std::chrono::duration_cast<std::chrono::system_clock::duration>(
+			std::chrono::nanoseconds(entry.timestamp)) };
+
+	return LogRecord { entry.level, time, InternedString(entry.fileId), entry.line,
+		InternedString(entry.funcId),
+		format ? std::string_view(messages.data() + entry.messageOffset, entry.messageSize) : payload,
+		std::string_view(texts.data() + entry.textOffset, entry.textSize),
+		format, format ? payload : std::string_view(), InternedString(entry.categoryId),
+		std::string_view(bytes.data() + entry.payloadOffset + entry.payloadSize, entry.contextSize) };
+}
+
+// ============================================================================
+//                                   POOL
+// ============================================================================
+
+RELogger::Internal::FormatPool::FormatPool(std::size_t threads)
+{
+	for (std::size_t i = 0; i < threads; ++i)
+		workers.emplace_back(&FormatPool::Run, this);
+}
+
+/**
+ * @brief Stops the workers once their current batch is done.
+ *
+ * Batches still waiting are left unformatted; the backend only destroys
+ * the pool after it has waited for everything it still needs.
+ */
+RELogger::Internal::FormatPool::~FormatPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	work.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void RELogger::Internal::FormatPool::Submit(FormatBatch* batch)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		batch->formatted = false;
+		pending.push_back(batch);
+	}
+	work.notify_one();
+}
+
+void RELogger::Internal::FormatPool::Wait(FormatBatch* batch)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [batch] { return batch->formatted; });
+}
+
+void RELogger::Internal::FormatPool::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		work.wait(lock, [this] { return stopping || !pending.empty(); });
+		if (stopping)
+			return;
+
+		FormatBatch* batch = pending.front();
+		pending.pop_front();
+
+		lock.unlock();
+		batch->Format();
+		lock.lock();
+
+		batch->formatted = true;
+		finished.notify_all();
+	}
+}
@@ -0,0 +1,140 @@
+/*
+===============================================================================
+
+  RELogger - Parallel Formatting (C++ Header)
+  -------------------------------------------
+
+  Optional formatting stage of the asynchronous backend
+  (Config::formatThreads). The backend copies merged records out of the
+  thread queues into batches, hands each batch to a pool of workers and
+  writes the batches back in the order it built them, so the output is
+  byte-for-byte what a single backend would have produced.
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_POOL_H
+#define RELOGGER_POOL_H
+
+#include "relogger_queue.h"
+#include "relogger_sink.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace RELogger::Internal
+{
+    constexpr std::size_t FormatBatchRecords = 256; /**< Records per batch handed to a worker. */
+
+    /*
+    =======================================================================
+      STRUCT: FormatBatch
+      ---------------------------------------------------------------------
+      Records copied out of the queues (so the producers get their space
+      back at once) and, after formatting, their text. Offsets index
+      bytes, messages and texts. Reused from pass to pass.
+    =======================================================================
+    */
+    struct FormatBatch
+    {
+        struct Entry
+        {
+            std::int64_t timestamp;
+            std::uint32_t fileId;
+            std::uint32_t funcId;
+            std::uint32_t formatId;
+            std::uint32_t categoryId;
+            std::int32_t line;
+            LogLevel level;
+            std::size_t payloadOffset;
+            std::size_t payloadSize;
+            std::size_t contextSize;    /**< Context follows the payload in bytes. */
+            std::size_t messageOffset;  /**< In messages; used when formatId is set. */
+            std::size_t messageSize;
+            std::size_t textOffset;
+            std::size_t textSize;
+        };
+
+        std::vector<Entry> entries;
+        std::string bytes;     /**< Payloads and contexts. */
+        std::string messages;  /**< Substituted RELOG_*F messages. */
+        std::string texts;     /**< Formatted lines. */
+        bool formatted = false; /**< Set by the worker, under the pool mutex. */
+
+        void Clear();
+        void Add(const QueuedRecord& record);
+        bool Full() const { return entries.size() >= FormatBatchRecords; }
+
+        /*
+        ===================================================================
+          FUNCTION: Format
+          -----------------------------------------------------------------
+          Fills messages and texts exactly as the backend would.
+        ===================================================================
+        */
+        void Format();
+
+        /*
+        ===================================================================
+          FUNCTION: Record
+          -----------------------------------------------------------------
+          @return Entry i as a sink sees it; views point into the batch.
+        ===================================================================
+        */
+        LogRecord Record(std::size_t i) const;
+    };
+
+    /*
+    =======================================================================
+      CLASS: FormatPool
+      ---------------------------------------------------------------------
+      Worker threads that format submitted batches in any order. Wait
+      returns once a given batch is done; the backend waits for its
+      batches in submission order.
+    =======================================================================
+    */
+    class FormatPool
+    {
+    public:
+        explicit FormatPool(std::size_t threads);
+        ~FormatPool();
+
+        FormatPool(const FormatPool&) = delete;
+        FormatPool& operator=(const FormatPool&) = delete;
+
+        void Submit(FormatBatch* batch);
+        void Wait(FormatBatch* batch);
+
+    private:
+        void Run();
+
+        std::mutex mutex;
+        std::condition_variable work;      ///< Signals workers about new batches or stop.
+        std::condition_variable finished;  ///< Signals Wait about formatted batches.
+        std::deque<FormatBatch*> pending;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+    };
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_POOL_H */
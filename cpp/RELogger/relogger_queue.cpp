@@ -0,0 +1,370 @@
+/**
+ * @file relogger_queue.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Per-thread SPSC record queues for asynchronous logging.
+ *
+ * The producer only ever touches its own cache line plus a cached copy of
+ * the consumer position, so logging threads do not contend with each other
+ * or with the backend except when a ring is close to full.
+ */
+
+#include "relogger_queue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+	using RELogger::Internal::ThreadQueue;
+
+	constexpr std::size_t MinQueueCapacity = 4096; ///< Smallest ring accepted.
+
+	constinit std::atomic<ThreadQueue*> queueRegistry { nullptr }; ///< Every queue ever created.
+
+	enum class QueueState : std::uint8_t { None, Owned, Released };
+
+	constinit thread_local ThreadQueue* threadQueue = nullptr;             ///< Queue owned by this thread.
+	constinit thread_local QueueState threadQueueState = QueueState::None; ///< Ownership progress of this thread.
+
+	/**
+	 * @brief Hands this thread's queue back to the pool when the thread exits.
+	 *
+	 * Unread records stay in the ring; the backend keeps draining it and the
+	 * next thread to claim it simply appends after them.
+	 */
+	struct QueueReleaser
+	{
+		~QueueReleaser()
+		{
+			if (threadQueue)
+			{
+				threadQueue->owned.store(false, std::memory_order_release);
+				threadQueue = nullptr;
+			}
+			threadQueueState = QueueState::Released;
+		}
+	};
+
+	thread_local QueueReleaser threadQueueReleaser;
+
+	constinit std::atomic<std::uint64_t> queueGrowths { 0 }; ///< Successful GrowThreadQueue calls.
+
+	/**
+	 * @brief Rounds a requested capacity to a usable ring size.
+	 */
+	std::size_t NormalizeCapacity(std::size_t capacity)
+	{
+		if (capacity < MinQueueCapacity)
+			capacity = MinQueueCapacity;
+		return capacity & ~(RELogger::Internal::QueueAlignment - 1);
+	}
+
+	/**
+	 * @brief Claims an abandoned queue of the given capacity or creates one.
+	 * @param requireEmpty Skip abandoned queues that still hold records.
+	 */
+	ThreadQueue* ClaimQueue(std::size_t capacity, bool requireEmpty)
+	{
+		for (ThreadQueue* candidate = queueRegistry.load(std::memory_order_acquire); candidate; candidate = candidate->next)
+		{
+			bool expected = false;
+			if (candidate->Capacity() == capacity &&
+				candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				if (!requireEmpty || candidate->IsDrained())
+					return candidate;
+				candidate->owned.store(false, std::memory_order_release);
+			}
+		}
+
+		ThreadQueue* queue = new ThreadQueue(capacity);
+		ThreadQueue* head = queueRegistry.load(std::memory_order_relaxed);
+		do
+		{
+			queue->next = head;
+		} while (!queueRegistry.compare_exchange_weak(head, queue,
+					std::memory_order_release, std::memory_order_relaxed));
+		return queue;
+	}
+}
+
+// ============================================================================
+//                               THREAD QUEUE
+// ============================================================================
+
+/**
+ * @brief Allocates the ring.
+ * @param capacity Requested size in bytes (raised to a sane minimum).
+ */
+RELogger::Internal::ThreadQueue::ThreadQueue(std::size_t capacity)
+	: capacity(NormalizeCapacity(capacity)), buffer(new std::byte[this->capacity])
+{
+}
+
+/**
+ * @brief Reserves space for one entry after any entries already reserved.
+ *
+ * If the entry does not fit before the end of the ring, a wrap marker is
+ * placed in the tail and the entry starts at offset zero.
+ *
+ * @param size Entry size (multiple of QueueAlignment).
+ * @return Pointer to the reserved bytes, or nullptr if the ring is full.
+ */
+std::byte* RELogger::Internal::ThreadQueue::Reserve(std::size_t size)
+{
+	std::size_t offset = static_cast<std::size_t>(reservePos % capacity);
+	std::size_t toEnd = capacity - offset;
+	std::size_t needed = (size <= toEnd) ? size : toEnd + size;
+
+	if (reservePos + needed - cachedReadPos > capacity)
+	{
+		cachedReadPos = readPos.load(std::memory_order_acquire);
+		if (reservePos + needed - cachedReadPos > capacity)
+			return nullptr;
+	}
+
+	if (size > toEnd)
+	{
+		const std::uint32_t wrapMarker = 0;
+		std::memcpy(buffer.get() + offset, &wrapMarker, sizeof(wrapMarker));
+		reservePos += toEnd;
+		offset = 0;
+	}
+
+	reservePos += size;
+	return buffer.get() + offset;
+}
+
+/**
+ * @brief Makes all reserved entries visible to the consumer.
+ */
+void RELogger::Internal::ThreadQueue::Commit()
+{
+	writePos.store(reservePos, std::memory_order_release);
+}
+
+/**
+ * @brief Snapshots the producer's committed position.
+ */
+void RELogger::Internal::ThreadQueue::BeginRead()
+{
+	snapshotWritePos = writePos.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Returns the oldest unread entry, skipping wrap markers.
+ * @return The entry, or nullptr once the snapshot is exhausted.
+ */
+const RELogger::Internal::QueuedRecord* RELogger::Internal::ThreadQueue::Front()
+{
+	while (consumePos != snapshotWritePos)
+	{
+		std::size_t offset = static_cast<std::size_t>(consumePos % capacity);
+
+		std::uint32_t size;
+		std::memcpy(&size, buffer.get() + offset, sizeof(size));
+		if (size != 0)
+			return reinterpret_cast<const QueuedRecord*>(buffer.get() + offset);
+
+		consumePos += capacity - offset;
+		readPos.store(consumePos, std::memory_order_release);
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Consumes the entry last returned by Front.
+ */
+void RELogger::Internal::ThreadQueue::Pop()
+{
+	std::size_t offset = static_cast<std::size_t>(consumePos % capacity);
+	consumePos += reinterpret_cast<const QueuedRecord*>(buffer.get() + offset)->size;
+	readPos.store(consumePos, std::memory_order_release);
+}
+
+// ============================================================================
+//                                 REGISTRY
+// ============================================================================
+
+/**
+ * @brief Returns the calling thread's queue, claiming or creating one.
+ *
+ * Abandoned queues of the same capacity are reused before a new one is
+ * allocated, which bounds memory by the peak number of logging threads.
+ *
+ * @param capacity Ring size for a newly created queue.
+ * @return The queue, or nullptr if the thread is already past its
+ *         thread-local teardown.
+ */
+RELogger::Internal::ThreadQueue* RELogger::Internal::AcquireThreadQueue(std::size_t capacity)
+{
+	if (threadQueueState != QueueState::None)
+		return threadQueue;
+
+	ThreadQueue* queue = ClaimQueue(NormalizeCapacity(capacity), false);
+
+	(void)&threadQueueReleaser; // Registers the thread-exit release.
+	threadQueue = queue;
+	threadQueueState = QueueState::Owned;
+	return queue;
+}
+
+/**
+ * @brief Returns the first queue of the registry.
+ */
+RELogger::Internal::ThreadQueue* RELogger::Internal::FirstThreadQueue()
+{
+	return queueRegistry.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Switches the calling thread to a larger queue.
+ *
+ * Only empty abandoned queues are reused, so records of the thread never
+ * sit behind another thread's leftovers in a newer queue.
+ */
+RELogger::Internal::ThreadQueue* RELogger::Internal::GrowThreadQueue(std::size_t maxCapacity)
+{
+	ThreadQueue* current = threadQueue;
+	if (threadQueueState != QueueState::Owned || !current)
+		return nullptr;
+
+	const std::size_t capacity = std::min(current->Capacity() * 2, NormalizeCapacity(maxCapacity));
+	if (capacity <= current->Capacity())
+		return nullptr;
+
+	ThreadQueue* queue = ClaimQueue(capacity, true);
+	current->owned.store(false, std::memory_order_release);
+	threadQueue = queue;
+	queueGrowths.fetch_add(1, std::memory_order_relaxed);
+	return queue;
+}
+
+std::uint64_t RELogger::Internal::TakeQueueGrowths()
+{
+	return queueGrowths.exchange(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+//                                 PROFILE
+// ============================================================================
+
+void RELogger::Internal::QueueProfile::CountEntry(std::size_t size)
+{
+	++entrySizes[std::bit_width(size)];
+	largestEntry = std::max<std::uint64_t>(largestEntry, size);
+}
+
+std::uint64_t RELogger::Internal::QueueProfile::EntrySizePercentile(double fraction) const
+{
+	std::uint64_t total = 0;
+	for (std::uint64_t count : entrySizes)
+		total += count;
+
+	std::uint64_t seen = 0;
+	for (std::size_t bucket = 0; bucket < std::size(entrySizes); ++bucket)
+	{
+		seen += entrySizes[bucket];
+		if (total > 0 && static_cast<double>(seen) >= fraction * static_cast<double>(total))
+			return (std::uint64_t(1) << bucket) - 1;
+	}
+	return 0;
+}
+
+std::size_t RELogger::Internal::QueueProfile::SuggestedCapacity() const
+{
+	const std::uint64_t wanted = std::max({ peakPending * 2, largestEntry * 4, std::uint64_t(MinQueueCapacity) });
+	return static_cast<std::size_t>(std::bit_ceil(wanted));
+}
+
+void RELogger::Internal::QueueProfile::Merge(const QueueProfile& earlier)
+{
+	peakPending = std::max(peakPending, earlier.peakPending / 2);
+	largestEntry = std::max(largestEntry, earlier.largestEntry / 2);
+	peakPassRecords = std::max(peakPassRecords, earlier.peakPassRecords / 2);
+	for (std::size_t bucket = 0; bucket < std::size(entrySizes); ++bucket)
+		entrySizes[bucket] += earlier.entrySizes[bucket] / 2;
+}
+
+bool RELogger::Internal::LoadQueueProfile(const std::string& path, QueueProfile& profile)
+{
+	std::ifstream in(path);
+	if (!in)
+		return false;
+
+	std::string line;
+	while (std::getline(in, line))
+	{
+		std::istringstream fields(line);
+		std::string key;
+		fields >> key;
+
+		if (key == "peak_pending_bytes")
+			fields >> profile.peakPending;
+		else if (key == "largest_entry_bytes")
+			fields >> profile.largestEntry;
+		else if (key == "peak_pass_records")
+			fields >> profile.peakPassRecords;
+		else if (key == "records")
+			fields >> profile.records;
+		else if (key == "dropped")
+			fields >> profile.dropped;
+		else if (key == "queue_growths")
+			fields >> profile.growths;
+		else if (key == "entry_sizes")
+		{
+			std::string item;
+			while (fields >> item)
+			{
+				const std::size_t colon = item.find(':');
+				if (colon == std::string::npos)
+					continue;
+				const unsigned long bucket = std::strtoul(item.c_str(), nullptr, 10);
+				if (bucket < std::size(profile.entrySizes))
+					profile.entrySizes[bucket] = std::strtoull(item.c_str() + colon + 1, nullptr, 10);
+			}
+		}
+	}
+	return true;
+}
+
+bool RELogger::Internal::SaveQueueProfile(const std::string& path, const QueueProfile& profile)
+{
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream out(temporary, std::ios::trunc);
+		if (!out)
+			return false;
+
+		out << "# RELogger queue profile\n"
+			<< "peak_pending_bytes " << profile.peakPending << "\n"
+			<< "largest_entry_bytes " << profile.largestEntry << "\n"
+			<< "peak_pass_records " << profile.peakPassRecords << "\n"
+			<< "records " << profile.records << "\n"
+			<< "dropped " << profile.dropped << "\n"
+			<< "queue_growths " << profile.growths << "\n"
+			<< "entry_size_p50 " << profile.EntrySizePercentile(0.5) << "\n"
+			<< "entry_size_p99 " << profile.EntrySizePercentile(0.99) << "\n"
+			<< "suggested_capacity " << profile.SuggestedCapacity() << "\n"
+			<< "entry_sizes";
+		for (std::size_t bucket = 0; bucket < std::size(profile.entrySizes); ++bucket)
+		{
+			if (profile.entrySizes[bucket])
+				out << ' ' << bucket << ':' << profile.entrySizes[bucket];
+		}
+		out << "\n";
+		if (!out.flush())
+			return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	return !error;
+}
@@ -0,0 +1,318 @@
+/*
+===============================================================================
+
+  RELogger - Per-Thread Record Queues (C++ Header)
+  ------------------------------------------------
+
+  Single-producer / single-consumer byte rings used in asynchronous
+  mode. Every logging thread owns one queue; the backend thread is its
+  only consumer. Records are stored as a fixed header followed by the
+  raw payload bytes and are never formatted on the producer side.
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_QUEUE_H
+#define RELOGGER_QUEUE_H
+
+#include "relogger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      STRUCT: QueuedRecord
+      ---------------------------------------------------------------------
+      Header of a record inside a ThreadQueue. The payload bytes follow
+      immediately, then the context fields; the whole entry is padded to
+      QueueAlignment. The payload is the message text, or the encoded
+      arguments of a RELOG_*F site when formatId is set. Site strings are carried as
+      ids from relogger_intern.h rather than pointers.
+    =======================================================================
+    */
+    struct QueuedRecord
+    {
+        std::uint32_t size;         /**< Bytes taken by the entry; 0 marks a wrap to the ring start. */
+        std::uint32_t payloadSize;  /**< Length of the payload that follows. */
+        std::int64_t timestamp;     /**< Nanoseconds since the system_clock epoch. */
+        std::uint32_t fileId;       /**< Interned source file. */
+        std::uint32_t funcId;       /**< Interned function name. */
+        std::uint32_t formatId;     /**< Interned site format string; 0 for plain text. */
+        std::uint32_t categoryId;   /**< Interned site category; 0 for none. */
+        std::int32_t line;          /**< Source line. */
+        std::uint16_t contextSize;  /**< Length of the context fields that follow the payload. */
+        std::uint8_t level;         /**< Severity (LogLevel). */
+
+        const char* Payload() const { return reinterpret_cast<const char*>(this + 1); }
+        const char* Context() const { return Payload() + payloadSize; }
+    };
+
+    constexpr std::size_t QueueAlignment = alignof(QueuedRecord);
+    constexpr std::size_t MaxContextSize = 1024;  /**< Context bytes kept per queued record. */
+
+    /*
+    =======================================================================
+      FUNCTION: QueueEntrySize
+      ---------------------------------------------------------------------
+      @return Bytes a record with the given payload and context lengths
+              occupies.
+    =======================================================================
+    */
+    constexpr std::size_t QueueEntrySize(std::size_t payloadSize, std::size_t contextSize = 0)
+    {
+        return (sizeof(QueuedRecord) + payloadSize + contextSize + QueueAlignment - 1) & ~(QueueAlignment - 1);
+    }
+
+    /*
+    =======================================================================
+      CLASS: ThreadQueue
+      ---------------------------------------------------------------------
+      Bounded SPSC ring of QueuedRecords. Entries never straddle the end
+      of the ring; a zero-size marker sends the reader back to the start.
+      Producer and consumer state live on separate cache lines.
+    =======================================================================
+    */
+    class ThreadQueue
+    {
+    public:
+        explicit ThreadQueue(std::size_t capacity);
+
+        std::size_t Capacity() const { return capacity; }
+
+        // -- Producer side ----------------------------------------------
+
+        /*
+        ===================================================================
+          FUNCTION: Reserve
+          -----------------------------------------------------------------
+          @param size - Entry size from QueueEntrySize (at most half the
+                        capacity).
+          @return Space for the entry, or nullptr if the ring is full.
+                  Nothing is visible to the consumer until Commit.
+        ===================================================================
+        */
+        std::byte* Reserve(std::size_t size);
+
+        /*
+        ===================================================================
+          FUNCTION: Commit
+          -----------------------------------------------------------------
+          Publishes every entry reserved since the last Commit with a
+          single release store.
+        ===================================================================
+        */
+        void Commit();
+
+        void CountDrop() { dropped.fetch_add(1, std::memory_order_relaxed); }
+
+        // -- Consumer side ----------------------------------------------
+
+        /*
+        ===================================================================
+          FUNCTION: PendingBytes
+          -----------------------------------------------------------------
+          @return Ring bytes committed but not yet consumed.
+        ===================================================================
+        */
+        std::uint64_t PendingBytes() const { return writePos.load(std::memory_order_relaxed) - consumePos; }
+
+        /*
+        ===================================================================
+          FUNCTION: BeginRead
+          -----------------------------------------------------------------
+          Takes a snapshot of what the producer has committed. Front
+          only returns entries up to the latest snapshot.
+        ===================================================================
+        */
+        void BeginRead();
+
+        /*
+        ===================================================================
+          FUNCTION: Front
+          -----------------------------------------------------------------
+          @return The oldest unread entry of the snapshot, or nullptr.
+        ===================================================================
+        */
+        const QueuedRecord* Front();
+
+        /*
+        ===================================================================
+          FUNCTION: Pop
+          -----------------------------------------------------------------
+          Releases the entry returned by Front back to the producer.
+        ===================================================================
+        */
+        void Pop();
+
+        std::uint64_t TakeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+        /*
+        ===================================================================
+          FUNCTION: IsDrained
+          -----------------------------------------------------------------
+          @return True if the consumer has read everything committed.
+                  Called by a thread that has just claimed the queue.
+        ===================================================================
+        */
+        bool IsDrained() const
+        {
+            return readPos.load(std::memory_order_acquire) == writePos.load(std::memory_order_acquire);
+        }
+
+        // -- Registry ---------------------------------------------------
+
+        ThreadQueue* next = nullptr;       /**< Next queue in the global registry. */
+        std::atomic<bool> owned { true };  /**< Cleared when the producing thread exits. */
+
+    private:
+        const std::size_t capacity;
+        std::unique_ptr<std::byte[]> buffer;
+        std::atomic<std::uint64_t> dropped { 0 };
+
+        alignas(64) std::atomic<std::uint64_t> writePos { 0 }; ///< Committed end (producer-owned).
+        std::uint64_t reservePos = 0;                          ///< Reserved end, not yet committed.
+        std::uint64_t cachedReadPos = 0;                       ///< Producer's view of readPos.
+
+        alignas(64) std::atomic<std::uint64_t> readPos { 0 };  ///< Consumed end (consumer-owned).
+        std::uint64_t consumePos = 0;                          ///< Consumer's local read position.
+        std::uint64_t snapshotWritePos = 0;                    ///< writePos seen at BeginRead.
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: AcquireThreadQueue
+      ---------------------------------------------------------------------
+      Returns the calling thread's queue, claiming an abandoned one or
+      creating a new one on first use. Queues outlive their threads (a
+      queue left by an exiting thread is handed to the next new thread)
+      so the backend never races with thread exit.
+
+      @param capacity - Ring size for a newly created queue.
+    =======================================================================
+    */
+    ThreadQueue* AcquireThreadQueue(std::size_t capacity);
+
+    /*
+    =======================================================================
+      FUNCTION: FirstThreadQueue
+      ---------------------------------------------------------------------
+      @return Head of the registry of all queues ever created; follow
+              ThreadQueue::next to iterate. Never shrinks.
+    =======================================================================
+    */
+    ThreadQueue* FirstThreadQueue();
+
+    /*
+    =======================================================================
+      FUNCTION: GrowThreadQueue
+      ---------------------------------------------------------------------
+      Moves the calling thread to a queue twice the size of its current
+      one (at most maxCapacity), claiming an empty abandoned queue of
+      that size or creating one. The old queue is released with its
+      unread records, which the backend drains before the new queue's
+      (they are older, and DrainPass breaks timestamp ties in favor of
+      older queues). Everything reserved must be committed first.
+
+      @return The new queue, or nullptr if the current one is already
+              at maxCapacity.
+    =======================================================================
+    */
+    ThreadQueue* GrowThreadQueue(std::size_t maxCapacity);
+
+    /*
+    =======================================================================
+      FUNCTION: TakeQueueGrowths
+      ---------------------------------------------------------------------
+      @return GrowThreadQueue calls that succeeded since the last call.
+    =======================================================================
+    */
+    std::uint64_t TakeQueueGrowths();
+
+    /*
+    =======================================================================
+      STRUCT: QueueProfile
+      ---------------------------------------------------------------------
+      Load seen by the backend during one run, persisted between runs
+      (Config::queueProfilePath) to size the queues of the next one.
+      Entry sizes are counted per power-of-two class: entrySizes[b]
+      holds entries of 2^(b-1) to 2^b - 1 bytes.
+    =======================================================================
+    */
+    struct QueueProfile
+    {
+        std::uint64_t peakPending = 0;      /**< Most bytes one queue held at the start of a pass. */
+        std::uint64_t largestEntry = 0;     /**< Largest entry in bytes. */
+        std::uint64_t peakPassRecords = 0;  /**< Most records drained in one pass (burst size). */
+        std::uint64_t records = 0;
+        std::uint64_t dropped = 0;
+        std::uint64_t growths = 0;          /**< Queues grown because they were full. */
+        std::uint64_t entrySizes[33] = {};
+
+        void CountEntry(std::size_t size);
+
+        /*
+        ===================================================================
+          FUNCTION: EntrySizePercentile
+          -----------------------------------------------------------------
+          @param fraction - e.g. 0.99.
+          @return Upper bound of the size class holding that fraction of
+                  entries, or 0 without entries.
+        ===================================================================
+        */
+        std::uint64_t EntrySizePercentile(double fraction) const;
+
+        /*
+        ===================================================================
+          FUNCTION: SuggestedCapacity
+          -----------------------------------------------------------------
+          @return Power-of-two ring size holding twice the peak backlog
+                  and at least four of the largest entries.
+        ===================================================================
+        */
+        std::size_t SuggestedCapacity() const;
+
+        /*
+        ===================================================================
+          FUNCTION: Merge
+          -----------------------------------------------------------------
+          Folds in the profile of an earlier run at half weight, so a
+          spike is remembered for a few restarts and then fades.
+        ===================================================================
+        */
+        void Merge(const QueueProfile& earlier);
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: LoadQueueProfile / SaveQueueProfile
+      ---------------------------------------------------------------------
+      Reads or writes a profile as "key value" text lines. Saving writes
+      a temporary file and renames it over the old one.
+
+      @return False if the file could not be read or written.
+    =======================================================================
+    */
+    bool LoadQueueProfile(const std::string& path, QueueProfile& profile);
+    bool SaveQueueProfile(const std::string& path, const QueueProfile& profile);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_QUEUE_H */
@@ -0,0 +1,85 @@
+/**
+ * @file relogger_shm.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Named shared-memory regions for pages read by external tools.
+ */
+
+#include "relogger_internal.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Creates and maps a zero-filled named region.
+ *
+ * A region of the same name left by an earlier process (same pid) is
+ * replaced. On Windows the mapping handle stays open, so the name lives
+ * as long as the process.
+ *
+ * @param name shm_open / file mapping name.
+ * @param size Bytes to map.
+ * @return The mapping, or nullptr if shared memory is unavailable.
+ */
+void* RELogger::Internal::CreateSharedMemory(const std::string& name, std::size_t size)
+{
+#ifdef _WIN32
+	HANDLE handle = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		0, static_cast<DWORD>(size), name.c_str());
+	if (!handle)
+		return nullptr;
+	return ::MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+#else
+	::shm_unlink(name.c_str());
+	const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+		return nullptr;
+
+	void* view = MAP_FAILED;
+	if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+		view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (view == MAP_FAILED)
+	{
+		::shm_unlink(name.c_str());
+		return nullptr;
+	}
+	return view;
+#endif
+}
+
+/**
+ * @brief Removes a region's name; existing mappings stay valid.
+ */
+void RELogger::Internal::RemoveSharedMemory(const std::string& name)
+{
+#ifndef _WIN32
+	::shm_unlink(name.c_str());
+#else
+	(void)name;
+#endif
+}
+
+/**
+ * @brief Returns the id the page names are built from.
+ */
+std::uint64_t RELogger::Internal::CurrentProcessId()
+{
+#ifdef _WIN32
+	return ::GetCurrentProcessId();
+#else
+	return static_cast<std::uint64_t>(::getpid());
+#endif
+}
@@ -0,0 +1,649 @@
+/**
+ * @file relogger_sink.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Built-in output sinks for the RELogger system.
+ *
+ * Each sink owns its destination and serializes its own writes, so the
+ * logger itself never needs a global lock to emit a record.
+ */
+
+#include "relogger_sink.h"
+#include "relogger_stack.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+// ============================================================================
+//                              LEVEL HELPERS
+// ============================================================================
+
+/**
+ * @brief Converts a LogLevel enum to its string representation.
+ * @param level The log level to convert.
+ * @return A constant C-string corresponding to the log level.
+ */
+const char* RELogger::LevelToString(LogLevel level)
+{
+	switch (level)
+	{
+		case LogLevel::Trace: return "TRACE";
+		case LogLevel::Debug: return "DEBUG";
+		case LogLevel::Info:  return "INFO";
+		case LogLevel::Warn:  return "WARN";
+		case LogLevel::Error: return "ERROR";
+		case LogLevel::Fatal: return "FATAL";
+		default: return "UNKNOWN";
+	}
+}
+
+/**
+ * @brief Maps each LogLevel to a specific ANSI color code for terminal output.
+ * @param level The log level.
+ * @return The corresponding ANSI escape sequence for color.
+ */
+const char* RELogger::LevelToColor(LogLevel level)
+{
+	switch (level)
+	{
+		case LogLevel::Trace: return "\033[37m"; // White
+		case LogLevel::Debug: return "\033[36m"; // Cyan
+		case LogLevel::Info:  return "\033[32m"; // Green
+		case LogLevel::Warn:  return "\033[33m"; // Yellow
+		case LogLevel::Error: return "\033[31m"; // Red
+		case LogLevel::Fatal: return "\033[41m"; // Red background
+		default: return "\033[0m";               // Reset
+	}
+}
+
+// ============================================================================
+//                              CONSOLE SINK
+// ============================================================================
+
+/**
+ * @brief Writes a colorized record to stdout, or stderr for Error and above.
+ * @param record The record to write.
+ */
+void RELogger::ConsoleSink::Write(const LogRecord& record)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::ostream& out = (record.level >= LogLevel::Error) ? std::cerr : std::cout;
+	out << LevelToColor(record.level) << record.text << "\033[0m" << std::endl;
+}
+
+/**
+ * @brief Flushes both console streams.
+ */
+void RELogger::ConsoleSink::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::cout.flush();
+	std::cerr.flush();
+}
+
+// ============================================================================
+//                                FILE SINK
+// ============================================================================
+
+/**
+ * @brief Creates a sink for the given path and, unless deferred, opens it.
+ *
+ * Failure to open is reported on stderr; the sink then silently discards
+ * records so that a bad path never takes logging down with it.
+ *
+ * @param path Path to the log file.
+ * @param options Open and flush behavior.
+ */
+RELogger::FileSink::FileSink(const std::string& path, const FileSinkOptions& options)
+	: path(path), options(options), openAttempted(false)
+{
+	if (!options.deferOpen)
+		OpenLocked();
+}
+
+/**
+ * @brief Writes any partial block and the block index, then flushes and
+ *        closes the file.
+ */
+RELogger::FileSink::~FileSink()
+{
+	if (file.is_open())
+	{
+		if (options.compressBlocks)
+		{
+			if (!block.empty())
+				WriteBlockLocked();
+			packed.clear();
+			Internal::AppendLogBlockIndex(packed, blocksWritten, fileOffset);
+			file.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+		}
+		file.flush();
+		file.close();
+	}
+}
+
+/**
+ * @brief Opens the file now if it has not been opened yet.
+ */
+void RELogger::FileSink::Open()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	OpenLocked();
+}
+
+/**
+ * @brief Creates missing parent directories and opens (or overwrites) the file.
+ *
+ * Runs at most once; the caller holds the sink mutex (or is the constructor).
+ */
+void RELogger::FileSink::OpenLocked()
+{
+	if (openAttempted)
+		return;
+	openAttempted = true;
+
+	std::error_code error;
+	std::filesystem::path parent = std::filesystem::path(path).parent_path();
+	if (!parent.empty())
+		std::filesystem::create_directories(parent, error);
+
+	const std::ios::openmode mode = options.compressBlocks
+		? std::ios::out | std::ios::trunc | std::ios::binary
+		: std::ios::out | std::ios::trunc;
+	file.open(path, mode);
+	if (!file)
+	{
+		std::cerr << "\033[31m[LOGGER ERROR] Failed to open log file: "
+				  << path << "\033[0m" << std::endl;
+		return;
+	}
+
+	if (options.compressBlocks)
+	{
+		packed.clear();
+		Internal::AppendBlockLogHeader(packed);
+		file.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+		fileOffset = packed.size();
+	}
+}
+
+/**
+ * @brief Compresses the collected lines into one block and writes it.
+ */
+void RELogger::FileSink::WriteBlockLocked()
+{
+	packed.clear();
+	LogBlockInfo info = Internal::AppendLogBlock(packed, block, blockFirstTime, blockLastTime);
+	file.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+	block.clear();
+
+	info.offset = fileOffset;
+	fileOffset += packed.size();
+	blocksWritten.push_back(info);
+}
+
+/**
+ * @brief Writes the partial block, or only one that has waited
+ *        blockFlushInterval, then flushes the stream.
+ * @param partial True to write the partial block whatever its age.
+ */
+void RELogger::FileSink::FlushLocked(bool partial)
+{
+	if (!block.empty() && (partial || std::chrono::steady_clock::now() - blockStarted >= options.blockFlushInterval))
+		WriteBlockLocked();
+	file.flush();
+}
+
+/**
+ * @brief Appends a plain-text record to the file.
+ *
+ * A deferred sink that has not been opened yet opens itself here. A
+ * record carrying a captured stack is preceded by the module map, once
+ * per file and again after libraries were loaded or unloaded.
+ *
+ * @param record The record to write.
+ */
+void RELogger::FileSink::Write(const LogRecord& record)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	OpenLocked();
+	if (!file.is_open())
+		return;
+
+	std::string modules;
+	if (Internal::HasStackField(record.context))
+	{
+		const std::uint64_t version = Internal::ModuleMapVersion();
+		if (version != modulesWritten)
+		{
+			Internal::AppendModuleMap(modules);
+			modulesWritten = version;
+		}
+	}
+
+	if (!options.compressBlocks)
+	{
+		file << modules << record.text << '\n';
+		if (options.flushEachRecord)
+			file.flush();
+		return;
+	}
+
+	const std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		record.time.time_since_epoch()).count();
+	if (block.empty())
+	{
+		blockFirstTime = timestamp;
+		blockLastTime = timestamp;
+		blockStarted = std::chrono::steady_clock::now();
+	}
+	blockFirstTime = std::min(blockFirstTime, timestamp);
+	blockLastTime = std::max(blockLastTime, timestamp);
+	block += modules;
+	block += record.text;
+	block += '\n';
+
+	// Errors are written at once so they survive a crash that follows.
+	if (block.size() >= options.blockSize || record.level >= LogLevel::Error)
+	{
+		WriteBlockLocked();
+		file.flush();
+	}
+	else if (options.flushEachRecord)
+	{
+		FlushLocked(false);
+	}
+}
+
+/**
+ * @brief Flushes the file stream, writing any partial block first.
+ */
+void RELogger::FileSink::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (file.is_open())
+		FlushLocked(true);
+}
+
+/**
+ * @brief Flushes the file stream, writing a partial block first if it is stale.
+ * @return True if a younger partial block is still held.
+ */
+bool RELogger::FileSink::FlushPeriodic()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!file.is_open())
+		return false;
+	FlushLocked(false);
+	return !block.empty();
+}
+
+/**
+ * @brief Reports whether the file was opened successfully.
+ * @return True if records are being written to disk.
+ */
+bool RELogger::FileSink::IsOpen() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return file.is_open();
+}
+
+// ============================================================================
+//                               MEMORY SINK
+// ============================================================================
+
+/**
+ * @brief Creates an empty ring.
+ * @param capacity Number of lines kept (at least one).
+ */
+RELogger::MemorySink::MemorySink(std::size_t capacity)
+	: capacity(capacity > 0 ? capacity : 1)
+{
+}
+
+/**
+ * @brief Stores a record's line, replacing the oldest when full.
+ */
+void RELogger::MemorySink::Write(const LogRecord& record)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (lines.size() < capacity)
+	{
+		lines.emplace_back(record.text);
+		return;
+	}
+
+	lines[next].assign(record.text);
+	next = (next + 1) % capacity;
+}
+
+/**
+ * @brief Copies the kept lines, oldest first.
+ */
+std::vector<std::string> RELogger::MemorySink::Lines() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<std::string> ordered;
+	ordered.reserve(lines.size());
+	for (std::size_t i = 0; i < lines.size(); ++i)
+		ordered.push_back(lines[(next + i) % lines.size()]);
+	return ordered;
+}
+
+// ============================================================================
+//                               FILTER SINK
+// ============================================================================
+
+/**
+ * @brief Wraps a sink with a level and category rule.
+ * @param target Sink that receives matching records.
+ * @param minLevel Lowest level passed on.
+ * @param category "", an exact category, or a "prefix.*" rule.
+ */
+RELogger::FilterSink::FilterSink(std::shared_ptr<Sink> target, LogLevel minLevel, std::string category)
+	: target(std::move(target)), minLevel(minLevel), category(std::move(category)), includeChildren(false)
+{
+	if (this->category == "*")
+	{
+		this->category.clear();
+	}
+	else if (this->category.size() >= 2 && this->category.ends_with(".*"))
+	{
+		this->category.resize(this->category.size() - 2);
+		includeChildren = true;
+	}
+}
+
+/**
+ * @brief Checks a record against the level and category rule.
+ */
+bool RELogger::FilterSink::Matches(const LogRecord& record) const
+{
+	if (record.level < minLevel)
+		return false;
+	if (category.empty())
+		return true;
+	if (!record.category)
+		return false;
+
+	const std::string_view name = record.category;
+	if (name == category)
+		return true;
+	return includeChildren && name.size() > category.size()
+		&& name.starts_with(category) && name[category.size()] == '.';
+}
+
+/**
+ * @brief Forwards a matching record to the wrapped sink.
+ */
+void RELogger::FilterSink::Write(const LogRecord& record)
+{
+	if (Matches(record))
+		target->Write(record);
+}
+
+/**
+ * @brief Flushes the wrapped sink.
+ */
+void RELogger::FilterSink::Flush()
+{
+	target->Flush();
+}
+
+/**
+ * @brief Routinely flushes the wrapped sink.
+ */
+bool RELogger::FilterSink::FlushPeriodic()
+{
+	return target->FlushPeriodic();
+}
+
+/**
+ * @brief Opens the wrapped sink.
+ */
+void RELogger::FilterSink::Open()
+{
+	target->Open();
+}
+
+// ============================================================================
+//                              RECORD BATCH
+// ============================================================================
+
+/**
+ * @brief Copies a record's views into the batch.
+ */
+void RELogger::RecordBatch::Add(const LogRecord& record)
+{
+	entries.push_back(Entry { record.level, record.time, record.file, record.line, record.func,
+		record.format, record.category, bytes.size(), record.message.size(), record.text.size(),
+		record.args.size(), record.context.size() });
+	bytes += record.message;
+	bytes += record.text;
+	bytes += record.args;
+	bytes += record.context;
+}
+
+RELogger::LogRecord RELogger::RecordBatch::Record(std::size_t i) const
+{
+	const Entry& entry = entries[i];
+	const char* data = bytes.data() + entry.offset;
+	const std::string_view message(data, entry.messageSize);
+	const std::string_view text(data + entry.messageSize, entry.textSize);
+	const std::string_view args(data + entry.messageSize + entry.textSize, entry.argsSize);
+	const std::string_view context(data + entry.messageSize + entry.textSize + entry.argsSize, entry.contextSize);
+
+	return LogRecord { entry.level, entry.time, entry.file, entry.line, entry.func,
+		message, text, entry.format, args, entry.category, context };
+}
+
+// ============================================================================
+//                              THREADED SINK
+// ============================================================================
+
+namespace
+{
+	constexpr std::chrono::milliseconds HeldOutputRetry { 10 }; ///< Idle writer's FlushPeriodic interval while output is held.
+}
+
+/**
+ * @brief Starts the writer thread. The wrapped sink is opened by Open.
+ */
+RELogger::ThreadedSink::ThreadedSink(std::shared_ptr<Sink> target, std::size_t maxLag, SinkOverrunPolicy overrun)
+	: target(std::move(target)), maxLag(maxLag), overrun(overrun), writer(&ThreadedSink::Run, this)
+{
+}
+
+/**
+ * @brief Writes and flushes everything still pending, then joins the writer.
+ */
+RELogger::ThreadedSink::~ThreadedSink()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	progress.notify_all();
+	writer.join();
+}
+
+/**
+ * @brief Posts a single record (used outside the backend's batches).
+ */
+void RELogger::ThreadedSink::Write(const LogRecord& record)
+{
+	std::shared_ptr<RecordBatch> batch = std::make_shared<RecordBatch>();
+	batch->Add(record);
+	Post(std::move(batch));
+}
+
+/**
+ * @brief Has the writer open the wrapped sink before its next record.
+ */
+void RELogger::ThreadedSink::Open()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		openRequested = true;
+	}
+	wake.notify_one();
+}
+
+/**
+ * @brief Waits until every record posted so far is written and flushed.
+ */
+void RELogger::ThreadedSink::Flush()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	const std::uint64_t through = accepted;
+	if (flushedThrough >= through)
+		return;
+
+	flushThrough = std::max(flushThrough, through);
+	wake.notify_one();
+	progress.wait(lock, [this, through] { return flushedThrough >= through; });
+}
+
+void RELogger::ThreadedSink::Post(std::shared_ptr<const RecordBatch> batch)
+{
+	const std::uint64_t size = batch->Size();
+	if (size == 0)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (pending > 0 && pending + size > maxLag)
+		{
+			switch (overrun)
+			{
+			case SinkOverrunPolicy::Block:
+				progress.wait(lock, [this, size] { return pending == 0 || pending + size <= maxLag || stopping; });
+				break;
+
+			case SinkOverrunPolicy::DropOldest:
+				while (!inbox.empty() && pending + size > maxLag)
+				{
+					const std::uint64_t dropped = inbox.front()->Size();
+					inbox.pop_front();
+					pending -= dropped;
+					finished += dropped;
+					skipped += dropped;
+					unreported += dropped;
+				}
+				break;
+
+			case SinkOverrunPolicy::DropNewest:
+				skipped += size;
+				unreported += size;
+				return;
+			}
+		}
+
+		inbox.push_back(std::move(batch));
+		pending += size;
+		accepted += size;
+	}
+	wake.notify_one();
+}
+
+RELogger::SinkLag RELogger::ThreadedSink::Lag() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return SinkLag { pending, written, skipped };
+}
+
+/**
+ * @brief Body of the writer thread.
+ *
+ * Writes batches in order. A waiting Flush gets a full flush of the
+ * wrapped sink as soon as every record posted before it is finished,
+ * even if newer batches are queued; so does the stop. Otherwise, whenever
+ * the writer runs out of work the wrapped sink gets a FlushPeriodic,
+ * repeated every HeldOutputRetry while it still holds output back.
+ * Exits only once the inbox is empty.
+ */
+void RELogger::ThreadedSink::Run()
+{
+	const auto ready = [this] { return stopping || openRequested || flushThrough > flushedThrough || !inbox.empty(); };
+	bool holding = false;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		if (!holding)
+		{
+			wake.wait(lock, ready);
+		}
+		else if (!wake.wait_for(lock, HeldOutputRetry, ready))
+		{
+			lock.unlock();
+			holding = target->FlushPeriodic();
+			lock.lock();
+			continue;
+		}
+
+		if (openRequested)
+		{
+			openRequested = false;
+			lock.unlock();
+			target->Open();
+			lock.lock();
+			continue;
+		}
+
+		if (!inbox.empty())
+		{
+			const std::shared_ptr<const RecordBatch> batch = std::move(inbox.front());
+			inbox.pop_front();
+			const std::uint64_t dropped = std::exchange(unreported, 0);
+			lock.unlock();
+
+			if (dropped > 0)
+			{
+				const std::string notice = "[LOGGER WARNING] " + std::to_string(dropped)
+					+ " records skipped; sink writer fell behind";
+				target->Write(LogRecord { LogLevel::Warn, batch->Record(0).time, "", 0, "", notice, notice });
+			}
+			for (std::size_t i = 0; i < batch->Size(); ++i)
+				target->Write(batch->Record(i));
+
+			lock.lock();
+			pending -= batch->Size();
+			finished += batch->Size();
+			written += batch->Size();
+			progress.notify_all();
+			const bool flushDue = flushThrough > flushedThrough && finished >= flushThrough;
+			if (!inbox.empty() && !flushDue)
+				continue;
+			if (!flushDue && !stopping)
+			{
+				lock.unlock();
+				holding = target->FlushPeriodic();
+				lock.lock();
+				continue;
+			}
+		}
+		else if (flushThrough <= flushedThrough)
+		{
+			if (holding)
+			{
+				lock.unlock();
+				target->Flush();
+				lock.lock();
+			}
+			break; // stopping with nothing left
+		}
+
+		const std::uint64_t through = finished;
+		lock.unlock();
+		target->Flush();
+		lock.lock();
+		holding = false;
+		flushedThrough = through;
+		progress.notify_all();
+	}
+}
@@ -0,0 +1,463 @@
+/*
+===============================================================================
+
+  RELogger - Sink Interface (C++ Header)
+  --------------------------------------
+
+  Output destinations for the RELogger system. Every record passed to
+  RELogger::Log is formatted once into a plain-text line and handed to
+  each sink in the active sink set, which may be changed at runtime
+  through RELogger::AddSink / RELogger::RemoveSink.
+
+  Built-in sinks:
+    - ConsoleSink : color-coded stdout/stderr output
+    - FileSink    : plain-text file output (optionally deferred open)
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_SINK_H
+#define RELOGGER_SINK_H
+
+#include "relogger.h"
+#include "relogger_block.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace RELogger
+{
+    /*
+    =======================================================================
+      STRUCT: LogRecord
+      ---------------------------------------------------------------------
+      A single log event as seen by a sink. All views are only valid for
+      the duration of the Sink::Write call.
+    =======================================================================
+    */
+    struct LogRecord
+    {
+        LogLevel level;                              /**< Severity of the record. */
+        std::chrono::system_clock::time_point time;  /**< Time the record was logged. */
+        const char* file;                            /**< Source file of the log call. */
+        int line;                                    /**< Source line of the log call. */
+        const char* func;                            /**< Function of the log call. */
+        std::string_view message;                    /**< Message text (placeholders already substituted). */
+        std::string_view text;                       /**< Formatted plain line, no newline. */
+        const char* format = nullptr;                /**< Site format string, or nullptr for plain messages. */
+        std::string_view args {};                    /**< Encoded arguments when format is set (relogger_format.h). */
+        const char* category = nullptr;              /**< Site category (string literal), or nullptr. */
+        std::string_view context {};                 /**< Fields of the logging task's LogContext (relogger_coroutine.h), or empty. */
+    };
+
+    /*
+    =======================================================================
+      CLASS: Sink
+      ---------------------------------------------------------------------
+      Base class for all log outputs. Write may be called concurrently
+      from several threads, so implementations must serialize their own
+      output.
+    =======================================================================
+    */
+    class Sink
+    {
+    public:
+        virtual ~Sink() = default;
+
+        /*
+        ===================================================================
+          FUNCTION: Write
+          -----------------------------------------------------------------
+          Outputs a single record.
+
+          @param record - The record to write.
+        ===================================================================
+        */
+        virtual void Write(const LogRecord& record) = 0;
+
+        /*
+        ===================================================================
+          FUNCTION: Open
+          -----------------------------------------------------------------
+          Performs deferred setup such as opening a file. In asynchronous
+          mode the backend calls it for every sink of the initial set
+          before the first Write, keeping slow I/O off the Init caller.
+        ===================================================================
+        */
+        virtual void Open() {}
+
+        /*
+        ===================================================================
+          FUNCTION: Flush
+          -----------------------------------------------------------------
+          Pushes all buffered output to its destination, including any
+          partial unit the sink is still collecting.
+        ===================================================================
+        */
+        virtual void Flush() {}
+
+        /*
+        ===================================================================
+          FUNCTION: FlushPeriodic
+          -----------------------------------------------------------------
+          Routine flush between records. The default calls Flush; a sink
+          that collects output into larger units may keep a young partial
+          unit for later.
+
+          @return True if output is still held back, so the caller should
+                  call again later even without new records.
+        ===================================================================
+        */
+        virtual bool FlushPeriodic()
+        {
+            Flush();
+            return false;
+        }
+    };
+
+    /*
+    =======================================================================
+      CLASS: ConsoleSink
+      ---------------------------------------------------------------------
+      Writes color-coded records to the terminal. Error and Fatal go to
+      stderr, everything else to stdout.
+    =======================================================================
+    */
+    class ConsoleSink final : public Sink
+    {
+    public:
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+
+    private:
+        std::mutex mutex; ///< Keeps lines from different threads whole.
+    };
+
+    /*
+    =======================================================================
+      STRUCT: FileSinkOptions
+      ---------------------------------------------------------------------
+      Construction options for FileSink.
+
+      With compressBlocks set, lines are collected into blocks of about
+      blockSize bytes and each block is compressed and written whole (see
+      relogger_block.h). A partial block is written early when an Error
+      or Fatal record arrives, on Flush, on FlushPeriodic once it is
+      older than blockFlushInterval, and when the sink is destroyed. On
+      destruction an index of all blocks is appended so readers can find
+      a time range without scanning the file.
+    =======================================================================
+    */
+    struct FileSinkOptions
+    {
+        bool deferOpen = false;       /**< Open on the first Open/Write call instead of in the constructor. */
+        bool flushEachRecord = true;  /**< Flush after every record; otherwise only on Flush. */
+        bool compressBlocks = false;  /**< Write LZ-compressed blocks instead of plain text. */
+        std::size_t blockSize = 64 * 1024;                     /**< Uncompressed bytes per block. */
+        std::chrono::milliseconds blockFlushInterval { 1000 }; /**< Age at which FlushPeriodic writes a partial block. */
+    };
+
+    /*
+    =======================================================================
+      CLASS: FileSink
+      ---------------------------------------------------------------------
+      Writes plain-text records to a file, truncating it on open. Missing
+      parent directories are created when the file is opened.
+
+      @param path    - Path of the file to write.
+      @param options - Open and flush behavior.
+    =======================================================================
+    */
+    class FileSink final : public Sink
+    {
+    public:
+        explicit FileSink(const std::string& path, const FileSinkOptions& options = FileSinkOptions());
+        ~FileSink() override;
+
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+        bool FlushPeriodic() override;
+
+        /*
+        ===================================================================
+          FUNCTION: Open
+          -----------------------------------------------------------------
+          Creates the parent directories and opens the file, if that has
+          not happened yet.
+        ===================================================================
+        */
+        void Open() override;
+
+        /*
+        ===================================================================
+          FUNCTION: IsOpen
+          -----------------------------------------------------------------
+          @return True if the file was opened successfully.
+        ===================================================================
+        */
+        bool IsOpen() const;
+
+    private:
+        void OpenLocked();
+        void FlushLocked(bool partial);
+        void WriteBlockLocked();
+
+        std::string path;         ///< Path of the log file.
+        FileSinkOptions options;  ///< Behavior chosen at construction.
+        bool openAttempted;       ///< Set once the file has been opened (or failed to).
+        std::ofstream file;       ///< Output stream for the log file.
+        std::string block;        ///< Lines of the block being collected (compressBlocks).
+        std::string packed;       ///< Reused buffer for the encoded block.
+        std::int64_t blockFirstTime = 0; ///< Earliest record timestamp of the block (ns).
+        std::int64_t blockLastTime = 0;  ///< Latest record timestamp of the block (ns).
+        std::chrono::steady_clock::time_point blockStarted; ///< When the block got its first line.
+        std::uint64_t fileOffset = 0;    ///< Bytes written so far (compressBlocks).
+        std::vector<LogBlockInfo> blocksWritten; ///< Index of the blocks written so far.
+        std::uint64_t modulesWritten = 0; ///< ModuleMapVersion of the last module map written.
+        mutable std::mutex mutex; ///< Serializes writes from concurrent loggers.
+    };
+
+    /*
+    =======================================================================
+      CLASS: MemorySink
+      ---------------------------------------------------------------------
+      Keeps the most recent lines in memory, overwriting the oldest once
+      full. Useful as Config::stallFallback or for tests.
+
+      @param capacity - Number of lines kept.
+    =======================================================================
+    */
+    class MemorySink final : public Sink
+    {
+    public:
+        explicit MemorySink(std::size_t capacity = 4096);
+
+        void Write(const LogRecord& record) override;
+
+        /*
+        ===================================================================
+          FUNCTION: Lines
+          -----------------------------------------------------------------
+          @return The kept lines, oldest first.
+        ===================================================================
+        */
+        std::vector<std::string> Lines() const;
+
+    private:
+        std::vector<std::string> lines; ///< Ring storage.
+        std::size_t capacity;           ///< Maximum number of lines kept.
+        std::size_t next = 0;           ///< Slot the next line goes to once full.
+        mutable std::mutex mutex;       ///< Guards the ring.
+    };
+
+    /*
+    =======================================================================
+      CLASS: FilterSink
+      ---------------------------------------------------------------------
+      Passes on only the records at or above a level and, optionally, in
+      a category. Used by Init for Config::fileRoutes.
+
+      @param target   - Sink that receives the matching records.
+      @param minLevel - Lowest level passed on.
+      @param category - "" for any record, "net" for exactly "net", or
+                        "net.*" for "net" and every "net.<...>".
+    =======================================================================
+    */
+    class FilterSink final : public Sink
+    {
+    public:
+        FilterSink(std::shared_ptr<Sink> target, LogLevel minLevel, std::string category = std::string());
+
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+        bool FlushPeriodic() override;
+        void Open() override;
+
+        /*
+        ===================================================================
+          FUNCTION: Matches
+          -----------------------------------------------------------------
+          @return True if the record passes the level and category rule.
+        ===================================================================
+        */
+        bool Matches(const LogRecord& record) const;
+
+    private:
+        std::shared_ptr<Sink> target;  ///< Destination for matching records.
+        LogLevel minLevel;             ///< Lowest level passed on.
+        std::string category;          ///< Category or prefix, without a trailing ".*".
+        bool includeChildren;          ///< True if the rule ended in ".*".
+    };
+
+    /*
+    =======================================================================
+      CLASS: RecordBatch
+      ---------------------------------------------------------------------
+      Owned copies of records written by the backend in one pass. A
+      batch is immutable once posted and shared by every ThreadedSink.
+    =======================================================================
+    */
+    class RecordBatch
+    {
+    public:
+        void Add(const LogRecord& record);
+        std::size_t Size() const { return entries.size(); }
+
+        /*
+        ===================================================================
+          FUNCTION: Record
+          -----------------------------------------------------------------
+          @return Record i; views point into the batch.
+        ===================================================================
+        */
+        LogRecord Record(std::size_t i) const;
+
+    private:
+        struct Entry
+        {
+            LogLevel level;
+            std::chrono::system_clock::time_point time;
+            const char* file;
+            int line;
+            const char* func;
+            const char* format;
+            const char* category;
+            std::size_t offset;       ///< Message, text, args and context follow in bytes.
+            std::size_t messageSize;
+            std::size_t textSize;
+            std::size_t argsSize;
+            std::size_t contextSize;
+        };
+
+        std::vector<Entry> entries;
+        std::string bytes;
+    };
+
+    /*
+    =======================================================================
+      STRUCT: SinkLag
+      ---------------------------------------------------------------------
+      How far a ThreadedSink's writer is behind the backend.
+    =======================================================================
+    */
+    struct SinkLag
+    {
+        std::uint64_t pending = 0;  /**< Records posted and not yet written. */
+        std::uint64_t written = 0;  /**< Records handed to the wrapped sink. */
+        std::uint64_t skipped = 0;  /**< Records dropped by the overrun policy. */
+    };
+
+    /*
+    =======================================================================
+      CLASS: ThreadedSink
+      ---------------------------------------------------------------------
+      Runs another sink on a writer thread of its own, so a slow
+      destination only falls behind instead of holding up the backend
+      and the other sinks. The backend posts each pass's records as one
+      shared RecordBatch; the writer works through its own list of
+      batches. Used by Init for Config::sinkThreads.
+
+      Flush returns once every record posted before it has been written
+      and the wrapped sink flushed. Between flushes the writer calls the
+      wrapped sink's FlushPeriodic whenever it runs out of work. When more than maxLag records are
+      pending, overrun decides between waiting, dropping the oldest
+      batches and dropping the new one; the writer reports drops with a
+      notice in its own output.
+
+      @param target  - Sink run on the writer thread.
+      @param maxLag  - Pending records before the overrun policy applies.
+      @param overrun - What Post does when the writer is that far behind.
+    =======================================================================
+    */
+    class ThreadedSink final : public Sink
+    {
+    public:
+        ThreadedSink(std::shared_ptr<Sink> target, std::size_t maxLag = 64 * 1024,
+            SinkOverrunPolicy overrun = SinkOverrunPolicy::DropOldest);
+        ~ThreadedSink() override;
+
+        ThreadedSink(const ThreadedSink&) = delete;
+        ThreadedSink& operator=(const ThreadedSink&) = delete;
+
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+        void Open() override;
+
+        /*
+        ===================================================================
+          FUNCTION: Post
+          -----------------------------------------------------------------
+          Queues a batch for the writer without copying it.
+        ===================================================================
+        */
+        void Post(std::shared_ptr<const RecordBatch> batch);
+
+        SinkLag Lag() const;
+
+    private:
+        void Run();
+
+        std::shared_ptr<Sink> target;     ///< Only touched by the writer thread.
+        std::size_t maxLag;
+        SinkOverrunPolicy overrun;
+
+        mutable std::mutex mutex;         ///< Guards everything below.
+        std::condition_variable wake;     ///< Signals the writer about work or stop.
+        std::condition_variable progress; ///< Signals Post and Flush about written records.
+        std::deque<std::shared_ptr<const RecordBatch>> inbox;
+        std::uint64_t pending = 0;        ///< Records in inbox.
+        std::uint64_t accepted = 0;       ///< Records ever queued.
+        std::uint64_t finished = 0;       ///< Queued records written or dropped.
+        std::uint64_t flushThrough = 0;   ///< accepted as of the latest Flush call.
+        std::uint64_t flushedThrough = 0; ///< finished as of the last completed flush.
+        std::uint64_t written = 0;
+        std::uint64_t skipped = 0;
+        std::uint64_t unreported = 0;     ///< Drops the writer has not announced yet.
+        bool openRequested = false;
+        bool stopping = false;
+        std::thread writer;               ///< Started last, joined by the destructor.
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: LevelToString
+      ---------------------------------------------------------------------
+      @param level - The log level to convert.
+      @return The upper-case name of the level (e.g. "WARN").
+    =======================================================================
+    */
+    const char* LevelToString(LogLevel level);
+
+    /*
+    =======================================================================
+      FUNCTION: LevelToColor
+      ---------------------------------------------------------------------
+      @param level - The log level to convert.
+      @return The ANSI escape sequence used for the level on a terminal.
+    =======================================================================
+    */
+    const char* LevelToColor(LogLevel level);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_SINK_H */
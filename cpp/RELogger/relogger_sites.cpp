@@ -0,0 +1,357 @@
+/**
+ * @file relogger_sites.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief The linker-built site table and its reader for ELF files.
+ *
+ * At run time the table is just the section between two linker symbols.
+ * Offline, ReadBinarySites follows the same pointers through the file:
+ * section entry -> LogSite -> strings, translating addresses with the
+ * program headers.
+ */
+
+#include "relogger_sites.h"
+#include "relogger_format.h"
+#include "relogger_stack.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(RELOGGER_SITE_SECTION)
+extern "C"
+{
+	// Defined by the linker when the section exists; weak so that a
+	// program without RELOG_*F sites still links.
+	extern const RELogger::LogSite* const __start_relogger_sites[] __attribute__((weak, visibility("hidden")));
+	extern const RELogger::LogSite* const __stop_relogger_sites[] __attribute__((weak, visibility("hidden")));
+}
+#endif
+
+// LogSite as ReadBinarySites expects it: level, then pointer-aligned fields.
+static_assert(offsetof(RELogger::LogSite, file) == sizeof(void*));
+static_assert(offsetof(RELogger::LogSite, line) == 2 * sizeof(void*));
+static_assert(offsetof(RELogger::LogSite, func) == 2 * sizeof(void*) + (sizeof(void*) > 4 ? sizeof(void*) : 4));
+static_assert(offsetof(RELogger::LogSite, format) == offsetof(RELogger::LogSite, func) + sizeof(void*));
+static_assert(offsetof(RELogger::LogSite, category) == offsetof(RELogger::LogSite, format) + sizeof(void*));
+
+namespace
+{
+	constexpr std::size_t MaxSiteString = 64 * 1024; ///< Longest string read from a binary.
+
+	/**
+	 * @brief Random-access reader over a little-endian ELF file.
+	 */
+	class ElfReader
+	{
+	public:
+		explicit ElfReader(const std::string& path) : in(path, std::ios::binary) {}
+
+		bool Bytes(std::uint64_t offset, void* out, std::size_t size)
+		{
+			in.clear();
+			in.seekg(static_cast<std::streamoff>(offset));
+			return static_cast<bool>(in.read(static_cast<char*>(out), static_cast<std::streamsize>(size)));
+		}
+
+		bool Word(std::uint64_t offset, std::size_t size, std::uint64_t& value)
+		{
+			unsigned char bytes[8] {};
+			if (size > sizeof(bytes) || !Bytes(offset, bytes, size))
+				return false;
+			value = 0;
+			for (std::size_t i = size; i-- > 0;)
+				value = (value << 8) | bytes[i];
+			return true;
+		}
+
+	private:
+		std::ifstream in;
+	};
+
+	struct Segment
+	{
+		std::uint64_t address;
+		std::uint64_t offset;
+		std::uint64_t size;    ///< Bytes present in the file (p_filesz).
+	};
+
+	struct SectionHeader
+	{
+		std::uint32_t name;
+		std::uint32_t type;
+		std::uint64_t address;
+		std::uint64_t offset;
+		std::uint64_t size;
+		std::uint64_t entrySize;
+		std::uint64_t alignment;
+	};
+
+	/**
+	 * @brief The RELATIVE relocation type of an architecture, whose addend
+	 *        is the link-time value of a pointer.
+	 */
+	std::uint32_t RelativeRelocation(std::uint16_t machine)
+	{
+		switch (machine)
+		{
+			case 3:   return 8;     // i386
+			case 40:  return 23;    // ARM
+			case 62:  return 8;     // x86-64
+			case 183: return 1027;  // AArch64
+			case 243: return 3;     // RISC-V
+			default:  return 0;
+		}
+	}
+
+	/**
+	 * @brief Resolves link-time addresses in an ELF file.
+	 */
+	struct ElfImage
+	{
+		ElfReader& reader;
+		std::size_t pointerSize = 8;
+		std::vector<Segment> segments;
+		std::unordered_map<std::uint64_t, std::uint64_t> relative; ///< Pointer address -> RELA addend.
+
+		bool Offset(std::uint64_t address, std::size_t size, std::uint64_t& offset) const
+		{
+			for (const Segment& segment : segments)
+			{
+				if (address >= segment.address && address - segment.address + size <= segment.size)
+				{
+					offset = segment.offset + (address - segment.address);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool Pointer(std::uint64_t address, std::uint64_t& value) const
+		{
+			const auto found = relative.find(address);
+			if (found != relative.end())
+			{
+				value = found->second;
+				return true;
+			}
+			std::uint64_t offset;
+			return Offset(address, pointerSize, offset) && reader.Word(offset, pointerSize, value);
+		}
+
+		bool Int(std::uint64_t address, int& value) const
+		{
+			std::uint64_t offset;
+			std::uint64_t word;
+			if (!Offset(address, 4, offset) || !reader.Word(offset, 4, word))
+				return false;
+			value = static_cast<int>(static_cast<std::uint32_t>(word));
+			return true;
+		}
+
+		bool String(std::uint64_t address, std::string& value) const
+		{
+			value.clear();
+			if (address == 0)
+				return true;
+
+			std::uint64_t offset;
+			char buffer[256];
+			while (value.size() < MaxSiteString)
+			{
+				if (!Offset(address + value.size(), 1, offset))
+					return false;
+				std::size_t chunk = sizeof(buffer);
+				while (chunk > 1 && !Offset(address + value.size(), chunk, offset))
+					chunk /= 2;
+				if (!reader.Bytes(offset, buffer, chunk))
+					return false;
+				for (std::size_t i = 0; i < chunk; ++i)
+				{
+					if (buffer[i] == '\0')
+						return true;
+					value += buffer[i];
+				}
+			}
+			return false;
+		}
+	};
+
+	std::string BuildIdFromNotes(ElfReader& reader, const SectionHeader& section)
+	{
+		const std::uint64_t alignment = section.alignment == 8 ? 8 : 4;
+		const auto align = [alignment](std::uint64_t value) { return (value + alignment - 1) & ~(alignment - 1); };
+
+		std::uint64_t position = 0;
+		while (position + 12 <= section.size)
+		{
+			std::uint64_t nameSize, descSize, type;
+			if (!reader.Word(section.offset + position, 4, nameSize) || !reader.Word(section.offset + position + 4, 4, descSize)
+				|| !reader.Word(section.offset + position + 8, 4, type))
+			{
+				break;
+			}
+
+			char name[4] {};
+			if (type == 3 && nameSize == 4 && reader.Bytes(section.offset + position + 12, name, 4)
+				&& std::string_view(name, 4) == std::string_view("GNU", 4) && descSize <= 64)
+			{
+				static constexpr char Digits[] = "0123456789abcdef";
+				unsigned char id[64];
+				if (!reader.Bytes(section.offset + position + 12 + align(nameSize), id, static_cast<std::size_t>(descSize)))
+					break;
+				std::string buildId;
+				for (std::uint64_t i = 0; i < descSize; ++i)
+				{
+					buildId += Digits[id[i] >> 4];
+					buildId += Digits[id[i] & 0x0F];
+				}
+				return buildId;
+			}
+			position += 12 + align(nameSize) + align(descSize);
+		}
+		return std::string();
+	}
+}
+
+// ============================================================================
+//                                 RUN TIME
+// ============================================================================
+
+std::span<const RELogger::LogSite* const> RELogger::Internal::SiteTable()
+{
+#if defined(RELOGGER_SITE_SECTION)
+	if (__start_relogger_sites && __stop_relogger_sites)
+		return std::span<const LogSite* const>(__start_relogger_sites, __stop_relogger_sites);
+#endif
+	return {};
+}
+
+std::string RELogger::Internal::SiteTableBuildId()
+{
+	const std::span<const LogSite* const> table = SiteTable();
+	return table.empty() ? std::string() : ModuleBuildId(table.data());
+}
+
+// ============================================================================
+//                                  OFFLINE
+// ============================================================================
+
+/**
+ * @brief Reads the site section, build ID and pointer fixups of an ELF file.
+ */
+bool RELogger::ReadBinarySites(const std::string& path, BinarySites& sites)
+{
+	sites = BinarySites();
+
+	ElfReader reader(path);
+	unsigned char ident[16] {};
+	if (!reader.Bytes(0, ident, sizeof(ident)) || std::string_view(reinterpret_cast<char*>(ident), 4) != "\x7f" "ELF"
+		|| ident[5] != 1)
+	{
+		return false;
+	}
+
+	const bool wide = ident[4] == 2;
+	const std::size_t word = wide ? 8 : 4;
+	std::uint64_t machine, programOffset, sectionOffset, programEntry, programCount, sectionEntry, sectionCount, namesIndex;
+	if (!reader.Word(18, 2, machine)
+		|| !reader.Word(wide ? 0x20 : 0x1C, word, programOffset) || !reader.Word(wide ? 0x28 : 0x20, word, sectionOffset)
+		|| !reader.Word(wide ? 0x36 : 0x2A, 2, programEntry) || !reader.Word(wide ? 0x38 : 0x2C, 2, programCount)
+		|| !reader.Word(wide ? 0x3A : 0x2E, 2, sectionEntry) || !reader.Word(wide ? 0x3C : 0x30, 2, sectionCount)
+		|| !reader.Word(wide ? 0x3E : 0x32, 2, namesIndex))
+	{
+		return false;
+	}
+
+	ElfImage image { reader, word, {}, {} };
+	for (std::uint64_t i = 0; i < programCount; ++i)
+	{
+		const std::uint64_t entry = programOffset + i * programEntry;
+		std::uint64_t type, offset, address, fileSize;
+		if (!reader.Word(entry, 4, type)
+			|| !reader.Word(entry + (wide ? 8 : 4), word, offset)
+			|| !reader.Word(entry + (wide ? 16 : 8), word, address)
+			|| !reader.Word(entry + (wide ? 32 : 16), word, fileSize))
+		{
+			return false;
+		}
+		if (type == 1) // PT_LOAD
+			image.segments.push_back(Segment { address, offset, fileSize });
+	}
+
+	std::vector<SectionHeader> sections;
+	for (std::uint64_t i = 0; i < sectionCount; ++i)
+	{
+		const std::uint64_t entry = sectionOffset + i * sectionEntry;
+		std::uint64_t name, type, address, offset, size, alignment, entrySize;
+		if (!reader.Word(entry, 4, name) || !reader.Word(entry + 4, 4, type)
+			|| !reader.Word(entry + (wide ? 0x10 : 0x0C), word, address)
+			|| !reader.Word(entry + (wide ? 0x18 : 0x10), word, offset)
+			|| !reader.Word(entry + (wide ? 0x20 : 0x14), word, size)
+			|| !reader.Word(entry + (wide ? 0x30 : 0x20), word, alignment)
+			|| !reader.Word(entry + (wide ? 0x38 : 0x24), word, entrySize))
+		{
+			return false;
+		}
+		sections.push_back(SectionHeader { static_cast<std::uint32_t>(name), static_cast<std::uint32_t>(type),
+			address, offset, size, entrySize, alignment });
+	}
+	if (namesIndex >= sections.size())
+		return false;
+
+	const std::uint32_t relativeType = RelativeRelocation(static_cast<std::uint16_t>(machine));
+	const SectionHeader* table = nullptr;
+	for (const SectionHeader& section : sections)
+	{
+		std::string name;
+		name.resize(16);
+		if (reader.Bytes(sections[namesIndex].offset + section.name, name.data(), name.size()))
+			name.resize(name.find('\0') == std::string::npos ? name.size() : name.find('\0'));
+
+		if (name == "relogger_sites")
+			table = &section;
+		else if (section.type == 7 && sites.buildId.empty()) // SHT_NOTE
+			sites.buildId = BuildIdFromNotes(reader, section);
+		else if (section.type == 4 && relativeType != 0) // SHT_RELA
+		{
+			const std::uint64_t entrySize = section.entrySize ? section.entrySize : 3 * word;
+			for (std::uint64_t position = 0; position + entrySize <= section.size; position += entrySize)
+			{
+				std::uint64_t offset, info, addend;
+				if (!reader.Word(section.offset + position, word, offset)
+					|| !reader.Word(section.offset + position + word, word, info)
+					|| !reader.Word(section.offset + position + 2 * word, word, addend))
+				{
+					return false;
+				}
+				const std::uint64_t type = wide ? (info & 0xFFFFFFFF) : (info & 0xFF);
+				if (type == relativeType)
+					image.relative[offset] = addend;
+			}
+		}
+	}
+	if (!table)
+		return false;
+
+	for (std::uint64_t entry = table->address; entry + word <= table->address + table->size; entry += word)
+	{
+		std::uint64_t site, file, func, format, category;
+		int level = 0;
+		BinarySite decoded;
+		const std::uint64_t funcOffset = 2 * word + (word > 4 ? word : 4);
+		if (!image.Pointer(entry, site) || !image.Int(site, level)
+			|| !image.Pointer(site + word, file) || !image.Int(site + 2 * word, decoded.line)
+			|| !image.Pointer(site + funcOffset, func) || !image.Pointer(site + funcOffset + word, format)
+			|| !image.Pointer(site + funcOffset + 2 * word, category)
+			|| !image.String(file, decoded.file) || !image.String(func, decoded.func)
+			|| !image.String(format, decoded.format) || !image.String(category, decoded.category))
+		{
+			return false;
+		}
+		decoded.level = static_cast<LogLevel>(level);
+		sites.sites.push_back(std::move(decoded));
+	}
+	return true;
+}
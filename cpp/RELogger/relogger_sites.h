@@ -0,0 +1,134 @@
+/*
+===============================================================================
+
+  RELogger - Site Section (C++ Header)
+  ------------------------------------
+
+  Every RELOG_*F expansion also leaves a pointer to its LogSite in the
+  "relogger_sites" linker section of the executable. The linker collects
+  them into one array bounded by __start_relogger_sites and
+  __stop_relogger_sites, so the full list of sites exists before main
+  runs and costs nothing to build.
+
+  CompressedFileSink uses it to drop template entries: a record from a
+  listed site refers to the site by its index in the section, and the
+  decoder reads the level, location and format from the binary itself
+  (ReadBinarySites), checked against the build ID noted in the log.
+
+  The section is produced by GCC and Clang for ELF executables (including
+  PIE). Code built for a shared library (-fPIC without -fPIE), other
+  object formats, or builds defining RELOGGER_NO_SITE_SECTION leave it
+  out; their sites keep being written as templates.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_SITES_H
+#define RELOGGER_SITES_H
+
+#include "relogger.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace RELogger
+{
+    struct LogSite;
+
+    /*
+    =======================================================================
+      STRUCT: BinarySite
+      ---------------------------------------------------------------------
+      A LogSite as read back from a binary's site section.
+    =======================================================================
+    */
+    struct BinarySite
+    {
+        LogLevel level = LogLevel::Info;
+        int line = 0;
+        std::string file;
+        std::string func;
+        std::string format;
+        std::string category;  /**< Empty for sites without one. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: BinarySites
+      ---------------------------------------------------------------------
+      The site section of one binary, in section order.
+    =======================================================================
+    */
+    struct BinarySites
+    {
+        std::string buildId;            /**< GNU build ID in hex, or empty if the binary has none. */
+        std::vector<BinarySite> sites;
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: ReadBinarySites
+      ---------------------------------------------------------------------
+      Reads the site section of a little-endian ELF executable (or of its
+      unstripped copy). Pointers are resolved from the file's RELATIVE
+      relocations where it has them, otherwise from the stored values.
+
+      @param path  - The executable.
+      @param sites - Receives the build ID and sites.
+      @return False if the file is not such an ELF file, has no site
+              section, or a site points outside the file.
+    =======================================================================
+    */
+    bool ReadBinarySites(const std::string& path, BinarySites& sites);
+}
+
+namespace RELogger::Internal
+{
+    /*
+    =======================================================================
+      FUNCTION: SiteTable / SiteTableBuildId
+      ---------------------------------------------------------------------
+      The site section of the module the logger is linked into (empty
+      without one), and that module's build ID. A site appears more than
+      once when the code holding it was emitted more than once (e.g. an
+      inline function in several translation units).
+    =======================================================================
+    */
+    std::span<const LogSite* const> SiteTable();
+    std::string SiteTableBuildId();
+}
+
+/*
+===============================================================================
+  MACRO DEFINITIONS
+  -----------------
+  RELOGGER_SITE_ENTRY(site) adds &site to the section. It is emitted with
+  inline assembly because GCC rejects a section attribute shared by
+  static locals of inline and non-inline functions in one translation
+  unit.
+===============================================================================
+*/
+
+#if defined(__ELF__) && defined(__GNUC__) && (!defined(__PIC__) || defined(__PIE__)) \
+    && !defined(RELOGGER_NO_SITE_SECTION)
+#define RELOGGER_SITE_SECTION 1
+#define RELOGGER_SITE_ENTRY(site)                                                           \
+    __asm__(".pushsection relogger_sites,\"aw\"\n\t.balign %c1\n\t.dc.a %c0\n\t.popsection" \
+            : : "i"(&(site)), "i"(alignof(void*)))
+#else
+#define RELOGGER_SITE_ENTRY(site) ((void)0)
+#endif
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_SITES_H */
@@ -0,0 +1,462 @@
+/**
+ * @file relogger_stack.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Return-address capture for records and the module map that
+ *        lets them be symbolized offline.
+ *
+ * Nothing here resolves a symbol: capture copies at most a few dozen
+ * pointers and prints them as hex, and the module map is only built when
+ * a file writes its first stack.
+ */
+
+#include "relogger_stack.h"
+#include "relogger_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(__APPLE__)
+#include <link.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(RELOGGER_FRAME_POINTER_STACKS) && defined(__GNUC__)
+#include <unwind.h>
+#endif
+
+namespace
+{
+	using namespace RELogger::Internal;
+
+	constexpr std::size_t LoggerFrames = 8; ///< Slots for the logger's own frames above the caller.
+	constexpr char HexDigits[] = "0123456789abcdef";
+
+	std::atomic<std::size_t> stackFrames { 0 };
+	std::atomic<LogLevel> stackLevel { LogLevel::Error };
+
+	void AppendHex(std::string& out, std::uintptr_t value)
+	{
+		char digits[2 * sizeof(value)];
+		const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, 16);
+		out.append(digits, result.ptr);
+	}
+
+	void AppendHexBytes(std::string& out, const unsigned char* bytes, std::size_t size)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			out += HexDigits[bytes[i] >> 4];
+			out += HexDigits[bytes[i] & 0x0F];
+		}
+	}
+
+	void AppendModuleLine(std::string& out, std::uintptr_t start, std::uintptr_t end, std::uintptr_t bias,
+						  std::string_view buildId, std::string_view path)
+	{
+		out += "[LOGGER MODULE] start=0x";
+		AppendHex(out, start);
+		out += " end=0x";
+		AppendHex(out, end);
+		out += " bias=0x";
+		AppendHex(out, bias);
+		out += " build-id=";
+		out += buildId.empty() ? std::string_view("-") : buildId;
+		out += " path=";
+		out += path;
+		out += '\n';
+	}
+
+	// ------------------------------------------------------------------------
+	// Capture
+	// ------------------------------------------------------------------------
+
+#if defined(_WIN32)
+	std::size_t CaptureReturnAddresses(std::uintptr_t* frames, std::size_t maxFrames)
+	{
+		void* addresses[MaxStackFrames + LoggerFrames];
+		const USHORT count = ::RtlCaptureStackBackTrace(0, static_cast<DWORD>(maxFrames), addresses, nullptr);
+		for (USHORT i = 0; i < count; ++i)
+			frames[i] = reinterpret_cast<std::uintptr_t>(addresses[i]);
+		return count;
+	}
+#elif defined(RELOGGER_FRAME_POINTER_STACKS)
+	/**
+	 * @brief Follows the saved frame pointers (x86-64 and AArch64 frame
+	 *        records: previous frame pointer, then return address).
+	 *
+	 * The chain ends at a null frame pointer; a link that does not lead
+	 * further up the stack, or jumps implausibly far, also ends it.
+	 */
+	std::size_t CaptureReturnAddresses(std::uintptr_t* frames, std::size_t maxFrames)
+	{
+		constexpr std::uintptr_t MaxFrameSize = 1024 * 1024;
+
+		std::size_t count = 0;
+		void** frame = static_cast<void**>(__builtin_frame_address(0));
+		while (frame && count < maxFrames)
+		{
+			const std::uintptr_t returnAddress = reinterpret_cast<std::uintptr_t>(frame[1]);
+			if (returnAddress == 0)
+				break;
+			frames[count++] = returnAddress;
+
+			void** next = static_cast<void**>(frame[0]);
+			const std::uintptr_t distance = reinterpret_cast<std::uintptr_t>(next) - reinterpret_cast<std::uintptr_t>(frame);
+			if (next <= frame || distance > MaxFrameSize || reinterpret_cast<std::uintptr_t>(next) % sizeof(void*) != 0)
+				break;
+			frame = next;
+		}
+		return count;
+	}
+#elif defined(__GNUC__)
+	struct UnwindState
+	{
+		std::uintptr_t* frames;
+		std::size_t count;
+		std::size_t maxFrames;
+	};
+
+	_Unwind_Reason_Code CollectFrame(_Unwind_Context* context, void* argument)
+	{
+		UnwindState& state = *static_cast<UnwindState*>(argument);
+		const std::uintptr_t address = _Unwind_GetIP(context);
+		if (address == 0 || state.count == state.maxFrames)
+			return _URC_END_OF_STACK;
+		state.frames[state.count++] = address;
+		return _URC_NO_REASON;
+	}
+
+	std::size_t CaptureReturnAddresses(std::uintptr_t* frames, std::size_t maxFrames)
+	{
+		UnwindState state { frames, 0, maxFrames };
+		_Unwind_Backtrace(&CollectFrame, &state);
+		return state.count;
+	}
+#else
+	std::size_t CaptureReturnAddresses(std::uintptr_t*, std::size_t)
+	{
+		return 0;
+	}
+#endif
+
+	// ------------------------------------------------------------------------
+	// Module map
+	// ------------------------------------------------------------------------
+
+#if defined(_WIN32)
+	/**
+	 * @brief Reads the PDB signature (GUID and age, as symbol servers key
+	 *        it) from a loaded image's CodeView debug entry.
+	 */
+	std::string ReadPdbSignature(const unsigned char* image)
+	{
+		const IMAGE_DOS_HEADER* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(image);
+		const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(image + dos->e_lfanew);
+		const IMAGE_DATA_DIRECTORY& directory = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_DEBUG];
+
+		const IMAGE_DEBUG_DIRECTORY* entries = reinterpret_cast<const IMAGE_DEBUG_DIRECTORY*>(image + directory.VirtualAddress);
+		for (DWORD i = 0; i < directory.Size / sizeof(IMAGE_DEBUG_DIRECTORY); ++i)
+		{
+			if (entries[i].Type != IMAGE_DEBUG_TYPE_CODEVIEW || entries[i].SizeOfData < 24)
+				continue;
+
+			const unsigned char* record = image + entries[i].AddressOfRawData;
+			if (std::memcmp(record, "RSDS", 4) != 0)
+				continue;
+
+			GUID guid;
+			DWORD age;
+			std::memcpy(&guid, record + 4, sizeof(guid));
+			std::memcpy(&age, record + 20, sizeof(age));
+			char signature[48];
+			std::snprintf(signature, sizeof(signature), "%08lX%04X%04X%02X%02X%02X%02X%02X%02X%02X%02X%lX",
+				guid.Data1, guid.Data2, guid.Data3, guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
+				guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7], age);
+			return signature;
+		}
+		return std::string();
+	}
+
+	std::vector<HMODULE> LoadedModules()
+	{
+		std::vector<HMODULE> modules(256);
+		DWORD needed = 0;
+		while (::K32EnumProcessModules(::GetCurrentProcess(), modules.data(),
+			static_cast<DWORD>(modules.size() * sizeof(HMODULE)), &needed)
+			&& needed > modules.size() * sizeof(HMODULE))
+		{
+			modules.resize(needed / sizeof(HMODULE));
+		}
+		modules.resize(std::min<std::size_t>(modules.size(), needed / sizeof(HMODULE)));
+		return modules;
+	}
+#elif !defined(__APPLE__)
+	/**
+	 * @brief Finds the NT_GNU_BUILD_ID note in a loaded PT_NOTE segment.
+	 */
+	std::string ReadBuildId(const unsigned char* notes, std::size_t size, std::size_t alignment)
+	{
+		const auto align = [alignment](std::size_t value) { return (value + alignment - 1) & ~(alignment - 1); };
+
+		while (size >= sizeof(ElfW(Nhdr)))
+		{
+			ElfW(Nhdr) note;
+			std::memcpy(&note, notes, sizeof(note));
+			const std::size_t length = sizeof(note) + align(note.n_namesz) + align(note.n_descsz);
+			if (length > size)
+				break;
+
+			const unsigned char* name = notes + sizeof(note);
+			if (note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0)
+			{
+				std::string buildId;
+				AppendHexBytes(buildId, name + align(note.n_namesz), note.n_descsz);
+				return buildId;
+			}
+			notes += length;
+			size -= length;
+		}
+		return std::string();
+	}
+
+	std::string ExecutablePath()
+	{
+#ifdef __linux__
+		char path[4096];
+		const ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path));
+		if (length > 0)
+			return std::string(path, static_cast<std::size_t>(length));
+#endif
+		return std::string();
+	}
+
+	int AppendModule(dl_phdr_info* info, std::size_t, void* argument)
+	{
+		std::string& out = *static_cast<std::string*>(argument);
+
+		std::uintptr_t start = UINTPTR_MAX;
+		std::uintptr_t end = 0;
+		std::string buildId;
+		for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+		{
+			const ElfW(Phdr)& header = info->dlpi_phdr[i];
+			const std::uintptr_t address = info->dlpi_addr + header.p_vaddr;
+			if (header.p_type == PT_LOAD)
+			{
+				start = std::min(start, address);
+				end = std::max<std::uintptr_t>(end, address + header.p_memsz);
+			}
+			else if (header.p_type == PT_NOTE && buildId.empty())
+			{
+				buildId = ReadBuildId(reinterpret_cast<const unsigned char*>(address), header.p_memsz,
+					header.p_align == 8 ? 8 : 4);
+			}
+		}
+		if (end == 0)
+			return 0;
+
+		// The main program is the one entry without a name.
+		std::string path = info->dlpi_name ? info->dlpi_name : "";
+		if (path.empty())
+			path = ExecutablePath();
+
+		AppendModuleLine(out, start, end, info->dlpi_addr, buildId, path);
+		return 0;
+	}
+
+	struct BuildIdQuery
+	{
+		std::uintptr_t address;
+		std::string buildId;
+	};
+
+	int FindModuleBuildId(dl_phdr_info* info, std::size_t, void* argument)
+	{
+		BuildIdQuery& query = *static_cast<BuildIdQuery*>(argument);
+
+		bool contains = false;
+		for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i)
+		{
+			const ElfW(Phdr)& header = info->dlpi_phdr[i];
+			const std::uintptr_t start = info->dlpi_addr + header.p_vaddr;
+			contains = contains || (header.p_type == PT_LOAD && query.address - start < header.p_memsz);
+		}
+		if (!contains)
+			return 0;
+
+		for (ElfW(Half) i = 0; i < info->dlpi_phnum && query.buildId.empty(); ++i)
+		{
+			const ElfW(Phdr)& header = info->dlpi_phdr[i];
+			if (header.p_type == PT_NOTE)
+			{
+				query.buildId = ReadBuildId(reinterpret_cast<const unsigned char*>(info->dlpi_addr + header.p_vaddr),
+					header.p_memsz, header.p_align == 8 ? 8 : 4);
+			}
+		}
+		return 1;
+	}
+
+	int ReadLoadCounters(dl_phdr_info* info, std::size_t size, void* argument)
+	{
+		std::uint64_t& version = *static_cast<std::uint64_t*>(argument);
+		if (size >= offsetof(dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs))
+			version = info->dlpi_adds + info->dlpi_subs;
+		return 1; // The counters are the same in every entry.
+	}
+#endif
+}
+
+// ============================================================================
+//                                  CAPTURE
+// ============================================================================
+
+void RELogger::Internal::SetStackCapture(std::size_t frames, LogLevel level)
+{
+	stackLevel.store(level, std::memory_order_relaxed);
+	stackFrames.store(std::min(frames, MaxStackFrames), std::memory_order_relaxed);
+}
+
+std::size_t RELogger::Internal::CaptureStack(std::uintptr_t* frames, std::size_t maxFrames, const void* caller)
+{
+	std::uintptr_t captured[MaxStackFrames + LoggerFrames];
+	const std::size_t count = CaptureReturnAddresses(captured, std::min(maxFrames, MaxStackFrames) + LoggerFrames);
+
+	// Without caller in the list (inlined entry point, tail call) the
+	// logger's frames are kept rather than guessing how many to drop.
+	std::size_t first = 0;
+	while (first < count && captured[first] != reinterpret_cast<std::uintptr_t>(caller))
+		++first;
+	if (first == count)
+		first = 0;
+
+	const std::size_t kept = std::min(count - first, maxFrames);
+	std::copy_n(captured + first, kept, frames);
+	return kept;
+}
+
+/**
+ * @brief Appends "stack=a,b,c" to the record's context.
+ *
+ * The field is kept whole within MaxContextSize; the task's own fields
+ * are shortened instead if both do not fit.
+ */
+std::string_view RELogger::Internal::AttachStack(LogLevel level, std::string_view context, const void* caller)
+{
+	const std::size_t maxFrames = stackFrames.load(std::memory_order_relaxed);
+	if (maxFrames == 0 || level < stackLevel.load(std::memory_order_relaxed))
+		return context;
+
+	std::uintptr_t frames[MaxStackFrames];
+	const std::size_t count = CaptureStack(frames, maxFrames, caller);
+	if (count == 0)
+		return context;
+
+	thread_local std::string field;
+	field.assign("stack=");
+	for (std::size_t i = 0; i < count && field.size() + 2 * sizeof(std::uintptr_t) + 1 <= MaxContextSize; ++i)
+	{
+		if (i > 0)
+			field += ',';
+		AppendHex(field, frames[i]);
+	}
+
+	if (context.empty())
+		return field;
+	const std::size_t room = MaxContextSize - field.size();
+	if (room < 2)
+		return field;
+
+	thread_local std::string combined;
+	combined.assign(context.substr(0, room - 1));
+	combined += ' ';
+	combined += field;
+	return combined;
+}
+
+bool RELogger::Internal::HasStackField(std::string_view context)
+{
+	const std::size_t position = context.rfind("stack=");
+	return position != std::string_view::npos && (position == 0 || context[position - 1] == ' ');
+}
+
+// ============================================================================
+//                                MODULE MAP
+// ============================================================================
+
+std::uint64_t RELogger::Internal::ModuleMapVersion()
+{
+#if defined(_WIN32)
+	// No load counter on Windows; the module list itself is the version.
+	std::uint64_t version = 1469598103934665603ull;
+	for (HMODULE module : LoadedModules())
+		version = (version ^ reinterpret_cast<std::uintptr_t>(module)) * 1099511628211ull;
+	return version;
+#elif defined(__APPLE__)
+	return 0;
+#else
+	std::uint64_t version = 0;
+	::dl_iterate_phdr(&ReadLoadCounters, &version);
+	return version;
+#endif
+}
+
+void RELogger::Internal::AppendModuleMap(std::string& out)
+{
+#if defined(_WIN32)
+	for (HMODULE module : LoadedModules())
+	{
+		MODULEINFO info {};
+		char path[MAX_PATH];
+		if (!::K32GetModuleInformation(::GetCurrentProcess(), module, &info, sizeof(info))
+			|| !::GetModuleFileNameA(module, path, sizeof(path)))
+		{
+			continue;
+		}
+
+		const unsigned char* image = static_cast<const unsigned char*>(info.lpBaseOfDll);
+		const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(
+			image + reinterpret_cast<const IMAGE_DOS_HEADER*>(image)->e_lfanew);
+		const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(image);
+		AppendModuleLine(out, start, start + info.SizeOfImage,
+			start - static_cast<std::uintptr_t>(nt->OptionalHeader.ImageBase), ReadPdbSignature(image), path);
+	}
+#elif defined(__APPLE__)
+	(void)out;
+#else
+	::dl_iterate_phdr(&AppendModule, &out);
+#endif
+}
+
+std::string RELogger::Internal::ModuleBuildId(const void* address)
+{
+#if defined(_WIN32)
+	HMODULE module = nullptr;
+	if (!::GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		static_cast<LPCSTR>(address), &module))
+	{
+		return std::string();
+	}
+	return ReadPdbSignature(reinterpret_cast<const unsigned char*>(module));
+#elif defined(__APPLE__)
+	(void)address;
+	return std::string();
+#else
+	BuildIdQuery query { reinterpret_cast<std::uintptr_t>(address), std::string() };
+	::dl_iterate_phdr(&FindModuleBuildId, &query);
+	return query.buildId;
+#endif
+}
@@ -0,0 +1,130 @@
+/*
+===============================================================================
+
+  RELogger - Stack Capture (C++ Header)
+  -------------------------------------
+
+  Raw call stacks for Error and Fatal records (Config::stackFrames).
+  Only return addresses are taken at log time; they travel with the
+  record as the last context field,
+
+      [req=42 stack=55d0c31a2f4e,55d0c31a1b20,7f3e9c029d90]
+
+  and are resolved offline by Tools/relogsym.cpp. For that, text and
+  block files write the module map of the process before the first
+  record with a stack (and again when libraries were loaded since):
+
+      [LOGGER MODULE] start=0x55d0c3100000 end=0x55d0c3160000 bias=0x55d0c3100000 build-id=9f2c... path=/opt/game/server
+
+  An address belongs to the module whose [start, end) contains it; its
+  address in the binary on disk is address - bias.
+
+  Capture uses RtlCaptureStackBackTrace on Windows and the unwinder of
+  the C++ runtime elsewhere. Builds whose code all keeps frame pointers
+  (-fno-omit-frame-pointer) can define RELOGGER_FRAME_POINTER_STACKS to
+  walk the frame chain instead, which is much cheaper.
+
+  Internal to RELogger.
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_STACK_H
+#define RELOGGER_STACK_H
+
+#include "relogger.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RELOGGER_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define RELOGGER_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+namespace RELogger::Internal
+{
+    constexpr std::size_t MaxStackFrames = 64;  /**< Upper bound for Config::stackFrames. */
+
+    /*
+    =======================================================================
+      FUNCTION: SetStackCapture
+      ---------------------------------------------------------------------
+      Records at level and above get up to frames return addresses; 0
+      turns capture off. Called by Init.
+    =======================================================================
+    */
+    void SetStackCapture(std::size_t frames, LogLevel level);
+
+    /*
+    =======================================================================
+      FUNCTION: CaptureStack
+      ---------------------------------------------------------------------
+      Fills frames with the return addresses of the calling thread,
+      starting at caller (the return address of the logger's entry
+      point) so the logger's own frames are left out.
+
+      @return Number of addresses written.
+    =======================================================================
+    */
+    std::size_t CaptureStack(std::uintptr_t* frames, std::size_t maxFrames, const void* caller);
+
+    /*
+    =======================================================================
+      FUNCTION: AttachStack
+      ---------------------------------------------------------------------
+      Returns context unchanged if level is below the capture level,
+      otherwise context with a stack field appended. The result lives
+      in a thread-local buffer until the thread's next call.
+    =======================================================================
+    */
+    std::string_view AttachStack(LogLevel level, std::string_view context, const void* caller);
+
+    /*
+    =======================================================================
+      FUNCTION: HasStackField
+      ---------------------------------------------------------------------
+      @return True if context ends with a stack field.
+    =======================================================================
+    */
+    bool HasStackField(std::string_view context);
+
+    /*
+    =======================================================================
+      FUNCTION: ModuleMapVersion / AppendModuleMap
+      ---------------------------------------------------------------------
+      The version changes whenever a module is loaded or unloaded;
+      AppendModuleMap writes one "[LOGGER MODULE]" line per module,
+      each ending in '\n'.
+    =======================================================================
+    */
+    std::uint64_t ModuleMapVersion();
+    void AppendModuleMap(std::string& out);
+
+    /*
+    =======================================================================
+      FUNCTION: ModuleBuildId
+      ---------------------------------------------------------------------
+      @return The build ID (as in the module map) of the module holding
+              address, or "" if it has none or is not found.
+    =======================================================================
+    */
+    std::string ModuleBuildId(const void* address);
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_STACK_H */
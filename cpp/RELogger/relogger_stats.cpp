@@ -0,0 +1,498 @@
+/**
+ * @file relogger_stats.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Per-thread accounting of time spent inside the logger.
+ *
+ * Each logging thread owns a counter block from a lock-free registry and is
+ * its only writer, so an update is two plain stores on a line no other
+ * thread writes. Blocks of exited threads are reused, like thread queues.
+ *
+ * The optional shared stats page is written where records are delivered:
+ * by the backend thread in asynchronous mode, by the logging threads
+ * otherwise. Sites are found by hashing their file and category addresses,
+ * line and level into an open-addressing table inside the page.
+ */
+
+#include "relogger_internal.h"
+#include "relogger_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define RELOGGER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RELOGGER_HAS_TSC 1
+#endif
+
+namespace
+{
+	constexpr std::size_t ThreadNameSize = 32; ///< Bytes kept of a thread name, including the terminator.
+	constexpr std::chrono::milliseconds CalibrationTime { 20 }; ///< Minimum span used to measure the tick rate.
+
+	/**
+	 * @brief Totals of one thread, written only by that thread.
+	 */
+	struct alignas(64) OverheadCounters
+	{
+		std::atomic<std::uint64_t> calls { 0 };
+		std::atomic<std::uint64_t> ticks { 0 };
+		std::atomic<std::uint64_t> threadId { 0 };
+		std::atomic<bool> owned { true };          ///< Cleared when the thread exits.
+		std::atomic<char> name[ThreadNameSize] {}; ///< Written by the owner, read by anyone.
+		OverheadCounters* next = nullptr;          ///< Next block in the registry.
+	};
+
+	constinit std::atomic<OverheadCounters*> countersRegistry { nullptr }; ///< Every block ever created.
+
+	enum class CountersState : std::uint8_t { None, Owned, Released };
+
+	constinit thread_local OverheadCounters* threadCounters = nullptr;
+	constinit thread_local CountersState threadCountersState = CountersState::None;
+
+	/**
+	 * @brief Hands this thread's block back to the registry when the thread exits.
+	 */
+	struct CountersReleaser
+	{
+		~CountersReleaser()
+		{
+			if (threadCounters)
+			{
+				threadCounters->owned.store(false, std::memory_order_release);
+				threadCounters = nullptr;
+			}
+			threadCountersState = CountersState::Released;
+		}
+	};
+
+	thread_local CountersReleaser threadCountersReleaser;
+
+	/**
+	 * @brief Reads the raw tick counter.
+	 */
+	inline std::uint64_t ReadTicks()
+	{
+#ifdef RELOGGER_HAS_TSC
+		return __rdtsc();
+#else
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	/**
+	 * @brief Tick and steady clock readings that start the calibration span.
+	 *
+	 * Constant-initialized and stamped once, by Init or the first rate
+	 * query, so nothing here runs before main.
+	 */
+	struct TickEpoch
+	{
+		std::uint64_t ticks = 0;
+		std::chrono::steady_clock::time_point time {};
+	};
+
+	constinit TickEpoch tickEpoch;
+	constinit std::once_flag tickEpochOnce;
+	constinit std::atomic<double> tickRate { 0.0 }; ///< Nanoseconds per tick over a full span; 0 until measured.
+
+	/**
+	 * @brief Stamps the calibration epoch if nothing has yet.
+	 */
+	void MarkTickEpoch()
+	{
+		std::call_once(tickEpochOnce, []
+		{
+			tickEpoch.time = std::chrono::steady_clock::now();
+			tickEpoch.ticks = ReadTicks();
+		});
+	}
+
+	/**
+	 * @brief Nanoseconds per tick, measured once over CalibrationTime.
+	 * @param wait Sleep until the span is complete if it is not yet;
+	 *             otherwise return an estimate over the shorter span.
+	 */
+	double NanosecondsPerTick(bool wait)
+	{
+#ifdef RELOGGER_HAS_TSC
+		const double measured = tickRate.load(std::memory_order_relaxed);
+		if (measured > 0.0)
+			return measured;
+
+		MarkTickEpoch();
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const bool complete = now - tickEpoch.time >= CalibrationTime;
+		if (!complete && wait)
+		{
+			std::this_thread::sleep_until(tickEpoch.time + CalibrationTime);
+			now = std::chrono::steady_clock::now();
+		}
+		const std::uint64_t ticks = ReadTicks() - tickEpoch.ticks;
+		const double nanoseconds = static_cast<double>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(now - tickEpoch.time).count());
+		const double rate = ticks > 0 ? nanoseconds / static_cast<double>(ticks) : 1.0;
+		if (complete || wait)
+			tickRate.store(rate, std::memory_order_relaxed);
+		return rate;
+#else
+		(void)wait;
+		return 1.0;
+#endif
+	}
+
+	/**
+	 * @brief Returns the calling thread's block, claiming or creating one.
+	 * @return The block, or nullptr once the thread is past its thread-local teardown.
+	 */
+	OverheadCounters* AcquireCounters()
+	{
+		if (threadCountersState != CountersState::None)
+			return threadCounters;
+
+		OverheadCounters* counters = nullptr;
+		for (OverheadCounters* candidate = countersRegistry.load(std::memory_order_acquire); candidate; candidate = candidate->next)
+		{
+			bool expected = false;
+			if (candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				counters = candidate;
+				break;
+			}
+		}
+
+		if (counters)
+		{
+			counters->calls.store(0, std::memory_order_relaxed);
+			counters->ticks.store(0, std::memory_order_relaxed);
+			counters->name[0].store('\0', std::memory_order_relaxed);
+		}
+		else
+		{
+			counters = new OverheadCounters();
+			OverheadCounters* head = countersRegistry.load(std::memory_order_relaxed);
+			do
+			{
+				counters->next = head;
+			} while (!countersRegistry.compare_exchange_weak(head, counters,
+						std::memory_order_release, std::memory_order_relaxed));
+		}
+		counters->threadId.store(std::hash<std::thread::id>{}(std::this_thread::get_id()), std::memory_order_relaxed);
+
+		(void)&threadCountersReleaser; // Registers the thread-exit release.
+		threadCounters = counters;
+		threadCountersState = CountersState::Owned;
+		return counters;
+	}
+
+	/**
+	 * @brief Converts a block to its public form.
+	 */
+	RELogger::ThreadLogOverhead Snapshot(const OverheadCounters& counters)
+	{
+		RELogger::ThreadLogOverhead overhead;
+		overhead.threadId = counters.threadId.load(std::memory_order_relaxed);
+		overhead.calls = counters.calls.load(std::memory_order_relaxed);
+		overhead.time = std::chrono::nanoseconds(static_cast<std::int64_t>(
+			static_cast<double>(counters.ticks.load(std::memory_order_relaxed)) * NanosecondsPerTick(false)));
+		overhead.alive = counters.owned.load(std::memory_order_acquire);
+		for (const std::atomic<char>& c : counters.name)
+		{
+			const char value = c.load(std::memory_order_relaxed);
+			if (value == '\0')
+				break;
+			overhead.name.push_back(value);
+		}
+		return overhead;
+	}
+}
+
+namespace
+{
+	using RELogger::StatsCategory;
+	using RELogger::StatsCounters;
+	using RELogger::StatsPage;
+	using RELogger::StatsSite;
+
+	constexpr std::size_t MaxStatsProbes = 32; ///< Slots tried before a site counts as overflow.
+
+	constinit std::atomic<StatsPage*> activeStats { nullptr }; ///< Page being written, if any.
+
+	/**
+	 * @brief Owns the stats mapping and its name; removes the name at process exit.
+	 */
+	struct StatsMapping
+	{
+		StatsPage* page = nullptr;
+		std::string name;
+
+		~StatsMapping()
+		{
+			if (page)
+				RELogger::Internal::RemoveSharedMemory(name);
+		}
+	};
+
+	StatsMapping statsMapping;
+
+	/**
+	 * @brief Spreads a key over the table (splitmix64 finalizer).
+	 */
+	std::uint64_t MixKey(std::uint64_t key)
+	{
+		key ^= key >> 30;
+		key *= 0xbf58476d1ce4e5b9ull;
+		key ^= key >> 27;
+		key *= 0x94d049bb133111ebull;
+		return key ^ (key >> 31);
+	}
+
+	/**
+	 * @brief Copies a name into a fixed field, cutting and terminating it.
+	 */
+	void CopyName(char* out, std::size_t size, std::string_view name)
+	{
+		const std::size_t length = std::min(name.size(), size - 1);
+		std::memcpy(out, name.data(), length);
+		out[length] = '\0';
+	}
+
+	/**
+	 * @brief Adds to one row of counters.
+	 */
+	void AddCounters(StatsCounters& counters, std::uint64_t records, std::uint64_t bytes, std::uint64_t drops)
+	{
+		if (records)
+			std::atomic_ref<std::uint64_t>(counters.records).fetch_add(records, std::memory_order_relaxed);
+		if (bytes)
+			std::atomic_ref<std::uint64_t>(counters.bytes).fetch_add(bytes, std::memory_order_relaxed);
+		if (drops)
+			std::atomic_ref<std::uint64_t>(counters.drops).fetch_add(drops, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Finds or claims the slot of a key in an open-addressing table.
+	 * @param fill Called once by the thread that claims a new slot.
+	 * @return The slot, or nullptr if the probe limit was reached.
+	 */
+	template<typename Slot, std::size_t Count, typename Fill>
+	Slot* FindSlot(Slot (&slots)[Count], std::uint64_t key, Fill&& fill)
+	{
+		std::size_t index = static_cast<std::size_t>(MixKey(key)) & (Count - 1);
+		for (std::size_t probe = 0; probe < MaxStatsProbes && probe < Count; ++probe)
+		{
+			Slot& slot = slots[index];
+			std::atomic_ref<std::uint64_t> slotKey(slot.key);
+			std::uint64_t current = slotKey.load(std::memory_order_acquire);
+			if (current == 0 && slotKey.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+			{
+				fill(slot);
+				std::atomic_ref<std::uint8_t>(slot.ready).store(1, std::memory_order_release);
+				return &slot;
+			}
+			if (current == key)
+				return &slot;
+			index = (index + 1) & (Count - 1);
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Adds a record (or a drop) to its level, category and site rows.
+	 */
+	void CountInPage(StatsPage* page, LogLevel level, const char* file, int line, const char* category,
+					 std::uint64_t records, std::uint64_t bytes, std::uint64_t drops)
+	{
+		const std::size_t levelIndex = std::min(static_cast<std::size_t>(level), RELogger::StatsLevelCount - 1);
+		AddCounters(page->levels[levelIndex], records, bytes, drops);
+
+		if (category)
+		{
+			const std::uint64_t key = reinterpret_cast<std::uintptr_t>(category) | 1;
+			StatsCategory* slot = FindSlot(page->categories, key, [category](StatsCategory& claimed)
+			{
+				CopyName(claimed.name, sizeof(claimed.name), category);
+			});
+			if (slot)
+				AddCounters(slot->counters, records, bytes, drops);
+		}
+
+		const std::uint64_t key = (MixKey(reinterpret_cast<std::uintptr_t>(file) ^ reinterpret_cast<std::uintptr_t>(category))
+			^ (static_cast<std::uint64_t>(line) << 8) ^ static_cast<std::uint64_t>(level)) | 1;
+		StatsSite* site = FindSlot(page->sites, key, [&](StatsSite& claimed)
+		{
+			claimed.line = static_cast<std::uint32_t>(line);
+			claimed.level = static_cast<std::uint8_t>(level);
+			CopyName(claimed.file, sizeof(claimed.file), RELogger::Internal::FileBaseName(file));
+			CopyName(claimed.category, sizeof(claimed.category), category ? category : "");
+		});
+		AddCounters(site ? site->counters : page->overflow, records, bytes, drops);
+	}
+}
+
+// ============================================================================
+//                              PRODUCER SIDE
+// ============================================================================
+
+/**
+ * @brief Starts timing a logging call.
+ * @return Opaque start value for EndLogOverhead.
+ */
+std::uint64_t RELogger::Internal::BeginLogOverhead()
+{
+	return ReadTicks();
+}
+
+/**
+ * @brief Adds one logging call that began at start to the calling thread's totals.
+ */
+void RELogger::Internal::EndLogOverhead(std::uint64_t start)
+{
+	const std::uint64_t elapsed = ReadTicks() - start;
+	OverheadCounters* counters = AcquireCounters();
+	if (!counters)
+		return;
+
+	counters->calls.store(counters->calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	counters->ticks.store(counters->ticks.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Reads the counter used for overhead timing (also used by TscClock).
+ */
+std::uint64_t RELogger::Internal::ReadTickCounter()
+{
+	return ReadTicks();
+}
+
+/**
+ * @brief Nanoseconds per ReadTickCounter tick, measured once per process.
+ */
+double RELogger::Internal::TickPeriodNanoseconds()
+{
+	return NanosecondsPerTick(true);
+}
+
+/**
+ * @brief Starts the tick calibration span, so later rate queries need not wait.
+ */
+void RELogger::Internal::StartTickCalibration()
+{
+	MarkTickEpoch();
+}
+
+// ============================================================================
+//                               STATS PAGE
+// ============================================================================
+
+/**
+ * @brief Starts writing this process's shared stats page.
+ * @return False if shared memory is unavailable.
+ */
+bool RELogger::Internal::OpenStatsPage()
+{
+	if (!statsMapping.page)
+	{
+		statsMapping.name = StatsPageName(CurrentProcessId());
+		statsMapping.page = static_cast<StatsPage*>(CreateSharedMemory(statsMapping.name, sizeof(StatsPage)));
+		if (!statsMapping.page)
+			return false;
+
+		std::memcpy(statsMapping.page->magic, StatsPageMagic, sizeof(statsMapping.page->magic));
+		statsMapping.page->version = StatsPageVersion;
+		statsMapping.page->size = sizeof(StatsPage);
+	}
+
+	activeStats.store(statsMapping.page, std::memory_order_release);
+	return true;
+}
+
+/**
+ * @brief Stops writing the stats page; it keeps its last totals.
+ */
+void RELogger::Internal::CloseStatsPage()
+{
+	activeStats.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Counts one delivered record.
+ */
+void RELogger::Internal::CountRecord(const LogRecord& record)
+{
+	StatsPage* page = activeStats.load(std::memory_order_acquire);
+	if (page)
+		CountInPage(page, record.level, record.file, record.line, record.category, 1, record.text.size() + 1, 0);
+}
+
+/**
+ * @brief Counts one record refused by a full queue.
+ */
+void RELogger::Internal::CountDrop(LogLevel level, const char* file, int line, const char* category)
+{
+	StatsPage* page = activeStats.load(std::memory_order_acquire);
+	if (page)
+		CountInPage(page, level, file, line, category, 0, 0, 1);
+}
+
+/**
+ * @brief Publishes how full the asynchronous queues are.
+ */
+void RELogger::Internal::SetQueueDepth(std::uint64_t pendingBytes, std::uint64_t capacityBytes)
+{
+	StatsPage* page = activeStats.load(std::memory_order_acquire);
+	if (!page)
+		return;
+
+	std::atomic_ref<std::uint64_t>(page->queueBytes).store(pendingBytes, std::memory_order_relaxed);
+	std::atomic_ref<std::uint64_t>(page->queueCapacity).store(capacityBytes, std::memory_order_relaxed);
+}
+
+// ============================================================================
+//                                  QUERIES
+// ============================================================================
+
+/**
+ * @brief Labels the calling thread's totals.
+ */
+void RELogger::SetThreadLogName(std::string_view name)
+{
+	OverheadCounters* counters = AcquireCounters();
+	if (!counters)
+		return;
+
+	const std::size_t length = std::min(name.size(), ThreadNameSize - 1);
+	for (std::size_t i = 0; i < length; ++i)
+		counters->name[i].store(name[i], std::memory_order_relaxed);
+	counters->name[length].store('\0', std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the calling thread's totals.
+ */
+RELogger::ThreadLogOverhead RELogger::GetThreadLogOverhead()
+{
+	OverheadCounters* counters = AcquireCounters();
+	return counters ? Snapshot(*counters) : ThreadLogOverhead {};
+}
+
+/**
+ * @brief Returns the totals of every thread, live threads first.
+ */
+std::vector<RELogger::ThreadLogOverhead> RELogger::GetLogOverhead()
+{
+	std::vector<ThreadLogOverhead> all;
+	for (OverheadCounters* counters = countersRegistry.load(std::memory_order_acquire); counters; counters = counters->next)
+		all.push_back(Snapshot(*counters));
+
+	std::stable_partition(all.begin(), all.end(), [](const ThreadLogOverhead& overhead) { return overhead.alive; });
+	return all;
+}
@@ -0,0 +1,192 @@
+/*
+===============================================================================
+
+  RELogger - Logging Overhead Accounting (C++ Header)
+  ---------------------------------------------------
+
+  Per-thread totals of the time producers spend inside RELogger::Log and
+  the RELOG_*F macros, for frame-budget tuning. Each thread adds to its
+  own counters (no shared writes); a profiler reads them at frame or
+  second boundaries and shows the difference.
+
+  Time is taken with the CPU timestamp counter where available (x86)
+  and converted with a rate measured against std::chrono::steady_clock
+  on the first query; elsewhere steady_clock is read directly.
+
+  With Config::sharedStatsPage the logger also keeps running totals per
+  level, category and call site in a shared-memory page named after the
+  process id (StatsPageName). Tools/relogtop maps it read-only and
+  turns successive readings into rates. Counters are only ever added to
+  (std::atomic_ref, relaxed); a slot is claimed by a CAS on its key and
+  its names are valid once ready is set (release).
+
+  Author:  Jayansh Devgan
+  Date:    09 October 2025
+  License: Open Source (Royal Entertainment Project Core Utility)
+
+===============================================================================
+*/
+
+#pragma once
+#ifndef RELOGGER_STATS_H
+#define RELOGGER_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RELogger
+{
+    constexpr std::size_t StatsSiteSlots = 1024;    /**< Call sites tracked (power of two). */
+    constexpr std::size_t StatsCategorySlots = 64;  /**< Categories tracked (power of two). */
+    constexpr std::size_t StatsLevelCount = 6;      /**< One counter set per LogLevel. */
+    constexpr std::size_t StatsNameSize = 48;       /**< Bytes of a file or category name, with terminator. */
+    constexpr std::uint32_t StatsPageVersion = 1;
+    inline constexpr char StatsPageMagic[8] = "RELSTPG";
+
+    /*
+    =======================================================================
+      STRUCT: StatsCounters
+      ---------------------------------------------------------------------
+      Totals for one row of the stats page. bytes counts formatted text
+      (one line per record); drops counts records refused by a full
+      queue under QueueFullPolicy::Drop.
+    =======================================================================
+    */
+    struct StatsCounters
+    {
+        std::uint64_t records;
+        std::uint64_t bytes;
+        std::uint64_t drops;
+    };
+
+    /*
+    =======================================================================
+      STRUCT: StatsSite
+    =======================================================================
+    */
+    struct StatsSite
+    {
+        std::uint64_t key;                  /**< Nonzero once claimed (process-local site hash). */
+        std::uint32_t line;
+        std::uint8_t level;                 /**< LogLevel value. */
+        std::uint8_t ready;                 /**< Set once the fields below are written. */
+        std::uint8_t reserved[2];
+        StatsCounters counters;
+        char file[StatsNameSize];           /**< File base name. */
+        char category[StatsNameSize - 8];   /**< Category, or empty. */
+    };
+
+    /*
+    =======================================================================
+      STRUCT: StatsCategory
+    =======================================================================
+    */
+    struct StatsCategory
+    {
+        std::uint64_t key;                  /**< Nonzero once claimed. */
+        std::uint8_t ready;                 /**< Set once name is written. */
+        std::uint8_t reserved[7];
+        StatsCounters counters;
+        char name[StatsNameSize];
+    };
+
+    /*
+    =======================================================================
+      STRUCT: StatsPage
+      ---------------------------------------------------------------------
+      Records whose site or category finds no free slot are still
+      counted per level, and in overflow.
+    =======================================================================
+    */
+    struct StatsPage
+    {
+        char magic[8];                      /**< StatsPageMagic. */
+        std::uint32_t version;              /**< StatsPageVersion. */
+        std::uint32_t size;                 /**< sizeof(StatsPage). */
+        std::uint64_t queueBytes;           /**< Async mode: bytes waiting in every queue (gauge). */
+        std::uint64_t queueCapacity;        /**< Async mode: bytes of every queue together. */
+        StatsCounters overflow;             /**< Records of sites that found no slot. */
+        StatsCounters levels[StatsLevelCount];
+        StatsCategory categories[StatsCategorySlots];
+        StatsSite sites[StatsSiteSlots];
+    };
+
+    static_assert(sizeof(StatsSite) == 128, "StatsSite layout is shared with other processes");
+    static_assert(sizeof(StatsCategory) == 88, "StatsCategory layout is shared with other processes");
+
+    /*
+    =======================================================================
+      FUNCTION: StatsPageName
+      ---------------------------------------------------------------------
+      @return The shared-memory object name of a process's stats page.
+    =======================================================================
+    */
+    inline std::string StatsPageName(std::uint64_t processId)
+    {
+#ifdef _WIN32
+        return "Local\\relogger-stats." + std::to_string(processId);
+#else
+        return "/relogger-stats." + std::to_string(processId);
+#endif
+    }
+
+    /*
+    =======================================================================
+      STRUCT: ThreadLogOverhead
+      ---------------------------------------------------------------------
+      Running totals of one thread. Totals only grow while the thread
+      lives; a profiler subtracts the previous reading of the same
+      threadId to get per-frame figures.
+    =======================================================================
+    */
+    struct ThreadLogOverhead
+    {
+        std::uint64_t threadId = 0;          /**< Hash of std::thread::id. */
+        std::string name;                    /**< Set by SetThreadLogName, or empty. */
+        std::uint64_t calls = 0;             /**< Records submitted (filtered-out calls are not counted). */
+        std::chrono::nanoseconds time { 0 }; /**< Time spent inside the logger. */
+        bool alive = false;                  /**< False once the thread has exited. */
+    };
+
+    /*
+    =======================================================================
+      FUNCTION: SetThreadLogName
+      ---------------------------------------------------------------------
+      Labels the calling thread's totals (e.g. "render"). Names longer
+      than 31 bytes are cut.
+    =======================================================================
+    */
+    void SetThreadLogName(std::string_view name);
+
+    /*
+    =======================================================================
+      FUNCTION: GetThreadLogOverhead
+      ---------------------------------------------------------------------
+      @return The calling thread's totals.
+    =======================================================================
+    */
+    ThreadLogOverhead GetThreadLogOverhead();
+
+    /*
+    =======================================================================
+      FUNCTION: GetLogOverhead
+      ---------------------------------------------------------------------
+      @return The totals of every thread that has logged and is alive,
+              followed by those of exited threads whose slot has not
+              been taken over by a new thread yet.
+    =======================================================================
+    */
+    std::vector<ThreadLogOverhead> GetLogOverhead();
+}
+
+/*
+===============================================================================
+  END OF FILE
+===============================================================================
+*/
+
+#endif /* RELOGGER_STATS_H */
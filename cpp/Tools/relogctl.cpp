@@ -0,0 +1,91 @@
+/**
+ * @file relogctl.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Command-line client for the RELogger control socket.
+ *
+ * Usage:
+ *   relogctl <socket> level [NAME]
+ *   relogctl <socket> stats
+ *   relogctl <socket> capture PATH [LEVEL [CATEGORY]]
+ *   relogctl <socket> uncapture
+ *
+ * The socket is the one named in Config::controlSocketPath. A relative
+ * capture PATH is made absolute here, since the server resolves it in its
+ * own working directory.
+ *
+ * Build (from cpp/):
+ *   g++ -std=c++20 -O2 Tools/relogctl.cpp -o relogctl
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+	int Usage()
+	{
+		std::cerr << "usage: relogctl <socket> level [NAME]\n"
+				  << "       relogctl <socket> stats\n"
+				  << "       relogctl <socket> capture PATH [LEVEL [CATEGORY]]\n"
+				  << "       relogctl <socket> uncapture\n";
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+		return Usage();
+
+	const std::string socketPath = argv[1];
+	std::string command = argv[2];
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string word = argv[i];
+		if (command == "capture" && i == 3)
+			word = std::filesystem::absolute(word).string();
+		command += " " + word;
+	}
+	command += "\n";
+
+	sockaddr_un address {};
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		std::cerr << "relogctl: socket path too long\n";
+		return 1;
+	}
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+	const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		std::cerr << "relogctl: cannot connect to " << socketPath << ": " << std::strerror(errno) << "\n";
+		return 1;
+	}
+
+	if (::send(fd, command.data(), command.size(), 0) != static_cast<ssize_t>(command.size()))
+	{
+		std::cerr << "relogctl: send failed\n";
+		::close(fd);
+		return 1;
+	}
+
+	std::string reply;
+	char buffer[4096];
+	ssize_t received;
+	while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+		reply.append(buffer, static_cast<std::size_t>(received));
+	::close(fd);
+
+	std::cout << reply;
+	return reply.rfind("error:", 0) == 0 ? 1 : 0;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file relogpage.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Changes the levels of a running process through its shared level page.
+ *
+ * Usage:
+ *   relogpage <pid> show
+ *   relogpage <pid> level NAME
+ *   relogpage <pid> category PATTERN NAME|clear
+ *   relogpage <pid> site FILE[:LINE] NAME|clear
+ *   relogpage <pid> clear
+ *
+ * NAME is trace, debug, info, warn, error, fatal or off. The target must
+ * have been initialized with Config::sharedLevelPage; see relogger_levels.h
+ * for the page layout and the write protocol followed here.
+ *
+ * Build (from cpp/):
+ *   g++ -std=c++20 -O2 -IRELogger Tools/relogpage.cpp -o relogpage
+ */
+
+#include "relogger_levels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+	using RELogger::LevelOverride;
+	using RELogger::LevelOverrideKind;
+	using RELogger::LevelPage;
+
+	constexpr const char* LevelNames[] = { "trace", "debug", "info", "warn", "error", "fatal", "off" };
+
+	/**
+	 * @brief Parses a level name into its page value.
+	 */
+	bool ParseLevel(std::string text, std::uint8_t& level)
+	{
+		for (char& c : text)
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+		for (std::uint8_t i = 0; i <= RELogger::LevelOff; ++i)
+		{
+			if (text == LevelNames[i])
+			{
+				level = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	const char* LevelName(std::uint8_t level)
+	{
+		return level <= RELogger::LevelOff ? LevelNames[level] : "?";
+	}
+
+	std::uint8_t LoadByte(std::uint8_t& field)
+	{
+		return std::atomic_ref<std::uint8_t>(field).load(std::memory_order_acquire);
+	}
+
+	void StoreByte(std::uint8_t& field, std::uint8_t value)
+	{
+		std::atomic_ref<std::uint8_t>(field).store(value, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Makes a slot's sequence odd before its fields are rewritten.
+	 */
+	void BeginSlotWrite(LevelOverride& slot)
+	{
+		const std::atomic_ref<std::uint16_t> sequence(slot.sequence);
+		sequence.store(static_cast<std::uint16_t>(sequence.load(std::memory_order_relaxed) + 1), std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	/**
+	 * @brief Makes a slot's sequence even again, publishing the new fields.
+	 */
+	void EndSlotWrite(LevelOverride& slot)
+	{
+		const std::atomic_ref<std::uint16_t> sequence(slot.sequence);
+		sequence.store(static_cast<std::uint16_t>(sequence.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+	}
+
+	void FreeSlot(LevelOverride& slot)
+	{
+		BeginSlotWrite(slot);
+		std::atomic_ref<std::uint8_t>(slot.kind).store(static_cast<std::uint8_t>(LevelOverrideKind::Free), std::memory_order_relaxed);
+		EndSlotWrite(slot);
+	}
+
+	/**
+	 * @brief Recomputes the used-slot count and lowest level after an edit,
+	 *        then moves the generation on so threads drop their cached overrides.
+	 */
+	void UpdateOverrideSummary(LevelPage& page)
+	{
+		std::uint8_t count = 0;
+		std::uint8_t minLevel = RELogger::LevelOff;
+		for (LevelOverride& slot : page.overrides)
+		{
+			if (LoadByte(slot.kind) != static_cast<std::uint8_t>(LevelOverrideKind::Free))
+			{
+				++count;
+				minLevel = std::min(minLevel, LoadByte(slot.level));
+			}
+		}
+		StoreByte(page.minOverrideLevel, minLevel);
+		StoreByte(page.overrideCount, count);
+		std::atomic_ref<std::uint32_t>(page.generation).fetch_add(1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Sets or clears the override for one pattern or site.
+	 * @param clear True to remove the override.
+	 * @return False if every slot is in use.
+	 */
+	bool SetOverride(LevelPage& page, LevelOverrideKind kind, const std::string& name,
+					 std::uint32_t line, std::uint8_t level, bool clear)
+	{
+		LevelOverride* target = nullptr;
+		LevelOverride* freeSlot = nullptr;
+		for (LevelOverride& slot : page.overrides)
+		{
+			const std::uint8_t slotKind = LoadByte(slot.kind);
+			if (slotKind == static_cast<std::uint8_t>(LevelOverrideKind::Free))
+			{
+				if (!freeSlot)
+					freeSlot = &slot;
+			}
+			else if (slotKind == static_cast<std::uint8_t>(kind) && slot.line == line
+				&& std::strncmp(slot.name, name.c_str(), sizeof(slot.name)) == 0)
+			{
+				target = &slot;
+				break;
+			}
+		}
+
+		if (clear)
+		{
+			if (target)
+				FreeSlot(*target);
+			UpdateOverrideSummary(page);
+			return true;
+		}
+
+		if (target)
+		{
+			BeginSlotWrite(*target);
+			std::atomic_ref<std::uint8_t>(target->level).store(level, std::memory_order_relaxed);
+			EndSlotWrite(*target);
+			UpdateOverrideSummary(page);
+			return true;
+		}
+		if (!freeSlot)
+			return false;
+
+		BeginSlotWrite(*freeSlot);
+		std::atomic_ref<std::uint8_t>(freeSlot->level).store(level, std::memory_order_relaxed);
+		std::atomic_ref<std::uint32_t>(freeSlot->line).store(line, std::memory_order_relaxed);
+		for (std::size_t i = 0; i < sizeof(freeSlot->name); ++i)
+		{
+			const char c = i < name.size() && i + 1 < sizeof(freeSlot->name) ? name[i] : '\0';
+			std::atomic_ref<char>(freeSlot->name[i]).store(c, std::memory_order_relaxed);
+		}
+		std::atomic_ref<std::uint8_t>(freeSlot->kind).store(static_cast<std::uint8_t>(kind), std::memory_order_relaxed);
+		EndSlotWrite(*freeSlot);
+		UpdateOverrideSummary(page);
+		return true;
+	}
+
+	void Show(LevelPage& page)
+	{
+		std::cout << "level " << LevelName(LoadByte(page.level)) << "\n";
+		for (LevelOverride& slot : page.overrides)
+		{
+			const std::uint8_t kind = LoadByte(slot.kind);
+			if (kind == static_cast<std::uint8_t>(LevelOverrideKind::Category))
+				std::cout << "category " << slot.name << " " << LevelName(LoadByte(slot.level)) << "\n";
+			else if (kind == static_cast<std::uint8_t>(LevelOverrideKind::Site))
+			{
+				std::cout << "site " << slot.name;
+				if (slot.line != 0)
+					std::cout << ":" << slot.line;
+				std::cout << " " << LevelName(LoadByte(slot.level)) << "\n";
+			}
+		}
+	}
+
+	int Usage()
+	{
+		std::cerr << "usage: relogpage <pid> show\n"
+				  << "       relogpage <pid> level NAME\n"
+				  << "       relogpage <pid> category PATTERN NAME|clear\n"
+				  << "       relogpage <pid> site FILE[:LINE] NAME|clear\n"
+				  << "       relogpage <pid> clear\n"
+				  << "NAME: trace debug info warn error fatal off\n";
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+		return Usage();
+
+	const std::string name = RELogger::LevelPageName(std::strtoull(argv[1], nullptr, 10));
+	const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0)
+	{
+		std::cerr << "relogpage: no level page for process " << argv[1]
+				  << " (was it started with sharedLevelPage?)\n";
+		return 1;
+	}
+	void* view = ::mmap(nullptr, RELogger::LevelPageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED)
+	{
+		std::cerr << "relogpage: cannot map " << name << "\n";
+		return 1;
+	}
+
+	LevelPage& page = *static_cast<LevelPage*>(view);
+	if (std::memcmp(page.magic, RELogger::LevelPageMagic, sizeof(page.magic)) != 0
+		|| page.version != RELogger::LevelPageVersion)
+	{
+		std::cerr << "relogpage: " << name << " is not a level page this tool understands\n";
+		return 1;
+	}
+
+	const std::string command = argv[2];
+	std::uint8_t level = 0;
+	if (command == "show" && argc == 3)
+	{
+		Show(page);
+		return 0;
+	}
+	if (command == "level" && argc == 4 && ParseLevel(argv[3], level))
+	{
+		StoreByte(page.level, level);
+		return 0;
+	}
+	if (command == "clear" && argc == 3)
+	{
+		for (LevelOverride& slot : page.overrides)
+			FreeSlot(slot);
+		UpdateOverrideSummary(page);
+		return 0;
+	}
+	if ((command == "category" || command == "site") && argc == 5)
+	{
+		const bool clear = std::string(argv[4]) == "clear";
+		if (!clear && !ParseLevel(argv[4], level))
+			return Usage();
+
+		std::string target = argv[3];
+		std::uint32_t line = 0;
+		LevelOverrideKind kind = LevelOverrideKind::Category;
+		if (command == "site")
+		{
+			kind = LevelOverrideKind::Site;
+			const std::size_t colon = target.rfind(':');
+			if (colon != std::string::npos)
+			{
+				line = static_cast<std::uint32_t>(std::strtoul(target.c_str() + colon + 1, nullptr, 10));
+				target.resize(colon);
+			}
+		}
+
+		if (target.size() >= RELogger::LevelOverrideNameSize)
+		{
+			std::cerr << "relogpage: name too long\n";
+			return 1;
+		}
+		if (!SetOverride(page, kind, target, line, level, clear))
+		{
+			std::cerr << "relogpage: all " << RELogger::MaxLevelOverrides << " override slots are in use\n";
+			return 1;
+		}
+		return 0;
+	}
+	return Usage();
+}
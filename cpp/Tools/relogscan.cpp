@@ -0,0 +1,694 @@
+/**
+ * @file relogscan.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Build-time scanner that lists the RELOG_*F sites of a code base.
+ *
+ * Usage:
+ *   relogscan --dictionary FILE [--source FILE] [--root DIR] PATH...
+ *
+ * Scans the C++ sources under each PATH for RELOG_*F, RELOG_LOGF,
+ * RELOG_CATEGORY_LOGF and the RELOG_BATCH_*LOGF forms, and writes the
+ * site dictionary described in relogger_dictionary.h. An existing
+ * dictionary keeps its ids: a site keeps its id as long as its file,
+ * level, category and format are unchanged (moving it to another line
+ * is fine), and new sites get ids never used before.
+ *
+ * --source also writes a C++ file that registers the same sites; compile
+ * it into the program so CompressedFileSink refers to them by id:
+ *
+ *   relogscan --dictionary relogger_sites.dict --source relogger_sites.gen.cpp src/
+ *   relogread logs/server.relc --dictionary relogger_sites.dict
+ *
+ * Files are recorded relative to --root (default: the current directory),
+ * which should be where the compiler is run from, or a parent of it, so
+ * that each __FILE__ ends with the recorded path. Sites whose level or
+ * format is not a literal are reported and left out.
+ *
+ * Build (from cpp/):
+ *   g++ -std=c++20 -O2 -IRELogger Tools/relogscan.cpp RELogger/relogger*.cpp -o relogscan
+ */
+
+#include "relogger_dictionary.h"
+#include "relogger_sink.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr const char* SourceExtensions[] = { ".cpp", ".cc", ".cxx", ".c++", ".h", ".hpp", ".hh", ".hxx", ".inl", ".ipp" };
+
+	// ------------------------------------------------------------------------
+	// Lexing
+	// ------------------------------------------------------------------------
+
+	struct Token
+	{
+		enum class Kind { Identifier, String, Punct, Other } kind;
+		std::string text;  ///< Identifier or punctuation; the value of a string literal.
+		int line;
+	};
+
+	/**
+	 * @brief Splits a source file into the tokens the scanner needs. Comments
+	 *        and preprocessor directives are dropped, so the macro definitions
+	 *        in RELogger's own headers are not taken for call sites.
+	 */
+	class Lexer
+	{
+	public:
+		explicit Lexer(std::string source) : text(std::move(source)) {}
+
+		std::vector<Token> Tokens()
+		{
+			std::vector<Token> tokens;
+			bool lineStart = true;
+			while (position < text.size())
+			{
+				const char c = text[position];
+				if (c == '\n')
+				{
+					++line;
+					++position;
+					lineStart = true;
+				}
+				else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v')
+					++position;
+				else if (c == '/' && Peek(1) == '/')
+					SkipLine(false);
+				else if (c == '/' && Peek(1) == '*')
+					SkipBlockComment();
+				else if (c == '#' && lineStart)
+					SkipLine(true);
+				else
+				{
+					lineStart = false;
+					if (IsIdentifierStart(c))
+						LexIdentifier(tokens);
+					else if (c == '"')
+						LexString(tokens, line);
+					else if (c == '\'')
+						LexCharacter(tokens);
+					else if (c >= '0' && c <= '9')
+						LexNumber(tokens);
+					else
+						tokens.push_back(Token { Token::Kind::Punct, std::string(1, text[position++]), line });
+				}
+			}
+			return tokens;
+		}
+
+	private:
+		static bool IsIdentifierStart(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+		}
+
+		static bool IsIdentifierChar(char c)
+		{
+			return IsIdentifierStart(c) || (c >= '0' && c <= '9');
+		}
+
+		char Peek(std::size_t offset) const
+		{
+			return position + offset < text.size() ? text[position + offset] : '\0';
+		}
+
+		void SkipLine(bool continuations)
+		{
+			while (position < text.size() && text[position] != '\n')
+			{
+				if (continuations && text[position] == '/' && Peek(1) == '*')
+				{
+					SkipBlockComment();
+					continue;
+				}
+				if (continuations && text[position] == '\\' && Peek(1) == '\n')
+				{
+					++line;
+					++position;
+				}
+				else if (continuations && text[position] == '\\' && Peek(1) == '\r' && Peek(2) == '\n')
+				{
+					++line;
+					position += 2;
+				}
+				++position;
+			}
+		}
+
+		void SkipBlockComment()
+		{
+			position += 2;
+			while (position < text.size() && !(text[position] == '*' && Peek(1) == '/'))
+			{
+				if (text[position] == '\n')
+					++line;
+				++position;
+			}
+			position += 2;
+		}
+
+		void LexIdentifier(std::vector<Token>& tokens)
+		{
+			const std::size_t start = position;
+			while (position < text.size() && IsIdentifierChar(text[position]))
+				++position;
+			std::string word = text.substr(start, position - start);
+
+			// String literal prefixes: only plain and u8 strings can be formats.
+			if (position < text.size() && text[position] == '"')
+			{
+				if (word == "u8")
+					return LexString(tokens, line);
+				if (word == "R" || word == "u8R" || word == "LR" || word == "uR" || word == "UR")
+					return LexRawString(tokens, word.size() == 1 || word == "u8R");
+				if (word == "L" || word == "u" || word == "U")
+				{
+					LexString(tokens, line);
+					tokens.back().kind = Token::Kind::Other;
+					return;
+				}
+			}
+			tokens.push_back(Token { Token::Kind::Identifier, std::move(word), line });
+		}
+
+		void LexString(std::vector<Token>& tokens, int startLine)
+		{
+			std::string value;
+			++position;
+			while (position < text.size() && text[position] != '"' && text[position] != '\n')
+			{
+				if (text[position] == '\\')
+					value += Escape();
+				else
+					value += text[position++];
+			}
+			++position;
+			tokens.push_back(Token { Token::Kind::String, std::move(value), startLine });
+		}
+
+		void LexRawString(std::vector<Token>& tokens, bool narrow)
+		{
+			const int startLine = line;
+			const std::size_t open = text.find('(', position);
+			if (open == std::string::npos)
+			{
+				position = text.size();
+				return;
+			}
+			const std::string close = ")" + text.substr(position + 1, open - position - 1) + "\"";
+			const std::size_t end = text.find(close, open);
+			const std::size_t stop = end == std::string::npos ? text.size() : end;
+			std::string value = text.substr(open + 1, stop - open - 1);
+			line += static_cast<int>(std::count(value.begin(), value.end(), '\n'));
+			position = end == std::string::npos ? text.size() : end + close.size();
+			tokens.push_back(Token { narrow ? Token::Kind::String : Token::Kind::Other, std::move(value), startLine });
+		}
+
+		void LexCharacter(std::vector<Token>& tokens)
+		{
+			++position;
+			while (position < text.size() && text[position] != '\'' && text[position] != '\n')
+				position += text[position] == '\\' ? 2 : 1;
+			++position;
+			tokens.push_back(Token { Token::Kind::Other, "'", line });
+		}
+
+		void LexNumber(std::vector<Token>& tokens)
+		{
+			// Digits, digit separators, exponents with signs and suffixes.
+			++position;
+			while (position < text.size())
+			{
+				const char c = text[position];
+				const char previous = text[position - 1];
+				if (IsIdentifierChar(c) || c == '.' || (c == '\'' && IsIdentifierChar(Peek(1)))
+					|| ((c == '+' || c == '-') && (previous == 'e' || previous == 'E' || previous == 'p' || previous == 'P')))
+				{
+					++position;
+				}
+				else
+					break;
+			}
+			tokens.push_back(Token { Token::Kind::Other, "0", line });
+		}
+
+		/**
+		 * @brief Decodes one escape sequence of a string literal into UTF-8.
+		 */
+		std::string Escape()
+		{
+			++position;
+			const char c = Peek(0);
+			++position;
+			switch (c)
+			{
+				case 'n':  return "\n";
+				case 't':  return "\t";
+				case 'r':  return "\r";
+				case 'a':  return "\a";
+				case 'b':  return "\b";
+				case 'f':  return "\f";
+				case 'v':  return "\v";
+				case '\n': ++line; return std::string();
+				case 'x':
+				{
+					unsigned long value = 0;
+					for (int digit; (digit = HexDigit(Peek(0))) >= 0; ++position)
+						value = value * 16 + static_cast<unsigned long>(digit);
+					return std::string(1, static_cast<char>(value));
+				}
+				case 'u':
+				case 'U':
+				{
+					unsigned long code = 0;
+					for (int i = 0, digit; i < (c == 'u' ? 4 : 8) && (digit = HexDigit(Peek(0))) >= 0; ++i, ++position)
+						code = code * 16 + static_cast<unsigned long>(digit);
+					return Utf8(code);
+				}
+				default:
+					if (c >= '0' && c <= '7')
+					{
+						unsigned value = static_cast<unsigned>(c - '0');
+						for (int i = 0; i < 2 && Peek(0) >= '0' && Peek(0) <= '7'; ++i)
+							value = value * 8 + static_cast<unsigned>(text[position++] - '0');
+						return std::string(1, static_cast<char>(value));
+					}
+					return std::string(1, c); // \\ \" \' \?
+			}
+		}
+
+		static int HexDigit(char c)
+		{
+			if (c >= '0' && c <= '9')
+				return c - '0';
+			if (c >= 'a' && c <= 'f')
+				return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F')
+				return c - 'A' + 10;
+			return -1;
+		}
+
+		static std::string Utf8(unsigned long code)
+		{
+			std::string out;
+			if (code < 0x80)
+				out += static_cast<char>(code);
+			else if (code < 0x800)
+			{
+				out += static_cast<char>(0xC0 | (code >> 6));
+				out += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else if (code < 0x10000)
+			{
+				out += static_cast<char>(0xE0 | (code >> 12));
+				out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				out += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else
+			{
+				out += static_cast<char>(0xF0 | (code >> 18));
+				out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+				out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				out += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			return out;
+		}
+
+		std::string text;
+		std::size_t position = 0;
+		int line = 1;
+	};
+
+	// ------------------------------------------------------------------------
+	// Site Extraction
+	// ------------------------------------------------------------------------
+
+	/**
+	 * @brief Where a logging macro takes its category, level and format.
+	 */
+	struct MacroShape
+	{
+		const char* name;
+		int category;  ///< Argument index, or -1.
+		int level;     ///< Argument index, or -1 if fixed.
+		int format;
+		LogLevel fixedLevel;
+	};
+
+	constexpr MacroShape Macros[] = {
+		{ "RELOG_TRACEF", -1, -1, 0, LogLevel::Trace },
+		{ "RELOG_DEBUGF", -1, -1, 0, LogLevel::Debug },
+		{ "RELOG_INFOF", -1, -1, 0, LogLevel::Info },
+		{ "RELOG_WARNF", -1, -1, 0, LogLevel::Warn },
+		{ "RELOG_ERRORF", -1, -1, 0, LogLevel::Error },
+		{ "RELOG_FATALF", -1, -1, 0, LogLevel::Fatal },
+		{ "RELOG_LOGF", -1, 0, 1, LogLevel::Info },
+		{ "RELOG_CATEGORY_LOGF", 0, 1, 2, LogLevel::Info },
+		{ "RELOG_BATCH_LOGF", -1, 1, 2, LogLevel::Info },
+		{ "RELOG_BATCH_CATEGORY_LOGF", 1, 2, 3, LogLevel::Info },
+	};
+
+	using Argument = std::vector<Token>;
+
+	/**
+	 * @brief The value of an argument made only of (adjacent) string literals.
+	 */
+	bool LiteralValue(const Argument& argument, std::string& value)
+	{
+		value.clear();
+		for (const Token& token : argument)
+		{
+			if (token.kind != Token::Kind::String)
+				return false;
+			value += token.text;
+		}
+		return !argument.empty();
+	}
+
+	/**
+	 * @brief The level named by an argument such as LogLevel::Warn.
+	 */
+	bool LevelValue(const Argument& argument, LogLevel& level)
+	{
+		static constexpr LogLevel Levels[] = { LogLevel::Trace, LogLevel::Debug, LogLevel::Info,
+			LogLevel::Warn, LogLevel::Error, LogLevel::Fatal };
+		static constexpr const char* Names[] = { "Trace", "Debug", "Info", "Warn", "Error", "Fatal" };
+
+		if (argument.size() < 3 || argument.back().kind != Token::Kind::Identifier
+			|| argument[argument.size() - 2].text != ":" || argument[argument.size() - 3].text != ":")
+		{
+			return false;
+		}
+		for (std::size_t i = 0; i < std::size(Names); ++i)
+		{
+			if (argument.back().text == Names[i])
+			{
+				level = Levels[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Splits the arguments of the call whose '(' is at tokens[open].
+	 * @return Index of the matching ')', or tokens.size() if unbalanced.
+	 */
+	std::size_t SplitArguments(const std::vector<Token>& tokens, std::size_t open, std::vector<Argument>& arguments)
+	{
+		arguments.assign(1, Argument());
+		int depth = 0;
+		for (std::size_t i = open + 1; i < tokens.size(); ++i)
+		{
+			const Token& token = tokens[i];
+			if (token.kind == Token::Kind::Punct)
+			{
+				const char c = token.text[0];
+				if (c == '(' || c == '[' || c == '{')
+					++depth;
+				else if ((c == ')' || c == ']' || c == '}') && depth > 0)
+					--depth;
+				else if (c == ')')
+					return i;
+				else if (c == ',' && depth == 0)
+				{
+					arguments.emplace_back();
+					continue;
+				}
+			}
+			arguments.back().push_back(token);
+		}
+		return tokens.size();
+	}
+
+	/**
+	 * @brief Adds the sites of one source file to entries (ids not yet set).
+	 */
+	void ScanFile(const std::filesystem::path& path, const std::string& name, std::vector<RELogger::DictionaryEntry>& entries)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::ostringstream contents;
+		contents << in.rdbuf();
+
+		const std::vector<Token> tokens = Lexer(contents.str()).Tokens();
+		std::vector<Argument> arguments;
+		for (std::size_t i = 0; i + 1 < tokens.size(); ++i)
+		{
+			if (tokens[i].kind != Token::Kind::Identifier || tokens[i + 1].text != "(")
+				continue;
+
+			const auto shape = std::find_if(std::begin(Macros), std::end(Macros),
+				[&](const MacroShape& macro) { return tokens[i].text == macro.name; });
+			if (shape == std::end(Macros))
+				continue;
+
+			const std::size_t close = SplitArguments(tokens, i + 1, arguments);
+			RELogger::DictionaryEntry entry;
+			entry.file = name;
+			entry.line = tokens[i].line;
+			entry.level = shape->fixedLevel;
+
+			const char* problem = nullptr;
+			if (static_cast<int>(arguments.size()) <= shape->format)
+				problem = "too few arguments";
+			else if (shape->level >= 0 && !LevelValue(arguments[shape->level], entry.level))
+				problem = "level is not a LogLevel constant";
+			else if (shape->category >= 0 && !LiteralValue(arguments[shape->category], entry.category))
+				problem = "category is not a string literal";
+			else if (!LiteralValue(arguments[shape->format], entry.format))
+				problem = "format is not a string literal";
+
+			if (problem)
+				std::cerr << "relogscan: " << name << ":" << entry.line << ": " << shape->name << " not listed, " << problem << "\n";
+			else
+				entries.push_back(std::move(entry));
+			i = std::min(close, tokens.size() - 1);
+		}
+	}
+
+	bool IsSource(const std::filesystem::path& path)
+	{
+		const std::string extension = path.extension().string();
+		return std::find(std::begin(SourceExtensions), std::end(SourceExtensions), extension) != std::end(SourceExtensions);
+	}
+
+	// ------------------------------------------------------------------------
+	// Ids
+	// ------------------------------------------------------------------------
+
+	std::string SiteKey(const RELogger::DictionaryEntry& entry)
+	{
+		std::string key = entry.file;
+		key += '\0';
+		key += RELogger::LevelToString(entry.level);
+		key += '\0';
+		key += entry.category;
+		key += '\0';
+		key += entry.format;
+		return key;
+	}
+
+	/**
+	 * @brief Gives each scanned site the id of the same site in the previous
+	 *        dictionary. Sites sharing a key are paired in line order, so
+	 *        repeated messages in one file keep their ids too.
+	 */
+	void AssignIds(std::vector<RELogger::DictionaryEntry>& entries, const RELogger::SiteDictionary& previous, std::uint32_t& nextId)
+	{
+		std::map<std::string, std::vector<const RELogger::DictionaryEntry*>> known;
+		for (const RELogger::DictionaryEntry& entry : previous.entries)
+			known[SiteKey(entry)].push_back(&entry);
+		for (auto& [key, candidates] : known)
+		{
+			std::stable_sort(candidates.begin(), candidates.end(),
+				[](const RELogger::DictionaryEntry* a, const RELogger::DictionaryEntry* b) { return a->line < b->line; });
+		}
+
+		std::map<std::string, std::size_t> used;
+		for (RELogger::DictionaryEntry& entry : entries)
+		{
+			const std::string key = SiteKey(entry);
+			const auto found = known.find(key);
+			std::size_t& index = used[key];
+			if (found != known.end() && index < found->second.size())
+				entry.id = found->second[index++]->id;
+			else
+				entry.id = nextId++;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	// Generated Source
+	// ------------------------------------------------------------------------
+
+	std::string CppString(const std::string& text)
+	{
+		std::string out = "\"";
+		for (unsigned char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out += '\\';
+				out += static_cast<char>(c);
+			}
+			else if (c >= 0x20 && c < 0x7F && c != '?') // '?' could start a trigraph.
+				out += static_cast<char>(c);
+			else
+			{
+				char escaped[5];
+				std::snprintf(escaped, sizeof(escaped), "\\%03o", c);
+				out += escaped;
+			}
+		}
+		return out + "\"";
+	}
+
+	/**
+	 * @brief Writes the registration source, leaving the file untouched
+	 *        (and its timestamp unchanged) if it already has this content.
+	 */
+	bool WriteSource(const std::string& path, const std::string& dictionaryPath, const RELogger::SiteDictionary& dictionary)
+	{
+		static constexpr const char* LevelNames[] = { "Trace", "Debug", "Info", "Warn", "Error", "Fatal" };
+
+		std::ostringstream out;
+		out << "// Generated by relogscan from " << std::filesystem::path(dictionaryPath).filename().string()
+			<< ". Do not edit; run relogscan again instead.\n\n"
+			<< "#include \"relogger_dictionary.h\"\n\n"
+			<< "namespace\n{\n";
+		if (dictionary.entries.empty())
+		{
+			out << "\tconst RELogger::Internal::DictionaryRegistration Registration({});\n";
+		}
+		else
+		{
+			out << "\tconst RELogger::DictionarySite Sites[] =\n\t{\n";
+			for (const RELogger::DictionaryEntry& entry : dictionary.entries)
+			{
+				out << "\t\t{ " << entry.id << ", LogLevel::" << LevelNames[static_cast<int>(entry.level)] << ", " << entry.line
+					<< ", " << CppString(entry.file) << ", " << CppString(entry.format) << ", "
+					<< (entry.category.empty() ? std::string("nullptr") : CppString(entry.category)) << " },\n";
+			}
+			out << "\t};\n\n"
+				<< "\tconst RELogger::Internal::DictionaryRegistration Registration(Sites);\n";
+		}
+		out << "}\n";
+
+		std::ifstream existing(path, std::ios::binary);
+		std::ostringstream current;
+		current << existing.rdbuf();
+		if (existing && current.str() == out.str())
+			return true;
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		return file && file.write(out.str().data(), static_cast<std::streamsize>(out.str().size())).flush();
+	}
+
+	int Usage()
+	{
+		std::cerr << "usage: relogscan --dictionary FILE [--source FILE] [--root DIR] PATH...\n";
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string dictionaryPath;
+	std::string sourcePath;
+	std::filesystem::path root = std::filesystem::current_path();
+	std::vector<std::filesystem::path> inputs;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (option == "--dictionary" && hasValue)
+			dictionaryPath = argv[++i];
+		else if (option == "--source" && hasValue)
+			sourcePath = argv[++i];
+		else if (option == "--root" && hasValue)
+			root = argv[++i];
+		else if (option.size() > 1 && option[0] == '-')
+			return Usage();
+		else
+			inputs.emplace_back(option);
+	}
+	if (dictionaryPath.empty() || inputs.empty())
+		return Usage();
+
+	std::error_code error;
+	root = std::filesystem::weakly_canonical(root, error);
+
+	// Collect the files first so the dictionary comes out in a fixed order.
+	std::vector<std::filesystem::path> files;
+	for (const std::filesystem::path& input : inputs)
+	{
+		if (std::filesystem::is_directory(input, error))
+		{
+			for (const auto& item : std::filesystem::recursive_directory_iterator(input, error))
+			{
+				if (item.is_regular_file(error) && IsSource(item.path()))
+					files.push_back(item.path());
+			}
+		}
+		else if (std::filesystem::is_regular_file(input, error))
+			files.push_back(input);
+		else
+		{
+			std::cerr << "relogscan: " << input.string() << ": not found\n";
+			return 1;
+		}
+	}
+
+	std::vector<std::pair<std::string, std::filesystem::path>> named;
+	for (const std::filesystem::path& file : files)
+	{
+		const std::filesystem::path absolute = std::filesystem::weakly_canonical(file, error);
+		std::filesystem::path relative = absolute.lexically_relative(root);
+		if (relative.empty() || *relative.begin() == "..")
+			relative = absolute;
+		named.emplace_back(relative.generic_string(), file);
+	}
+	std::sort(named.begin(), named.end());
+	named.erase(std::unique(named.begin(), named.end()), named.end());
+
+	RELogger::SiteDictionary dictionary;
+	for (const auto& [name, file] : named)
+		ScanFile(file, name, dictionary.entries);
+
+	RELogger::SiteDictionary previous;
+	if (std::filesystem::exists(dictionaryPath, error) && !RELogger::ReadSiteDictionary(dictionaryPath, previous))
+	{
+		std::cerr << "relogscan: " << dictionaryPath << ": not a site dictionary\n";
+		return 1;
+	}
+	dictionary.nextId = previous.nextId;
+	AssignIds(dictionary.entries, previous, dictionary.nextId);
+
+	const bool unchanged = !previous.entries.empty() && previous.nextId == dictionary.nextId
+		&& RELogger::DictionaryHash(previous) == RELogger::DictionaryHash(dictionary);
+	if (!unchanged && !RELogger::WriteSiteDictionary(dictionaryPath, dictionary))
+	{
+		std::cerr << "relogscan: cannot write " << dictionaryPath << "\n";
+		return 1;
+	}
+	if (!sourcePath.empty() && !WriteSource(sourcePath, dictionaryPath, dictionary))
+	{
+		std::cerr << "relogscan: cannot write " << sourcePath << "\n";
+		return 1;
+	}
+
+	std::cout << dictionary.entries.size() << " sites in " << named.size() << " files, hash "
+			  << RELogger::DictionaryHash(dictionary) << "\n";
+	return 0;
+}
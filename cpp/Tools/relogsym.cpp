@@ -0,0 +1,465 @@
+/**
+ * @file relogsym.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Offline symbolizer for the stacks captured with Config::stackFrames.
+ *
+ * Usage:
+ *   relogsym [FILE|-] [--debug-dir DIR]... [--addr2line PROGRAM] [--modules]
+ *
+ * Reads a text log (or relogread output on stdin) and prints it with the
+ * frames of every "stack=" field resolved below its line:
+ *
+ *   [12:00:01] ERROR save.cpp:88 (Save) [stack=55d0c31a2f4e,...] - disk full
+ *       #0 0x55d0c31a2f4e Save(Player const&) at /src/save.cpp:88 (server)
+ *       #1 0x7f3e9c029d90 __libc_start_call_main (libc.so.6+0x29d90)
+ *
+ * Addresses are mapped through the "[LOGGER MODULE]" lines the logger
+ * wrote into the same file, then looked up with addr2line. A module's
+ * binary is searched, in order, as DIR/.build-id/xx/yyyy.debug, DIR/NAME.debug
+ * and DIR/NAME in each --debug-dir, then at its original path; a file
+ * whose ELF build ID differs from the logged one is skipped, so a rebuilt
+ * binary never gives wrong lines. For PE/PDB builds pass a PDB-aware tool,
+ * e.g. --addr2line llvm-addr2line.
+ *
+ * Build (from cpp/):
+ *   g++ -std=c++20 -O2 Tools/relogsym.cpp -o relogsym
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace
+{
+	constexpr std::size_t AddressesPerCall = 256; ///< Keeps addr2line command lines short.
+
+	struct Module
+	{
+		std::uint64_t start = 0;
+		std::uint64_t end = 0;
+		std::uint64_t bias = 0;
+		std::string buildId;
+		std::string path;
+	};
+
+	struct Frame
+	{
+		std::uint64_t address = 0;
+		std::string binary;    ///< File to symbolize with, or empty.
+		std::uint64_t offset = 0; ///< Address within the binary.
+		std::string module;    ///< Module name, or empty if unmapped.
+		std::string note;      ///< Why the frame is not symbolized.
+	};
+
+	struct Location
+	{
+		std::string function;
+		std::string source;
+	};
+
+	// ------------------------------------------------------------------------
+	// Parsing
+	// ------------------------------------------------------------------------
+
+	std::string FieldValue(const std::string& line, const std::string& key)
+	{
+		const std::size_t position = line.find(" " + key + "=");
+		if (position == std::string::npos)
+			return std::string();
+		const std::size_t start = position + key.size() + 2;
+		if (key == "path")
+			return line.substr(start); // Last field; may contain spaces.
+		return line.substr(start, line.find(' ', start) - start);
+	}
+
+	bool ParseModule(const std::string& line, Module& module)
+	{
+		if (line.rfind("[LOGGER MODULE]", 0) != 0)
+			return false;
+
+		module.start = std::strtoull(FieldValue(line, "start").c_str(), nullptr, 16);
+		module.end = std::strtoull(FieldValue(line, "end").c_str(), nullptr, 16);
+		module.bias = std::strtoull(FieldValue(line, "bias").c_str(), nullptr, 16);
+		module.buildId = FieldValue(line, "build-id");
+		if (module.buildId == "-")
+			module.buildId.clear();
+		module.path = FieldValue(line, "path");
+		return true;
+	}
+
+	/**
+	 * @brief Extracts the addresses of the stack field in a record's context.
+	 */
+	std::vector<std::uint64_t> ParseStack(const std::string& line)
+	{
+		std::vector<std::uint64_t> addresses;
+		const std::size_t bracket = line.rfind("stack=", line.find(" - "));
+		if (bracket == std::string::npos || bracket == 0 || (line[bracket - 1] != ' ' && line[bracket - 1] != '['))
+			return addresses;
+
+		const char* cursor = line.c_str() + bracket + 6;
+		for (;;)
+		{
+			char* end = nullptr;
+			const std::uint64_t address = std::strtoull(cursor, &end, 16);
+			if (end == cursor)
+				break;
+			addresses.push_back(address);
+			if (*end != ',')
+				break;
+			cursor = end + 1;
+		}
+		return addresses;
+	}
+
+	// ------------------------------------------------------------------------
+	// Binaries
+	// ------------------------------------------------------------------------
+
+	std::uint64_t ReadLittle(const unsigned char* bytes, std::size_t size)
+	{
+		std::uint64_t value = 0;
+		for (std::size_t i = size; i-- > 0;)
+			value = (value << 8) | bytes[i];
+		return value;
+	}
+
+	/**
+	 * @brief Reads the GNU build ID from the note sections of an ELF file.
+	 * @return The ID in hex, or "" if the file is not (little-endian) ELF
+	 *         or has none.
+	 */
+	std::string ReadBuildId(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		unsigned char header[64] {};
+		if (!in.read(reinterpret_cast<char*>(header), sizeof(header))
+			|| std::string(reinterpret_cast<char*>(header), 4) != "\x7f" "ELF" || header[5] != 1)
+		{
+			return std::string();
+		}
+
+		const bool wide = header[4] == 2;
+		const std::uint64_t sectionOffset = wide ? ReadLittle(header + 0x28, 8) : ReadLittle(header + 0x20, 4);
+		const std::uint64_t entrySize = ReadLittle(header + (wide ? 0x3A : 0x2E), 2);
+		const std::uint64_t sectionCount = ReadLittle(header + (wide ? 0x3C : 0x30), 2);
+
+		for (std::uint64_t i = 0; i < sectionCount; ++i)
+		{
+			unsigned char section[64] {};
+			in.seekg(static_cast<std::streamoff>(sectionOffset + i * entrySize));
+			if (!in.read(reinterpret_cast<char*>(section), static_cast<std::streamsize>(std::min<std::uint64_t>(entrySize, 64))))
+				return std::string();
+			if (ReadLittle(section + 4, 4) != 7) // SHT_NOTE
+				continue;
+
+			const std::uint64_t offset = wide ? ReadLittle(section + 0x18, 8) : ReadLittle(section + 0x10, 4);
+			const std::uint64_t size = wide ? ReadLittle(section + 0x20, 8) : ReadLittle(section + 0x14, 4);
+			std::uint64_t alignment = wide ? ReadLittle(section + 0x30, 8) : ReadLittle(section + 0x20, 4);
+			alignment = alignment == 8 ? 8 : 4;
+			const auto align = [alignment](std::uint64_t value) { return (value + alignment - 1) & ~(alignment - 1); };
+
+			std::string notes(static_cast<std::size_t>(size), '\0');
+			in.seekg(static_cast<std::streamoff>(offset));
+			if (!in.read(notes.data(), static_cast<std::streamsize>(size)))
+				continue;
+
+			const unsigned char* cursor = reinterpret_cast<const unsigned char*>(notes.data());
+			std::uint64_t left = size;
+			while (left >= 12)
+			{
+				const std::uint64_t nameSize = ReadLittle(cursor, 4);
+				const std::uint64_t descSize = ReadLittle(cursor + 4, 4);
+				const std::uint64_t type = ReadLittle(cursor + 8, 4);
+				const std::uint64_t length = 12 + align(nameSize) + align(descSize);
+				if (length > left)
+					break;
+				if (type == 3 && nameSize == 4 && std::string(reinterpret_cast<const char*>(cursor + 12), 4) == std::string("GNU", 4))
+				{
+					static constexpr char Digits[] = "0123456789abcdef";
+					std::string buildId;
+					const unsigned char* id = cursor + 12 + align(nameSize);
+					for (std::uint64_t b = 0; b < descSize; ++b)
+					{
+						buildId += Digits[id[b] >> 4];
+						buildId += Digits[id[b] & 0x0F];
+					}
+					return buildId;
+				}
+				cursor += length;
+				left -= length;
+			}
+		}
+		return std::string();
+	}
+
+	/**
+	 * @brief Finds a file with the module's code and debug info.
+	 * @param note Set to why nothing was found.
+	 * @return The file, or "" if none matches the logged build ID.
+	 */
+	std::string FindBinary(const Module& module, const std::vector<std::string>& debugDirs, std::string& note)
+	{
+		namespace fs = std::filesystem;
+
+		std::vector<fs::path> candidates;
+		const std::string name = fs::path(module.path).filename().string();
+		for (const std::string& dir : debugDirs)
+		{
+			if (module.buildId.size() > 2)
+				candidates.push_back(fs::path(dir) / ".build-id" / module.buildId.substr(0, 2) / (module.buildId.substr(2) + ".debug"));
+			if (!name.empty())
+			{
+				candidates.push_back(fs::path(dir) / (name + ".debug"));
+				candidates.push_back(fs::path(dir) / name);
+			}
+		}
+		if (!module.path.empty())
+			candidates.push_back(module.path);
+
+		note = "binary not found";
+		for (const fs::path& candidate : candidates)
+		{
+			std::error_code error;
+			if (!fs::is_regular_file(candidate, error))
+				continue;
+
+			const std::string buildId = ReadBuildId(candidate.string());
+			if (module.buildId.empty() || buildId.empty() || buildId == module.buildId)
+				return candidate.string();
+			note = "build-id mismatch";
+		}
+		return std::string();
+	}
+
+	// ------------------------------------------------------------------------
+	// addr2line
+	// ------------------------------------------------------------------------
+
+	std::string Quote(const std::string& text)
+	{
+#ifdef _WIN32
+		return "\"" + text + "\"";
+#else
+		std::string quoted = "'";
+		for (char c : text)
+			quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+		return quoted + "'";
+#endif
+	}
+
+	std::string Hex(std::uint64_t value)
+	{
+		std::ostringstream out;
+		out << "0x" << std::hex << value;
+		return out.str();
+	}
+
+	/**
+	 * @brief Resolves offsets in one binary, AddressesPerCall at a time.
+	 */
+	void Symbolize(const std::string& addr2line, const std::string& binary,
+				   const std::vector<std::uint64_t>& offsets, std::map<std::uint64_t, Location>& locations)
+	{
+		for (std::size_t first = 0; first < offsets.size(); first += AddressesPerCall)
+		{
+			const std::size_t last = std::min(offsets.size(), first + AddressesPerCall);
+			std::string command = Quote(addr2line) + " -C -f -e " + Quote(binary);
+			for (std::size_t i = first; i < last; ++i)
+				command += " " + Hex(offsets[i]);
+
+			FILE* pipe = ::popen(command.c_str(), "r");
+			if (!pipe)
+				return;
+
+			std::string output;
+			char buffer[4096];
+			for (std::size_t read; (read = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0;)
+				output.append(buffer, read);
+			::pclose(pipe);
+
+			std::istringstream lines(output);
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Location location;
+				if (!std::getline(lines, location.function) || !std::getline(lines, location.source))
+					break;
+				if (location.function != "??")
+					locations[offsets[i]] = location;
+			}
+		}
+	}
+
+	int Usage()
+	{
+		std::cerr << "usage: relogsym [FILE|-] [--debug-dir DIR]... [--addr2line PROGRAM] [--modules]\n";
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string path = "-";
+	std::vector<std::string> debugDirs;
+	std::string addr2line = "addr2line";
+	bool keepModules = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (option == "--debug-dir" && hasValue)
+			debugDirs.push_back(argv[++i]);
+		else if (option == "--addr2line" && hasValue)
+			addr2line = argv[++i];
+		else if (option == "--modules")
+			keepModules = true;
+		else if (option.size() > 1 && option[0] == '-' && option != "-")
+			return Usage();
+		else
+			path = option;
+	}
+
+	std::ifstream file;
+	if (path != "-")
+	{
+		file.open(path);
+		if (!file)
+		{
+			std::cerr << "relogsym: cannot open " << path << "\n";
+			return 1;
+		}
+	}
+	std::istream& in = path == "-" ? std::cin : file;
+
+	// First pass: map every captured address to a binary and offset. A
+	// module line after other lines starts a new map (libraries changed).
+	std::vector<std::string> lines;
+	std::map<std::size_t, std::vector<Frame>> stacks;
+	std::vector<Module> modules;
+	std::map<std::string, std::string> binaries; // Module path + build ID -> file (or "!note").
+	std::map<std::string, std::vector<std::uint64_t>> offsets;
+	bool inModuleMap = false;
+
+	for (std::string line; std::getline(in, line);)
+	{
+		Module module;
+		if (ParseModule(line, module))
+		{
+			if (!inModuleMap)
+				modules.clear();
+			modules.push_back(module);
+			inModuleMap = true;
+			if (keepModules)
+				lines.push_back(line);
+			continue;
+		}
+		inModuleMap = false;
+		lines.push_back(line);
+
+		const std::vector<std::uint64_t> addresses = ParseStack(line);
+		if (addresses.empty())
+			continue;
+
+		std::vector<Frame>& frames = stacks[lines.size() - 1];
+		for (std::uint64_t address : addresses)
+		{
+			Frame frame;
+			frame.address = address;
+			frame.note = "no module";
+			for (const Module& candidate : modules)
+			{
+				if (address < candidate.start || address >= candidate.end)
+					continue;
+
+				const std::string key = candidate.path + "\n" + candidate.buildId;
+				auto found = binaries.find(key);
+				if (found == binaries.end())
+				{
+					std::string note;
+					std::string binary = FindBinary(candidate, debugDirs, note);
+					found = binaries.emplace(key, binary.empty() ? "!" + note : binary).first;
+				}
+
+				frame.module = std::filesystem::path(candidate.path).filename().string();
+				// A return address points after the call; -1 lands on it.
+				frame.offset = address - candidate.bias - 1;
+				if (found->second[0] == '!')
+					frame.note = found->second.substr(1);
+				else
+				{
+					frame.binary = found->second;
+					frame.note.clear();
+					offsets[frame.binary].push_back(frame.offset);
+				}
+				break;
+			}
+			frames.push_back(frame);
+		}
+	}
+
+	std::map<std::string, std::map<std::uint64_t, Location>> locations;
+	for (auto& [binary, list] : offsets)
+	{
+		std::sort(list.begin(), list.end());
+		list.erase(std::unique(list.begin(), list.end()), list.end());
+		Symbolize(addr2line, binary, list, locations[binary]);
+	}
+
+	for (std::size_t i = 0; i < lines.size(); ++i)
+	{
+		std::cout << lines[i] << "\n";
+		const auto stack = stacks.find(i);
+		if (stack == stacks.end())
+			continue;
+
+		for (std::size_t f = 0; f < stack->second.size(); ++f)
+		{
+			const Frame& frame = stack->second[f];
+			std::cout << "    #" << f << " " << Hex(frame.address);
+
+			const Location* location = nullptr;
+			if (!frame.binary.empty())
+			{
+				const auto& resolved = locations[frame.binary];
+				const auto found = resolved.find(frame.offset);
+				if (found != resolved.end())
+					location = &found->second;
+			}
+
+			if (location)
+			{
+				std::cout << " " << location->function;
+				if (location->source.rfind("??", 0) != 0)
+					std::cout << " at " << location->source;
+				std::cout << " (" << frame.module << ")";
+			}
+			else if (!frame.module.empty())
+			{
+				std::cout << " (" << frame.module << "+" << Hex(frame.offset + 1) << ")";
+				if (!frame.note.empty())
+					std::cout << " [" << frame.note << "]";
+			}
+			else
+			{
+				std::cout << " [" << frame.note << "]";
+			}
+			std::cout << "\n";
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file relogtop.cpp
+ * @author Jayansh Devgan
+ * @date 09 October 2025
+ * @brief Live per-site log rates of running processes.
+ *
+ * Usage:
+ *   relogtop <pid> [<pid> ...] [--interval SECONDS] [--top N] [--iterations N]
+ *
+ * Maps the shared stats page of each process (Config::sharedStatsPage, see
+ * relogger_stats.h) read-only and prints records/s, KB/s and drops/s per
+ * level, category and call site, busiest first, refreshing every interval.
+ * Iterations 0 (the default) runs until interrupted.
+ *
+ * Build (from cpp/):
+ *   g++ -std=c++20 -O2 -IRELogger Tools/relogtop.cpp -o relogtop
+ */
+
+#include "relogger_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+	using RELogger::StatsCounters;
+	using RELogger::StatsPage;
+
+	constexpr const char* LevelNames[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+
+	std::uint64_t Load(const std::uint64_t& field)
+	{
+		return std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t&>(field)).load(std::memory_order_relaxed);
+	}
+
+	bool IsReady(const std::uint8_t& ready)
+	{
+		return std::atomic_ref<std::uint8_t>(const_cast<std::uint8_t&>(ready)).load(std::memory_order_acquire) != 0;
+	}
+
+	StatsCounters LoadCounters(const StatsCounters& counters)
+	{
+		return { Load(counters.records), Load(counters.bytes), Load(counters.drops) };
+	}
+
+	/**
+	 * @brief One line of output: a rate computed from two readings.
+	 */
+	struct Row
+	{
+		std::string label;
+		std::string detail;
+		double records;
+		double kilobytes;
+		double drops;
+		std::uint64_t total;
+	};
+
+	Row MakeRow(std::string label, std::string detail, const StatsCounters& now,
+				const StatsCounters& before, double seconds)
+	{
+		return { std::move(label), std::move(detail),
+			static_cast<double>(now.records - before.records) / seconds,
+			static_cast<double>(now.bytes - before.bytes) / 1024.0 / seconds,
+			static_cast<double>(now.drops - before.drops) / seconds,
+			now.records };
+	}
+
+	/**
+	 * @brief A mapped stats page and the totals of the previous refresh.
+	 */
+	struct Target
+	{
+		std::string pid;
+		const StatsPage* page = nullptr;
+		StatsCounters levels[RELogger::StatsLevelCount] {};
+		StatsCounters categories[RELogger::StatsCategorySlots] {};
+		StatsCounters sites[RELogger::StatsSiteSlots] {};
+		StatsCounters overflow {};
+	};
+
+	bool MapTarget(Target& target)
+	{
+		const std::string name = RELogger::StatsPageName(std::strtoull(target.pid.c_str(), nullptr, 10));
+		const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+		{
+			std::cerr << "relogtop: no stats page for process " << target.pid
+					  << " (was it started with sharedStatsPage?)\n";
+			return false;
+		}
+		void* view = ::mmap(nullptr, sizeof(StatsPage), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (view == MAP_FAILED)
+			return false;
+
+		target.page = static_cast<const StatsPage*>(view);
+		if (std::memcmp(target.page->magic, RELogger::StatsPageMagic, sizeof(target.page->magic)) != 0
+			|| target.page->version != RELogger::StatsPageVersion)
+		{
+			std::cerr << "relogtop: " << name << " is not a stats page this tool understands\n";
+			return false;
+		}
+		return true;
+	}
+
+	void PrintRows(std::vector<Row>& rows, std::size_t limit, const char* heading)
+	{
+		std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b)
+		{
+			return a.records != b.records ? a.records > b.records : a.drops > b.drops;
+		});
+
+		std::printf("\n%10s %10s %8s %12s  %s\n", "REC/S", "KB/S", "DROP/S", "TOTAL", heading);
+		for (std::size_t i = 0; i < rows.size() && i < limit; ++i)
+		{
+			const Row& row = rows[i];
+			std::printf("%10.1f %10.1f %8.1f %12llu  %s%s\n", row.records, row.kilobytes, row.drops,
+				static_cast<unsigned long long>(row.total), row.label.c_str(), row.detail.c_str());
+		}
+	}
+
+	/**
+	 * @brief Prints one process's rates since the previous refresh.
+	 */
+	void Refresh(Target& target, double seconds, std::size_t limit, bool print)
+	{
+		const StatsPage& page = *target.page;
+		std::vector<Row> levelRows, categoryRows, siteRows;
+		StatsCounters total {}, totalBefore {};
+
+		for (std::size_t i = 0; i < RELogger::StatsLevelCount; ++i)
+		{
+			const StatsCounters now = LoadCounters(page.levels[i]);
+			levelRows.push_back(MakeRow(LevelNames[i], "", now, target.levels[i], seconds));
+			total.records += now.records;
+			total.bytes += now.bytes;
+			total.drops += now.drops;
+			totalBefore.records += target.levels[i].records;
+			totalBefore.bytes += target.levels[i].bytes;
+			totalBefore.drops += target.levels[i].drops;
+			target.levels[i] = now;
+		}
+
+		for (std::size_t i = 0; i < RELogger::StatsCategorySlots; ++i)
+		{
+			if (!IsReady(page.categories[i].ready))
+				continue;
+			const StatsCounters now = LoadCounters(page.categories[i].counters);
+			categoryRows.push_back(MakeRow(page.categories[i].name, "", now, target.categories[i], seconds));
+			target.categories[i] = now;
+		}
+
+		for (std::size_t i = 0; i < RELogger::StatsSiteSlots; ++i)
+		{
+			const RELogger::StatsSite& site = page.sites[i];
+			if (!IsReady(site.ready))
+				continue;
+			const StatsCounters now = LoadCounters(site.counters);
+			std::string label = site.file[0] != '\0'
+				? std::string(site.file) + ":" + std::to_string(site.line)
+				: std::string("(logger notices)");
+			std::string detail = std::string("  ") + (site.level < RELogger::StatsLevelCount ? LevelNames[site.level] : "?");
+			if (site.category[0] != '\0')
+				detail += std::string(" [") + site.category + "]";
+			siteRows.push_back(MakeRow(std::move(label), std::move(detail), now, target.sites[i], seconds));
+			target.sites[i] = now;
+		}
+
+		const StatsCounters overflow = LoadCounters(page.overflow);
+		if (overflow.records != 0 || overflow.drops != 0)
+			siteRows.push_back(MakeRow("(untracked sites)", "", overflow, target.overflow, seconds));
+		target.overflow = overflow;
+
+		if (!print)
+			return;
+
+		const Row all = MakeRow("", "", total, totalBefore, seconds);
+		std::printf("pid %s   %.1f rec/s   %.1f KB/s   %.1f drops/s   queue %.1f / %.1f KB\n",
+			target.pid.c_str(), all.records, all.kilobytes, all.drops,
+			static_cast<double>(Load(page.queueBytes)) / 1024.0,
+			static_cast<double>(Load(page.queueCapacity)) / 1024.0);
+
+		std::vector<Row> activeLevels;
+		for (const Row& row : levelRows)
+		{
+			if (row.total != 0)
+				activeLevels.push_back(row);
+		}
+		PrintRows(activeLevels, RELogger::StatsLevelCount, "LEVEL");
+		if (!categoryRows.empty())
+			PrintRows(categoryRows, limit, "CATEGORY");
+		PrintRows(siteRows, limit, "SITE");
+		std::printf("\n");
+	}
+
+	int Usage()
+	{
+		std::cerr << "usage: relogtop <pid> [<pid> ...] [--interval SECONDS] [--top N] [--iterations N]\n";
+		return 2;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<Target> targets;
+	double interval = 1.0;
+	std::size_t limit = 20;
+	long iterations = 0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (option == "--interval" && hasValue)
+			interval = std::atof(argv[++i]);
+		else if (option == "--top" && hasValue)
+			limit = static_cast<std::size_t>(std::atol(argv[++i]));
+		else if (option == "--iterations" && hasValue)
+			iterations = std::atol(argv[++i]);
+		else if (!option.empty() && option[0] != '-')
+			targets.push_back(Target { option });
+		else
+			return Usage();
+	}
+	if (targets.empty() || interval <= 0.0)
+		return Usage();
+
+	for (Target& target : targets)
+	{
+		if (!MapTarget(target))
+			return 1;
+		Refresh(target, 1.0, limit, false);
+	}
+
+	const bool terminal = ::isatty(STDOUT_FILENO) != 0;
+	std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+	for (long iteration = 0; iterations == 0 || iteration < iterations; ++iteration)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const double seconds = std::chrono::duration<double>(now - last).count();
+		last = now;
+
+		if (terminal)
+			std::printf("\033[H\033[2J");
+		for (Target& target : targets)
+			Refresh(target, seconds, limit, true);
+		std::fflush(stdout);
+	}
+	return 0;
+}